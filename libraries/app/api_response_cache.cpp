@@ -0,0 +1,169 @@
+#include <scorum/app/api_response_cache.hpp>
+
+#include <fc/io/json.hpp>
+
+#include <set>
+
+namespace scorum {
+namespace app {
+
+namespace {
+// the same for all clients within one block
+const std::set<std::pair<std::string, std::string>> per_block_methods
+    = { { "database_api", "get_config" },
+        { "database_api", "get_chain_id" },
+        { "database_api", "get_dynamic_global_properties" },
+        { "database_api", "get_witness_schedule" },
+        { "database_api", "get_active_witnesses" },
+        { "database_api", "get_witnesses_by_vote" },
+        { "database_api", "get_witness_count" },
+        { "database_api", "get_account_count" },
+        { "chain_api", "get_chain_properties" },
+        { "chain_api", "get_next_scheduled_hardfork" },
+        { "chain_api", "get_reward_fund" },
+        { "chain_api", "get_chain_capital" },
+        { "betting_api", "get_games_by_status" },
+        { "betting_api", "get_betting_properties" },
+        { "tags_api", "get_trending_tags" },
+        { "tags_api", "get_discussions_by_trending" },
+        { "tags_api", "get_discussions_by_created" },
+        { "tags_api", "get_discussions_by_hot" } };
+
+// the first argument is the (last) block number, results about irreversible blocks never change
+const std::set<std::pair<std::string, std::string>> block_methods
+    = { { "blockchain_history_api", "get_ops_in_block" },
+        { "blockchain_history_api", "get_block_header" },
+        { "blockchain_history_api", "get_block_headers_history" },
+        { "blockchain_history_api", "get_block" },
+        { "blockchain_history_api", "get_blocks_history" },
+        { "blockchain_history_api", "get_blocks" } };
+
+// the result has the number of the block with the transaction
+const std::pair<std::string, std::string> get_transaction_method = { "blockchain_history_api", "get_transaction" };
+}
+
+api_response_cache::api_response_cache(size_t max_size)
+    : _max_size(max_size)
+{
+}
+
+bool api_response_cache::is_cacheable(const std::string& api, const std::string& method)
+{
+    const auto api_method = std::make_pair(api, method);
+
+    return per_block_methods.count(api_method) || block_methods.count(api_method)
+        || api_method == get_transaction_method;
+}
+
+std::string api_response_cache::make_key(const std::string& api, const std::string& method, const fc::variant& args)
+{
+    return api + "." + method + fc::json::to_string(args);
+}
+
+api_result_lifetime api_response_cache::get_lifetime(const std::string& api,
+                                                     const std::string& method,
+                                                     const fc::variants& args,
+                                                     const fc::variant& result) const
+{
+    const auto api_method = std::make_pair(api, method);
+
+    try
+    {
+        uint32_t block_num = 0;
+
+        if (block_methods.count(api_method) && !args.empty())
+            block_num = args[0].as<uint32_t>();
+        else if (api_method == get_transaction_method && result.is_object())
+            block_num = result["block_num"].as<uint32_t>();
+        else
+            return api_result_lifetime::block;
+
+        return block_num > 0 && block_num <= _last_irreversible_block_num ? api_result_lifetime::irreversible
+                                                                            : api_result_lifetime::block;
+    }
+    catch (const fc::exception&)
+    {
+        return api_result_lifetime::block;
+    }
+}
+
+boost::optional<std::string> api_response_cache::find(const std::string& key)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto it = _index.find(key);
+    if (it == _index.end())
+        return {};
+
+    _entries.splice(_entries.begin(), _entries, it->second);
+
+    return it->second->result;
+}
+
+void api_response_cache::insert(const std::string& key,
+                                const std::string& result,
+                                api_result_lifetime lifetime,
+                                uint64_t generation)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (generation != _generation)
+        return;
+
+    auto it = _index.find(key);
+    if (it != _index.end())
+        erase(it->second);
+
+    entry e{ key, result, lifetime };
+    if (e.size() > _max_size)
+        return;
+
+    while (_size + e.size() > _max_size)
+        erase(std::prev(_entries.end()));
+
+    if (lifetime == api_result_lifetime::block)
+        _block_result_keys.push_back(key);
+
+    _size += e.size();
+    _entries.push_front(std::move(e));
+    _index.emplace(key, _entries.begin());
+}
+
+void api_response_cache::on_applied_block(uint32_t last_irreversible_block_num)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _last_irreversible_block_num = last_irreversible_block_num;
+    drop_block_results();
+}
+
+size_t api_response_cache::size() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    return _size;
+}
+
+void api_response_cache::erase(entries_type::iterator it)
+{
+    _size -= it->size();
+    _index.erase(it->key);
+    _entries.erase(it);
+}
+
+void api_response_cache::drop_block_results()
+{
+    ++_generation;
+
+    // the key may be evicted or cached again as an irreversible result since it was inserted
+    for (const std::string& key : _block_result_keys)
+    {
+        auto it = _index.find(key);
+        if (it != _index.end() && it->second->lifetime == api_result_lifetime::block)
+            erase(it->second);
+    }
+
+    _block_result_keys.clear();
+}
+}
+}
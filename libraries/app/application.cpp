@@ -29,6 +29,10 @@
 #include <scorum/app/api_access.hpp>
 #include <scorum/app/application.hpp>
 #include <scorum/app/plugin.hpp>
+#include <scorum/app/api_response_cache.hpp>
+#include <scorum/app/block_ids.hpp>
+#include <scorum/app/rpc_api_connection.hpp>
+#include <scorum/app/rpc_worker_pool.hpp>
 #include <scorum/account_statistics/account_statistics_api.hpp>
 #include <scorum/account_statistics/account_statistics_plugin.hpp>
 #include <scorum/blockchain_history/account_history_api.hpp>
@@ -40,6 +44,7 @@
 #include <scorum/chain/schema/scorum_objects.hpp>
 #include <scorum/chain/schema/scorum_object_types.hpp>
 #include <scorum/chain/database_exceptions.hpp>
+#include <scorum/chain/database/debug_trace.hpp>
 #include <scorum/chain/genesis/genesis_state.hpp>
 #include <scorum/egenesis/egenesis.hpp>
 
@@ -105,6 +110,20 @@ namespace detail {
 using plugins_type = std::map<std::string, std::shared_ptr<abstract_plugin>>;
 using plugin_names_type = std::set<std::string>;
 
+/// block_message is packed as the signed_block followed by its id, so a packed block is framed without unpacking
+message make_block_message(std::vector<char>&& packed_block, const block_id_type& id)
+{
+    message msg;
+    msg.msg_type = block_message::type;
+    msg.data = std::move(packed_block);
+
+    const auto packed_id = fc::raw::pack(id);
+    msg.data.insert(msg.data.end(), packed_id.begin(), packed_id.end());
+    msg.size = (uint32_t)msg.data.size();
+
+    return msg;
+}
+
 class application_impl : public graphene::net::node_delegate
 {
 public:
@@ -262,7 +281,17 @@ public:
     void on_connection(const fc::http::websocket_connection_ptr& c)
     {
         std::shared_ptr<api_session_data> session = std::make_shared<api_session_data>();
-        session->wsc = std::make_shared<fc::rpc::websocket_api_connection>(*c);
+        std::shared_ptr<rpc_api_connection> rpc_wsc;
+        if (_rpc_workers || _response_cache)
+        {
+            rpc_wsc = std::make_shared<rpc_api_connection>(c, _rpc_workers.get(), _rpc_worker_apis,
+                                                           _response_cache.get());
+            session->wsc = rpc_wsc;
+        }
+        else
+        {
+            session->wsc = std::make_shared<fc::rpc::websocket_api_connection>(*c);
+        }
 
         for (const std::string& name : _public_apis)
         {
@@ -274,7 +303,9 @@ public:
                 continue;
             }
             session->api_map[name] = api;
-            api->register_api(*session->wsc);
+            auto api_id = api->register_api(*session->wsc);
+            if (rpc_wsc)
+                rpc_wsc->register_api_name(api_id, name);
         }
         c->set_session_data(session);
     }
@@ -361,6 +392,16 @@ public:
 
             fc::path block_log_dir = _data_dir / default_data_subdir;
 
+            debug_trace::enable_logger(fc::logger::get("debug").is_enabled(fc::log_level::debug));
+
+            const uint32_t debug_trace_size = _options->at("debug-trace-size").as<uint32_t>();
+            if (debug_trace_size > 0)
+            {
+                const fc::path debug_trace_file = block_log_dir / "debug_trace";
+                debug_trace::open(debug_trace_file, debug_trace_size);
+                ilog("Writing last ${n} debug records to ${f}", ("n", debug_trace_size)("f", debug_trace_file));
+            }
+
             if (!_self->is_read_only())
             {
                 ilog("Starting Scorum node in write mode.");
@@ -372,6 +413,15 @@ public:
                 }
 
                 _chain_db->set_flush_interval(_options->at("flush").as<uint32_t>());
+                _chain_db->set_block_log_prune_blocks(_options->at("block-log-prune-blocks").as<uint32_t>());
+                _chain_db->set_pending_transactions_limits(
+                    _options->at("pending-transactions-max-count").as<uint32_t>(),
+                    _options->at("pending-transactions-max-size").as<uint64_t>());
+                _chain_db->set_pending_revalidation_batch(
+                    _options->at("pending-transactions-revalidation-batch").as<uint32_t>());
+                // both the blocks from the network and the ones produced by the witness plugin leave pending
+                // transactions for revalidation
+                _chain_db->applied_block.connect([this](const signed_block&) { schedule_pending_revalidation(); });
                 _chain_db->set_validate_invariants_on_apply_block(_options->count("validate_invariants_on_apply_block"));
 
                 flat_map<uint32_t, block_id_type> loaded_checkpoints;
@@ -477,6 +527,41 @@ public:
                 reset_p2p_node(_data_dir);
             }
 
+            const uint32_t rpc_worker_threads = _options->at("rpc-worker-threads").as<uint32_t>();
+            if (rpc_worker_threads > 0)
+            {
+                for (const std::string& arg : _options->at("rpc-worker-api").as<std::vector<std::string>>())
+                {
+                    std::vector<std::string> names;
+                    boost::split(names, arg, boost::is_any_of(" \t,"));
+                    _rpc_worker_apis.insert(names.begin(), names.end());
+                }
+
+                const uint32_t rpc_worker_max_readers = _options->at("rpc-worker-max-readers").as<uint32_t>();
+
+                _rpc_workers.reset(new rpc_worker_pool(rpc_worker_threads, rpc_worker_max_readers));
+                ilog("RPC calls of ${apis} are run by ${n} worker threads, ${r} at once",
+                     ("apis", _rpc_worker_apis)("n", rpc_worker_threads)("r", rpc_worker_max_readers));
+            }
+
+            const uint64_t response_cache_size = _options->at("api-response-cache-size").as<uint64_t>();
+            if (response_cache_size > 0)
+            {
+                if (_self->is_read_only())
+                {
+                    // no blocks are applied to invalidate the results
+                    wlog("API response cache is not used in read-only mode");
+                }
+                else
+                {
+                    _response_cache.reset(new api_response_cache(response_cache_size * 1024 * 1024));
+                    _chain_db->applied_block.connect([this](const signed_block&) {
+                        _response_cache->on_applied_block(_chain_db->last_non_undoable_block_num());
+                    });
+                    ilog("API response cache size is ${n} MiB", ("n", response_cache_size));
+                }
+            }
+
             reset_websocket_server();
             reset_websocket_tls_server();
         }
@@ -635,6 +720,20 @@ public:
         FC_CAPTURE_AND_RETHROW((blk_msg)(sync_mode))
     }
 
+    /// revalidates the pending transactions left by push_block in batches, blocks are handled in between, it's run
+    /// after the current task as applied_block is emitted before push_block restores the pending transactions
+    void schedule_pending_revalidation()
+    {
+        if (_pending_revalidation.valid() && !_pending_revalidation.ready())
+            return;
+
+        _pending_revalidation = fc::async([this]() {
+            const auto batch = _chain_db->pending_revalidation_batch();
+            while (_running && _chain_db->revalidate_pending_transactions(batch))
+                fc::yield();
+        });
+    }
+
     virtual void handle_transaction(const graphene::net::trx_message& transaction_message) override
     {
         try
@@ -677,62 +776,8 @@ public:
     {
         try
         {
-            return _chain_db->with_read_lock([&]() {
-                std::vector<block_id_type> result;
-                remaining_item_count = 0;
-                if (_chain_db->head_block_num() == 0)
-                {
-                    return result;
-                }
-
-                result.reserve(limit);
-                block_id_type last_known_block_id;
-
-                if (blockchain_synopsis.empty()
-                    || (blockchain_synopsis.size() == 1 && blockchain_synopsis[0] == block_id_type()))
-                {
-                    // peer has sent us an empty synopsis meaning they have no blocks.
-                    // A bug in old versions would cause them to send a synopsis containing block 000000000
-                    // when they had an empty blockchain, so pretend they sent the right thing here.
-                    // do nothing, leave last_known_block_id set to zero
-                }
-                else
-                {
-                    bool found_a_block_in_synopsis = false;
-
-                    for (const item_hash_t& block_id_in_synopsis : boost::adaptors::reverse(blockchain_synopsis))
-                    {
-                        if (block_id_in_synopsis == block_id_type() || (_chain_db->is_known_block(block_id_in_synopsis)
-                                                                        && is_included_block(block_id_in_synopsis)))
-                        {
-                            last_known_block_id = block_id_in_synopsis;
-                            found_a_block_in_synopsis = true;
-                            break;
-                        }
-                    }
-
-                    if (!found_a_block_in_synopsis)
-                        FC_THROW_EXCEPTION(
-                            graphene::net::peer_is_on_an_unreachable_fork,
-                            "Unable to provide a list of blocks starting at any of the blocks in peer's synopsis");
-                }
-
-                for (uint32_t num = block_header::num_from_id(last_known_block_id);
-                     num <= _chain_db->head_block_num() && result.size() < limit; ++num)
-                {
-                    if (num > 0)
-                    {
-                        result.push_back(_chain_db->get_block_id_for_num(num));
-                    }
-                }
-
-                if (!result.empty() && block_header::num_from_id(result.back()) < _chain_db->head_block_num())
-                {
-                    remaining_item_count = _chain_db->head_block_num() - block_header::num_from_id(result.back());
-                }
-
-                return result;
-            });
+            return _chain_db->with_read_lock(
+                [&]() { return app::get_block_ids(*_chain_db, blockchain_synopsis, remaining_item_count, limit); });
         }
         FC_CAPTURE_AND_RETHROW((blockchain_synopsis)(remaining_item_count)(limit))
     }
@@ -748,14 +793,19 @@ public:
             if (id.item_type == graphene::net::block_message_type)
             {
                 return _chain_db->with_read_lock([&]() {
-                    auto opt_block = _chain_db->fetch_block_by_id(id.item_hash);
-                    if (!opt_block)
+                    auto packed_block = _chain_db->fetch_packed_block_by_id(id.item_hash);
+                    if (!packed_block)
+                    {
+                        // pruned blocks are not available, the peer is answered with item_not_available_message
+                        const uint32_t block_num = block_header::num_from_id(id.item_hash);
+                        if (block_num < _chain_db->first_available_block_num())
+                            FC_THROW_EXCEPTION(fc::key_not_found_exception, "Block ${n} is pruned", ("n", block_num));
+
                         elog("Couldn't find block ${id} -- corresponding ID in our chain is ${id2}",
-                             ("id", id.item_hash)(
-                                 "id2", _chain_db->get_block_id_for_num(block_header::num_from_id(id.item_hash))));
-                    FC_ASSERT(opt_block.valid());
-                    // ilog("Serving up block #${num}", ("num", opt_block->block_num()));
-                    return block_message(std::move(*opt_block));
+                             ("id", id.item_hash)("id2", _chain_db->get_block_id_for_num(block_num)));
+                    }
+                    FC_ASSERT(packed_block.valid());
+                    return make_block_message(std::move(*packed_block), id.item_hash);
                 });
             }
             return _chain_db->with_read_lock(
@@ -1032,6 +1082,11 @@ public:
         return _chain_db->with_read_lock([&]() { return _chain_db->head_block_id(); });
     }
 
+    virtual uint32_t get_first_available_block_number() const override
+    {
+        return _chain_db->with_read_lock([&]() { return _chain_db->first_available_block_num(); });
+    }
+
     virtual uint32_t estimate_last_known_fork_from_git_revision_timestamp(uint32_t unix_timestamp) const override
     {
         return 0; // there are no forks in graphene
@@ -1051,6 +1106,8 @@ public:
     void shutdown()
     {
         _running = false;
+        if (_pending_revalidation.valid() && !_pending_revalidation.ready())
+            _pending_revalidation.cancel_and_wait();
         fc::usleep(fc::seconds(1));
         if (_p2p_network)
         {
@@ -1085,6 +1142,9 @@ public:
 
     std::shared_ptr<scorum::chain::database> _chain_db;
     std::shared_ptr<graphene::net::node> _p2p_network;
+    std::unique_ptr<rpc_worker_pool> _rpc_workers;
+    std::unique_ptr<api_response_cache> _response_cache;
+    std::set<std::string> _rpc_worker_apis;
     std::shared_ptr<fc::http::websocket_server> _websocket_server;
     std::shared_ptr<fc::http::websocket_tls_server> _websocket_tls_server;
 
@@ -1100,6 +1160,7 @@ public:
     uint64_t _shared_file_size;
 
     bool _running;
+    fc::future<void> _pending_revalidation;
 
     uint32_t allow_future_time = 5;
 };
@@ -1145,6 +1206,23 @@ std::vector<std::string> application::get_default_apis() const
     return result;
 }
 
+std::vector<std::string> application::get_default_rpc_worker_apis() const
+{
+    std::vector<std::string> result;
+
+    result.push_back(API_DATABASE);
+    result.push_back(API_CHAIN);
+    result.push_back(ADVERTISING_API_NAME);
+    result.push_back(API_BETTING);
+    result.push_back("tags_api");
+    result.push_back(API_ACCOUNT_HISTORY);
+    result.push_back(API_BLOCKCHAIN_HISTORY);
+    result.push_back(API_ACCOUNT_STATISTICS);
+    result.push_back(API_BLOCKCHAIN_STATISTICS);
+
+    return result;
+}
+
 std::vector<std::string> application::get_default_plugins() const
 {
     std::vector<std::string> result;
@@ -1162,9 +1240,11 @@ void application::set_program_options(boost::program_options::options_descriptio
 {
     const auto default_apis = get_default_apis();
     const auto default_plugins = get_default_plugins();
+    const auto default_rpc_worker_apis = get_default_rpc_worker_apis();
 
     const std::string str_default_apis = boost::algorithm::join(default_apis, " ");
     const std::string str_default_plugins = boost::algorithm::join(default_plugins, " ");
+    const std::string str_default_rpc_worker_apis = boost::algorithm::join(default_rpc_worker_apis, " ");
 
     // clang-format off
     configuration_file_options.add_options()
@@ -1177,6 +1257,10 @@ void application::set_program_options(boost::program_options::options_descriptio
     ("shared-file-size", bpo::value<std::string>()->default_value("54G"), "Size of the shared memory file. Default: 54G")
     ("rpc-endpoint", bpo::value<std::string>()->implicit_value("127.0.0.1:8090"), "Endpoint for websocket RPC to listen on")
     ("rpc-tls-endpoint", bpo::value<std::string>()->implicit_value("127.0.0.1:8089"), "Endpoint for TLS websocket RPC to listen on")
+    ("rpc-worker-threads", bpo::value<uint32_t>()->default_value(0), "Number of threads running RPC calls of rpc-worker-api APIs, replies are sent out of order as soon as they are ready. 0 runs all calls on the websocket server thread")
+    ("rpc-worker-max-readers", bpo::value<uint32_t>()->default_value(4), "Maximum number of RPC calls run by rpc-worker-threads at once, other calls wait so the block writer isn't starved. 0 runs a call on every thread")
+    ("rpc-worker-api", bpo::value< std::vector<std::string> >()->composing()->default_value(default_rpc_worker_apis, str_default_rpc_worker_apis), "Read only API which calls are run by rpc-worker-threads, may be specified multiple times")
+    ("api-response-cache-size", bpo::value<uint64_t>()->default_value(0), "Size in MiB of the cache of JSON results of the API calls that are the same for all clients within a block. 0 disables it")
     ("read-forward-rpc", bpo::value<std::string>(), "Endpoint to forward write API calls to for a read node")
     ("server-pem,p", bpo::value<std::string>()->implicit_value("server.pem"), "The TLS certificate file for this server")
     ("server-pem-password,P", bpo::value<std::string>()->implicit_value(""), "Password for this certificate")
@@ -1185,6 +1269,10 @@ void application::set_program_options(boost::program_options::options_descriptio
     ("enable-plugin", bpo::value< std::vector<std::string> >()->composing()->default_value(default_plugins, str_default_plugins), "Plugin(s) to enable, may be specified multiple times")
     ("max-block-age", bpo::value< int32_t >()->default_value(200), "Maximum age of head block when broadcasting tx via API")
     ("flush", bpo::value< uint32_t >()->default_value(100000), "Flush shared memory file to disk this many blocks")
+    ("block-log-prune-blocks", bpo::value< uint32_t >()->default_value(0), "Keep only the last N irreversible blocks in the block log, 0 keeps all of them (archive node)")
+    ("pending-transactions-max-count", bpo::value< uint32_t >()->default_value(10000), "Maximum number of pending transactions, 0 for no limit")
+    ("pending-transactions-max-size", bpo::value< uint64_t >()->default_value(64 * 1024 * 1024), "Maximum packed size of pending transactions in bytes, 0 for no limit")
+    ("pending-transactions-revalidation-batch", bpo::value< uint32_t >()->default_value(100), "Number of pending transactions revalidated at once after a block, 0 revalidates all of them while pushing the block")
     ("genesis-json,g", bpo::value<boost::filesystem::path>(), "File to read genesis state from")
     ("replay-blockchain", "Rebuild object graph by replaying all blocks")
     ("replay-skip-witness-schedule-check", bpo::value<bool>()->default_value(true), "Skip witness schedule check wile block replaying")
@@ -1192,6 +1280,7 @@ void application::set_program_options(boost::program_options::options_descriptio
     ("force-validate", "Force validation of all transactions")
     ("read-only", "Node will not connect to p2p network and can only read from the chain state")
     ("check-locks", "Check correctness of chainbase locking")
+    ("debug-trace-size", bpo::value<uint32_t>()->default_value(0), "Number of the last chain debug records kept in binary ring buffer data_dir/blockchain/debug_trace (survives a crash, print it with dump_debug_trace). 0 disables it")
     ("disable-get-block", "Disable get_block API call");
 
     // clang-format on
@@ -0,0 +1,83 @@
+#include <scorum/app/block_ids.hpp>
+
+#include <scorum/chain/database/database.hpp>
+
+#include <graphene/net/exceptions.hpp>
+
+#include <boost/range/adaptor/reversed.hpp>
+
+namespace scorum {
+namespace app {
+
+using protocol::block_header;
+using protocol::block_id_type;
+
+std::vector<block_id_type> get_block_ids(const chain::database& db,
+                                         const std::vector<block_id_type>& blockchain_synopsis,
+                                         uint32_t& remaining_item_count,
+                                         uint32_t limit)
+{
+    std::vector<block_id_type> result;
+    remaining_item_count = 0;
+    if (db.head_block_num() == 0)
+    {
+        return result;
+    }
+
+    result.reserve(limit);
+    block_id_type last_known_block_id;
+
+    if (blockchain_synopsis.empty() || (blockchain_synopsis.size() == 1 && blockchain_synopsis[0] == block_id_type()))
+    {
+        // peer has sent us an empty synopsis meaning they have no blocks.
+        // A bug in old versions would cause them to send a synopsis containing block 000000000
+        // when they had an empty blockchain, so pretend they sent the right thing here.
+        // do nothing, leave last_known_block_id set to zero
+    }
+    else
+    {
+        bool found_a_block_in_synopsis = false;
+
+        for (const block_id_type& block_id_in_synopsis : boost::adaptors::reverse(blockchain_synopsis))
+        {
+            if (block_id_in_synopsis == block_id_type()
+                || (db.is_known_block(block_id_in_synopsis)
+                    && db.find_block_id_for_num(block_header::num_from_id(block_id_in_synopsis))
+                        == block_id_in_synopsis))
+            {
+                last_known_block_id = block_id_in_synopsis;
+                found_a_block_in_synopsis = true;
+                break;
+            }
+        }
+
+        if (!found_a_block_in_synopsis)
+            FC_THROW_EXCEPTION(graphene::net::peer_is_on_an_unreachable_fork,
+                               "Unable to provide a list of blocks starting at any of the blocks in peer's synopsis");
+    }
+
+    const uint32_t last_known_block_num = block_header::num_from_id(last_known_block_id);
+
+    // the peer can't link blocks after a gap, so it has to sync from a node which still has the pruned ones
+    if (last_known_block_num + 1 < db.first_available_block_num())
+        FC_THROW_EXCEPTION(graphene::net::peer_is_on_an_unreachable_fork,
+                           "Unable to provide a list of blocks starting at ${n}, blocks before ${first} are pruned",
+                           ("n", last_known_block_num)("first", db.first_available_block_num()));
+
+    for (uint32_t num = last_known_block_num; num <= db.head_block_num() && result.size() < limit; ++num)
+    {
+        if (num > 0)
+        {
+            result.push_back(db.get_block_id_for_num(num));
+        }
+    }
+
+    if (!result.empty() && block_header::num_from_id(result.back()) < db.head_block_num())
+    {
+        remaining_item_count = db.head_block_num() - block_header::num_from_id(result.back());
+    }
+
+    return result;
+}
+}
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <fc/variant.hpp>
+
+#include <boost/optional.hpp>
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace scorum {
+namespace app {
+
+enum class api_result_lifetime
+{
+    block, ///< valid until the next applied block
+    irreversible ///< never changes
+};
+
+/**
+ * @brief JSON results of the API calls shared by all connections
+ *
+ * Only calls known to give the same result to every client within one block are cached. Results of the calls about
+ * irreversible blocks are kept until evicted, others are dropped on every applied block. The least recently used
+ * results are evicted when the total size exceeds 'max_size' bytes. Thread safe.
+ */
+class api_response_cache
+{
+public:
+    explicit api_response_cache(size_t max_size);
+
+    static bool is_cacheable(const std::string& api, const std::string& method);
+
+    static std::string make_key(const std::string& api, const std::string& method, const fc::variant& args);
+
+    api_result_lifetime get_lifetime(const std::string& api,
+                                     const std::string& method,
+                                     const fc::variants& args,
+                                     const fc::variant& result) const;
+
+    boost::optional<std::string> find(const std::string& key);
+
+    /// 'generation' is taken before the call, results computed before the last state change are not cached
+    void insert(const std::string& key, const std::string& result, api_result_lifetime lifetime, uint64_t generation);
+
+    uint64_t generation() const
+    {
+        return _generation;
+    }
+
+    void on_applied_block(uint32_t last_irreversible_block_num);
+
+    size_t size() const;
+
+private:
+    struct entry
+    {
+        std::string key;
+        std::string result;
+        api_result_lifetime lifetime;
+
+        size_t size() const
+        {
+            // the key is kept by the index and, for the per block results, by the list of them
+            return (lifetime == api_result_lifetime::block ? 3 : 2) * key.size() + result.size();
+        }
+    };
+
+    using entries_type = std::list<entry>;
+
+    void erase(entries_type::iterator it);
+
+    void drop_block_results();
+
+    const size_t _max_size;
+    size_t _size = 0;
+
+    std::atomic<uint64_t> _generation{ 0 };
+    std::atomic<uint32_t> _last_irreversible_block_num{ 0 };
+
+    mutable std::mutex _mutex;
+    entries_type _entries; ///< the most recently used first
+    std::unordered_map<std::string, entries_type::iterator> _index;
+    /// keys of the per block results inserted since the last applied block, evicted ones are skipped on drop
+    std::vector<std::string> _block_result_keys;
+};
+}
+}
@@ -113,6 +113,7 @@ public:
 
     std::vector<std::string> get_default_apis() const;
     std::vector<std::string> get_default_plugins() const;
+    std::vector<std::string> get_default_rpc_worker_apis() const;
 
     bool is_read_only() const
     {
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <scorum/protocol/block_header.hpp>
+
+#include <vector>
+
+namespace scorum {
+namespace chain {
+class database;
+}
+namespace app {
+
+/**
+ * Returns up to 'limit' ids of blocks of the preferred chain starting from the last block of 'blockchain_synopsis'
+ * known to 'db', 'remaining_item_count' is set to the number of blocks after the returned ones.
+ *
+ * Throws peer_is_on_an_unreachable_fork if no block of the synopsis is known or if the blocks after the known one are
+ * pruned from the block log.
+ */
+std::vector<protocol::block_id_type> get_block_ids(const chain::database& db,
+                                                   const std::vector<protocol::block_id_type>& blockchain_synopsis,
+                                                   uint32_t& remaining_item_count,
+                                                   uint32_t limit);
+}
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <fc/network/http/websocket.hpp>
+#include <fc/rpc/websocket_api.hpp>
+#include <fc/thread/future.hpp>
+
+#include <deque>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+
+namespace scorum {
+namespace app {
+
+class api_response_cache;
+class rpc_worker_pool;
+
+/**
+ * @brief Websocket API connection running calls in the worker pool and answering from the response cache
+ *
+ * Both the pool and the cache are optional. Requests are parsed on the connection thread. Calls of the pooled APIs
+ * are run and encoded by the workers, many calls of a connection at once, and every reply is sent as soon as it is
+ * ready, out of order (clients match replies by id). Cached results are replied at once. The pooled calls only read
+ * the RPC state of the connection (registered APIs and methods). Other requests (login, broadcasts, callbacks) can
+ * change it, so each of them runs on the connection thread alone: after the pooled calls in flight have finished and
+ * before the pooled calls received after it start.
+ */
+class rpc_api_connection : public fc::rpc::websocket_api_connection
+{
+public:
+    rpc_api_connection(const fc::http::websocket_connection_ptr& connection,
+                       rpc_worker_pool* pool,
+                       const std::set<std::string>& pooled_apis,
+                       api_response_cache* cache);
+
+    /// APIs of the session, calls may address them by 'api_id' instead of the name
+    void register_api_name(uint64_t api_id, const std::string& name);
+
+private:
+    struct api_call
+    {
+        fc::variant_object request;
+        std::string api;
+        std::string method;
+        fc::variants args;
+        std::string cache_key; ///< empty for not cacheable calls
+    };
+
+    void on_request(const std::string& message);
+
+    bool parse_call(const std::string& message, api_call& call) const;
+
+    std::string run(const std::string& message, const api_call& call);
+
+    std::string make_reply(const api_call& call, const std::string& result) const;
+
+    std::string make_error_reply(const api_call& call, const fc::exception& e) const;
+
+    void dispatch(const std::string& message, const api_call& call);
+
+    /// runs a request which can change the RPC state, while no pooled call is in flight
+    void run_exclusive(const std::string& message, const api_call* call);
+
+    void wait_state_changed();
+    void notify_state_changed();
+
+    std::weak_ptr<fc::http::websocket_connection> _ws_connection;
+    rpc_worker_pool* _pool;
+    const std::set<std::string>& _pooled_apis;
+    api_response_cache* _cache;
+    std::map<uint64_t, std::string> _api_names;
+    std::map<std::string, uint64_t> _api_ids;
+    /// pooled calls received while exclusive requests are pending
+    std::deque<std::pair<std::string, api_call>> _queue;
+    uint32_t _in_flight = 0;
+    uint32_t _exclusive_pending = 0;
+    bool _exclusive_running = false;
+    fc::promise<void>::ptr _state_changed;
+};
+}
+}
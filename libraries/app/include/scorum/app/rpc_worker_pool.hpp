@@ -0,0 +1,53 @@
+#pragma once
+
+#include <fc/thread/thread.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace scorum {
+namespace app {
+
+/**
+ * @brief Threads running RPC calls out of the websocket server thread
+ *
+ * Every task goes to the worker with the least number of unfinished tasks. No more than 'max_readers' tasks run at
+ * once, the others wait, so the readers leave room for the block writer taking the database write lock.
+ */
+class rpc_worker_pool
+{
+public:
+    /// 'max_readers' 0 lets all the threads run tasks at once
+    rpc_worker_pool(uint32_t threads_count, uint32_t max_readers = 0);
+    ~rpc_worker_pool();
+
+    fc::future<void> async(std::function<void()> task);
+
+    size_t size() const
+    {
+        return _workers.size();
+    }
+
+private:
+    struct worker
+    {
+        std::unique_ptr<fc::thread> thread;
+        std::atomic<uint32_t> in_flight{ 0 };
+    };
+
+    void acquire_reader();
+    void release_reader();
+
+    std::vector<std::unique_ptr<worker>> _workers;
+
+    uint32_t _max_readers;
+    uint32_t _readers = 0;
+    std::mutex _readers_mutex;
+    std::condition_variable _readers_released;
+};
+}
+}
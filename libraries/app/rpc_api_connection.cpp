@@ -0,0 +1,282 @@
+#include <scorum/app/rpc_api_connection.hpp>
+
+#include <scorum/app/api_response_cache.hpp>
+#include <scorum/app/rpc_worker_pool.hpp>
+
+#include <fc/io/json.hpp>
+#include <fc/log/logger.hpp>
+#include <fc/variant_object.hpp>
+
+namespace scorum {
+namespace app {
+
+namespace {
+// these methods keep callbacks bound to the connection
+const std::set<std::string> connection_bound_methods
+    = { "set_block_applied_callback", "stream_blocks", "stream_ops_history" };
+}
+
+rpc_api_connection::rpc_api_connection(const fc::http::websocket_connection_ptr& connection,
+                                       rpc_worker_pool* pool,
+                                       const std::set<std::string>& pooled_apis,
+                                       api_response_cache* cache)
+    : fc::rpc::websocket_api_connection(*connection)
+    , _ws_connection(connection)
+    , _pool(pool)
+    , _pooled_apis(pooled_apis)
+    , _cache(cache)
+{
+    // replaces the handler set by websocket_api_connection
+    connection->on_message_handler([this](const std::string& message) { on_request(message); });
+}
+
+void rpc_api_connection::register_api_name(uint64_t api_id, const std::string& name)
+{
+    _api_names[api_id] = name;
+    _api_ids[name] = api_id;
+}
+
+void rpc_api_connection::on_request(const std::string& message)
+{
+    auto connection = _ws_connection.lock();
+    if (!connection)
+        return;
+
+    api_call call;
+    if (!parse_call(message, call))
+    {
+        run_exclusive(message, nullptr);
+        return;
+    }
+
+    if (!call.cache_key.empty())
+    {
+        auto result = _cache->find(call.cache_key);
+        if (result)
+        {
+            connection->send_message(make_reply(call, *result));
+            return;
+        }
+    }
+
+    if (!_pool || !_pooled_apis.count(call.api))
+    {
+        run_exclusive(message, &call);
+        return;
+    }
+
+    // the calls received after a login or a callback registration are run with the state it leaves
+    if (_exclusive_pending > 0)
+    {
+        _queue.emplace_back(message, call);
+        return;
+    }
+
+    dispatch(message, call);
+}
+
+bool rpc_api_connection::parse_call(const std::string& message, api_call& call) const
+{
+    try
+    {
+        call.request = fc::json::from_string(message).get_object();
+        if (!call.request.contains("id") || !call.request.contains("method")
+            || call.request["method"].as_string() != "call")
+            return false;
+
+        const auto& params = call.request["params"].get_array();
+        if (params.size() < 2)
+            return false;
+
+        // only the APIs registered for this session are handled here, the others (including the ones granted by
+        // login) are resolved and checked by websocket_api_connection
+        if (params[0].is_string())
+        {
+            call.api = params[0].as_string();
+            if (!_api_ids.count(call.api))
+                return false;
+        }
+        else
+        {
+            auto it = _api_names.find(params[0].as_uint64());
+            if (it == _api_names.end())
+                return false;
+            call.api = it->second;
+        }
+
+        call.method = params[1].as_string();
+        if (connection_bound_methods.count(call.method))
+            return false;
+
+        if (params.size() > 2)
+            call.args = params[2].get_array();
+
+        // the API is resolved for the session at this point, so cached results are given to the allowed callers only
+        if (_cache && api_response_cache::is_cacheable(call.api, call.method))
+            call.cache_key = api_response_cache::make_key(call.api, call.method, fc::variant(call.args));
+
+        return true;
+    }
+    catch (const fc::exception&)
+    {
+        // malformed requests are answered by websocket_api_connection
+        return false;
+    }
+}
+
+std::string rpc_api_connection::run(const std::string& message, const api_call& call)
+{
+    if (call.cache_key.empty())
+        return on_message(message, false);
+
+    const uint64_t generation = _cache->generation();
+
+    fc::variant result;
+    try
+    {
+        result = _rpc_state.local_call("call", call.request["params"].get_array());
+    }
+    catch (const fc::exception& e)
+    {
+        // errors are not cached
+        return make_error_reply(call, e);
+    }
+
+    const std::string result_json = fc::json::to_string(result);
+
+    _cache->insert(call.cache_key, result_json, _cache->get_lifetime(call.api, call.method, call.args, result),
+                   generation);
+
+    return make_reply(call, result_json);
+}
+
+std::string rpc_api_connection::make_reply(const api_call& call, const std::string& result) const
+{
+    std::string reply = "{\"id\":" + fc::json::to_string(call.request["id"]);
+    if (call.request.contains("jsonrpc"))
+        reply += ",\"jsonrpc\":" + fc::json::to_string(call.request["jsonrpc"]);
+    reply += ",\"result\":" + result + "}";
+
+    return reply;
+}
+
+std::string rpc_api_connection::make_error_reply(const api_call& call, const fc::exception& e) const
+{
+    // the same error object as websocket_api_connection replies with
+    fc::mutable_variant_object error;
+    error("code", 1)("message", e.to_detail_string())("data", fc::variant(e));
+
+    std::string reply = "{\"id\":" + fc::json::to_string(call.request["id"]);
+    if (call.request.contains("jsonrpc"))
+        reply += ",\"jsonrpc\":" + fc::json::to_string(call.request["jsonrpc"]);
+    reply += ",\"error\":" + fc::json::to_string(error) + "}";
+
+    return reply;
+}
+
+void rpc_api_connection::dispatch(const std::string& message, const api_call& call)
+{
+    auto connection = _ws_connection.lock();
+    if (!connection)
+        return;
+
+    ++_in_flight;
+
+    fc::thread* connection_thread = &fc::thread::current();
+
+    _pool->async([this, connection, connection_thread, message, call]() {
+        std::string reply;
+        try
+        {
+            reply = run(message, call);
+        }
+        catch (const fc::exception& e)
+        {
+            elog("RPC call failed: ${e}", ("e", e.to_detail_string()));
+        }
+        catch (const std::exception& e)
+        {
+            elog("RPC call failed: ${e}", ("e", e.what()));
+        }
+
+        // the counters are only touched on the connection thread
+        connection_thread->async([this, connection, reply]() {
+            try
+            {
+                if (!reply.empty())
+                    connection->send_message(reply);
+            }
+            catch (const fc::exception& e)
+            {
+                wlog("Can't send RPC reply: ${e}", ("e", e.to_detail_string()));
+            }
+
+            --_in_flight;
+            notify_state_changed();
+        });
+    });
+}
+
+void rpc_api_connection::run_exclusive(const std::string& message, const api_call* call)
+{
+    auto connection = _ws_connection.lock();
+    if (!connection)
+        return;
+
+    ++_exclusive_pending;
+
+    while (_exclusive_running || _in_flight > 0)
+        wait_state_changed();
+
+    _exclusive_running = true;
+
+    std::string reply;
+    try
+    {
+        reply = call ? run(message, *call) : on_message(message, false);
+    }
+    catch (...)
+    {
+        _exclusive_running = false;
+        --_exclusive_pending;
+        notify_state_changed();
+        throw;
+    }
+
+    _exclusive_running = false;
+    --_exclusive_pending;
+    notify_state_changed();
+
+    if (!reply.empty())
+        connection->send_message(reply);
+
+    if (_exclusive_pending == 0)
+    {
+        decltype(_queue) queue;
+        queue.swap(_queue);
+
+        for (const auto& next : queue)
+            dispatch(next.first, next.second);
+    }
+}
+
+void rpc_api_connection::wait_state_changed()
+{
+    if (!_state_changed)
+        _state_changed = fc::promise<void>::ptr(new fc::promise<void>("rpc_api_connection::state_changed"));
+
+    fc::future<void>(_state_changed).wait();
+}
+
+void rpc_api_connection::notify_state_changed()
+{
+    if (!_state_changed)
+        return;
+
+    // the waiters check the state again and wait for a new promise
+    auto state_changed = std::move(_state_changed);
+    _state_changed.reset();
+    state_changed->set_value();
+}
+}
+}
@@ -0,0 +1,70 @@
+#include <scorum/app/rpc_worker_pool.hpp>
+
+#include <algorithm>
+#include <string>
+
+namespace scorum {
+namespace app {
+
+rpc_worker_pool::rpc_worker_pool(uint32_t threads_count, uint32_t max_readers)
+    : _max_readers(max_readers ? std::min(max_readers, threads_count) : threads_count)
+{
+    FC_ASSERT(threads_count > 0, "RPC worker pool must have threads");
+
+    for (uint32_t i = 0; i < threads_count; ++i)
+    {
+        _workers.emplace_back(new worker());
+        _workers.back()->thread.reset(new fc::thread("rpc_worker_" + std::to_string(i)));
+    }
+}
+
+rpc_worker_pool::~rpc_worker_pool()
+{
+    for (auto& w : _workers)
+        w->thread->quit();
+}
+
+fc::future<void> rpc_worker_pool::async(std::function<void()> task)
+{
+    auto it = std::min_element(_workers.begin(), _workers.end(),
+                               [](const std::unique_ptr<worker>& lhs, const std::unique_ptr<worker>& rhs) {
+                                   return lhs->in_flight < rhs->in_flight;
+                               });
+
+    worker& w = **it;
+    ++w.in_flight;
+
+    return w.thread->async([this, &w, task]() {
+        acquire_reader();
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            release_reader();
+            --w.in_flight;
+            throw;
+        }
+        release_reader();
+        --w.in_flight;
+    });
+}
+
+void rpc_worker_pool::acquire_reader()
+{
+    std::unique_lock<std::mutex> lock(_readers_mutex);
+    _readers_released.wait(lock, [this]() { return _readers < _max_readers; });
+    ++_readers;
+}
+
+void rpc_worker_pool::release_reader()
+{
+    {
+        std::lock_guard<std::mutex> lock(_readers_mutex);
+        --_readers;
+    }
+    _readers_released.notify_one();
+}
+}
+}
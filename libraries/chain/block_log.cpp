@@ -2,6 +2,22 @@
 #include <fstream>
 #include <fc/io/raw.hpp>
 
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/locks.hpp>
+
+#include <zlib.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <thread>
+
 #define LOG_READ (std::ios::in | std::ios::binary)
 #define LOG_WRITE (std::ios::out | std::ios::binary | std::ios::app)
 
@@ -9,102 +25,775 @@ namespace scorum {
 namespace chain {
 
 namespace detail {
-class block_log_impl
+
+const char compressed_log_magic[8] = { 'S', 'C', 'R', 'B', 'L', 'K', 'Z', '1' };
+
+struct compressed_log_header
+{
+    char magic[8];
+    uint32_t blocks_per_chunk;
+    uint32_t reserved;
+};
+
+struct chunk_header
+{
+    uint32_t raw_size;
+    uint32_t compressed_size;
+};
+
+/* File descriptor for positional reads, they don't move a shared file position, so any number of threads can read
+ * at once. Appended data is visible to the reads after the writing stream is flushed.
+ */
+class read_file
 {
 public:
-    optional<signed_block> head;
-    block_id_type head_id;
-    std::fstream block_stream;
-    std::fstream index_stream;
-    fc::path block_file;
-    fc::path index_file;
-    bool block_write;
-    bool index_write;
+    read_file() = default;
+    read_file(const read_file&) = delete;
+    read_file& operator=(const read_file&) = delete;
 
-    inline void check_block_read()
+    ~read_file()
     {
-        try
+        close();
+    }
+
+    void open(const fc::path& file)
+    {
+        close();
+
+        _fd = ::open(file.generic_string().c_str(), O_RDONLY);
+        FC_ASSERT(_fd >= 0, "Can't open ${f}: ${e}", ("f", file)("e", std::strerror(errno)));
+    }
+
+    void close()
+    {
+        if (_fd >= 0)
+            ::close(_fd);
+        _fd = -1;
+    }
+
+    void read(uint64_t offset, char* data, size_t size) const
+    {
+        while (size > 0)
         {
-            if (block_write)
-            {
-                block_stream.close();
-                block_stream.open(block_file.generic_string().c_str(), LOG_READ);
-                block_write = false;
-            }
+            const ssize_t n = ::pread(_fd, data, size, (off_t)offset);
+            if (n < 0 && errno == EINTR)
+                continue;
+
+            FC_ASSERT(n > 0, "Can't read ${size} bytes at ${offset}", ("size", size)("offset", offset));
+            data += n;
+            size -= (size_t)n;
+            offset += (uint64_t)n;
         }
-        FC_LOG_AND_RETHROW()
     }
 
-    inline void check_block_write()
+    /// reads the block not knowing its size, the read is doubled until the block fits
+    /// @returns the block and the offset right after it
+    std::pair<signed_block, uint64_t> read_block(uint64_t offset, uint64_t end) const
     {
-        try
+        FC_ASSERT(offset < end, "Wrong block offset ${offset}", ("offset", offset));
+
+        size_t size = (size_t)std::min<uint64_t>(64 * 1024, end - offset);
+        for (;;)
         {
-            if (!block_write)
+            std::vector<char> data(size);
+            read(offset, data.data(), data.size());
+
+            try
+            {
+                fc::datastream<const char*> ds(data.data(), data.size());
+
+                std::pair<signed_block, uint64_t> result;
+                fc::raw::unpack(ds, result.first);
+                result.second = offset + (data.size() - ds.remaining());
+                return result;
+            }
+            catch (const fc::exception&)
             {
-                block_stream.close();
-                block_stream.open(block_file.generic_string().c_str(), LOG_WRITE);
-                block_write = true;
+                if (size == end - offset)
+                    throw;
             }
+
+            size = (size_t)std::min<uint64_t>(2 * size, end - offset);
         }
-        FC_LOG_AND_RETHROW()
     }
 
-    inline void check_index_read()
+private:
+    int _fd = -1;
+};
+
+/// appends [from, to) of 'in' to 'out'
+void copy_file_part(const read_file& in, uint64_t from, uint64_t to, std::ofstream& out)
+{
+    std::vector<char> buffer(1024 * 1024);
+    for (uint64_t p = from; p < to; p += buffer.size())
     {
-        try
+        const size_t n = (size_t)std::min<uint64_t>(buffer.size(), to - p);
+        in.read(p, buffer.data(), n);
+        out.write(buffer.data(), n);
+    }
+}
+
+/* The log as a stream of bytes: every block is followed by its 8 bytes position in the stream.
+ * Positions of the index file are positions of this stream whatever the file format is.
+ *
+ * Reads may run concurrently with each other, but not with the appends (see block_log_impl::mutex).
+ */
+class block_storage
+{
+public:
+    virtual ~block_storage() = default;
+
+    virtual uint64_t begin() = 0;
+    virtual uint64_t size() = 0;
+    virtual void read(uint64_t pos, char* data, size_t size) = 0;
+    /// returns the block and the position of the next one
+    virtual std::pair<signed_block, uint64_t> read_block(uint64_t pos) = 0;
+    virtual void append(uint32_t block_num, const char* data, size_t size) = 0;
+    virtual void flush() = 0;
+};
+
+/* The stream is stored as it is starting from 'base' position. The base is the position of the first block written
+ * after it, it's nonzero for pruned logs and tails of compressed logs. 'empty_base' is used when the file is empty.
+ */
+class raw_block_storage : public block_storage
+{
+public:
+    explicit raw_block_storage(const fc::path& file, uint64_t empty_base = 0)
+        : _file(file)
+        , _base(empty_base)
+    {
+        open();
+
+        const uint64_t file_size = fc::file_size(_file);
+        if (file_size > 0)
         {
-            if (index_write)
-            {
-                index_stream.close();
-                index_stream.open(index_file.generic_string().c_str(), LOG_READ);
-                index_write = false;
-            }
+            _base = 0;
+            _end = file_size;
+
+            auto first = read_block(0);
+            read(first.second - sizeof(_base), (char*)&_base, sizeof(_base));
         }
-        FC_LOG_AND_RETHROW()
+
+        _end = _base + file_size;
     }
 
-    inline void check_index_write()
+    uint64_t begin() override
     {
-        try
+        return _base;
+    }
+
+    uint64_t size() override
+    {
+        return _end;
+    }
+
+    void read(uint64_t pos, char* data, size_t size) override
+    {
+        FC_ASSERT(pos >= _base && pos + size <= _end, "Read out of block log.", ("pos", pos)("size", size));
+
+        _in.read(pos - _base, data, size);
+    }
+
+    std::pair<signed_block, uint64_t> read_block(uint64_t pos) override
+    {
+        FC_ASSERT(pos >= _base, "Read out of block log.", ("pos", pos)("base", _base));
+
+        auto result = _in.read_block(pos - _base, _end - _base);
+        result.second += _base + sizeof(uint64_t);
+        return result;
+    }
+
+    void append(uint32_t, const char* data, size_t size) override
+    {
+        _out.write(data, size);
+        _end += size;
+    }
+
+    void flush() override
+    {
+        _out.flush();
+    }
+
+    /// drops the content of the file, the next appended byte gets 'base' position
+    void reset(uint64_t base)
+    {
+        _out.close();
+        fc::remove_all(_file);
+        open();
+        _base = base;
+        _end = base;
+    }
+
+    /// copies the stream from 'pos' up to 'end' to 'out', it runs along with reads and appends of the other threads
+    void copy(uint64_t pos, uint64_t end, std::ofstream& out) const
+    {
+        copy_file_part(_in, pos - _base, end - _base, out);
+    }
+
+    /// replaces the file by 'file' holding the stream from 'pos' up to 'end', the blocks appended after 'end' are
+    /// copied to it, so the content before 'pos' is dropped
+    void replace(const fc::path& file, uint64_t pos, uint64_t end)
+    {
+        FC_ASSERT(pos >= _base && pos <= end && end <= _end, "Wrong prune position.", ("pos", pos)("base", _base));
+
+        flush();
         {
-            if (!index_write)
-            {
-                index_stream.close();
-                index_stream.open(index_file.generic_string().c_str(), LOG_WRITE);
-                index_write = true;
-            }
+            std::ofstream out(file.generic_string().c_str(), LOG_WRITE);
+            copy(end, _end, out);
+
+            out.flush();
+            FC_ASSERT(out.good(), "Can't write ${f}", ("f", file));
+        }
+
+        _out.close();
+        fc::rename(file, _file);
+        open();
+        _base = pos;
+    }
+
+private:
+    void open()
+    {
+        _out.exceptions(std::fstream::failbit | std::fstream::badbit);
+        _out.open(_file.generic_string().c_str(), LOG_WRITE);
+        _in.open(_file);
+    }
+
+    fc::path _file;
+    uint64_t _base;
+    uint64_t _end = 0;
+    std::ofstream _out;
+    read_file _in;
+};
+
+/* The stream is split into chunks of 'blocks_per_chunk' blocks compressed independently.
+ *
+ * +--------+-----------------------+-----------------------+-----+
+ * | Header | Chunk header | Chunk  | Chunk header | Chunk  | ... |
+ * +--------+-----------------------+-----------------------+-----+
+ *
+ * Blocks of the unfinished chunk are kept uncompressed in the tail file, they are compressed and the tail
+ * is truncated when the last block of the chunk is appended. The list of chunks is built by walking chunk headers
+ * on open, a chunk is found by a binary search of the position, and the last read chunk is kept decompressed
+ * so sequential reads decompress every chunk once. The decompressed chunk is shared by the readers under its own
+ * mutex.
+ */
+class compressed_block_storage : public block_storage
+{
+    struct chunk
+    {
+        uint64_t offset; ///< of the chunk header in the file
+        uint64_t pos; ///< of the first byte in the stream
+        chunk_header header;
+    };
+
+public:
+    explicit compressed_block_storage(const fc::path& file)
+        : _file(file)
+    {
+        open();
+
+        compressed_log_header header;
+        FC_ASSERT(fc::file_size(_file) >= sizeof(header), "Invalid compressed block log ${f}", ("f", _file));
+        _in.read(0, (char*)&header, sizeof(header));
+        FC_ASSERT(std::equal(header.magic, header.magic + sizeof(header.magic), compressed_log_magic)
+                      && header.blocks_per_chunk > 0,
+                  "Invalid compressed block log ${f}", ("f", _file));
+        _blocks_per_chunk = header.blocks_per_chunk;
+
+        load_chunks();
+
+        _tail.reset(new raw_block_storage(block_log::block_log_tail_path(_file), tail_pos()));
+        drop_compressed_tail();
+    }
+
+    uint64_t begin() override
+    {
+        return 0;
+    }
+
+    uint64_t size() override
+    {
+        return _tail->size();
+    }
+
+    void read(uint64_t pos, char* data, size_t size) override
+    {
+        if (pos >= tail_pos())
+            return _tail->read(pos, data, size);
+
+        std::lock_guard<std::mutex> lock(_cache_mutex);
+
+        const auto& c = load_chunk(pos);
+        FC_ASSERT(pos + size <= c.pos + c.header.raw_size, "Read crosses chunk bounds.", ("pos", pos)("size", size));
+
+        std::memcpy(data, _cache.data() + (pos - c.pos), size);
+    }
+
+    std::pair<signed_block, uint64_t> read_block(uint64_t pos) override
+    {
+        if (pos >= tail_pos())
+            return _tail->read_block(pos);
+
+        std::lock_guard<std::mutex> lock(_cache_mutex);
+
+        const auto& c = load_chunk(pos);
+
+        const size_t available = c.header.raw_size - (pos - c.pos);
+        fc::datastream<const char*> ds(_cache.data() + (pos - c.pos), available);
+
+        std::pair<signed_block, uint64_t> result;
+        fc::raw::unpack(ds, result.first);
+        result.second = pos + (available - ds.remaining()) + 8;
+        return result;
+    }
+
+    void append(uint32_t block_num, const char* data, size_t size) override
+    {
+        _tail->append(block_num, data, size);
+
+        if (block_num % _blocks_per_chunk == 0)
+            compress_tail();
+    }
+
+    void flush() override
+    {
+        _out.flush();
+        _tail->flush();
+    }
+
+private:
+    void open()
+    {
+        _out.exceptions(std::fstream::failbit | std::fstream::badbit);
+        _out.open(_file.generic_string().c_str(), LOG_WRITE);
+        _in.open(_file);
+    }
+
+    uint64_t tail_pos() const
+    {
+        return _chunks.empty() ? 0 : _chunks.back().pos + _chunks.back().header.raw_size;
+    }
+
+    void load_chunks()
+    {
+        const uint64_t file_size = fc::file_size(_file);
+
+        uint64_t offset = sizeof(compressed_log_header);
+        while (offset + sizeof(chunk_header) <= file_size)
+        {
+            chunk c = { offset, tail_pos(), {} };
+
+            _in.read(offset, (char*)&c.header, sizeof(c.header));
+
+            if (offset + sizeof(chunk_header) + c.header.compressed_size > file_size)
+                break;
+
+            _chunks.push_back(c);
+            offset += sizeof(chunk_header) + c.header.compressed_size;
         }
-        FC_LOG_AND_RETHROW()
+
+        if (offset != file_size)
+        {
+            wlog("Dropping incomplete chunk of compressed block log ${f}", ("f", _file));
+
+            _out.close();
+            fc::resize_file(_file, offset);
+            open();
+        }
+
+        _file_end = offset;
     }
+
+    // the tail could be left behind when the node stopped after writing the chunk
+    void drop_compressed_tail()
+    {
+        const uint64_t tail_end = _tail->size();
+        if (tail_end == tail_pos())
+            return;
+
+        uint64_t last_pos = 0;
+        if (tail_end > tail_pos() + sizeof(last_pos))
+            _tail->read(tail_end - sizeof(last_pos), (char*)&last_pos, sizeof(last_pos));
+
+        if (last_pos < tail_pos())
+        {
+            wlog("Dropping compressed tail of block log ${f}", ("f", _file));
+            _tail->reset(tail_pos());
+        }
+    }
+
+    const chunk& load_chunk(uint64_t pos)
+    {
+        auto it = std::upper_bound(_chunks.begin(), _chunks.end(), pos,
+                                   [](uint64_t p, const chunk& c) { return p < c.pos; });
+        FC_ASSERT(it != _chunks.begin(), "Wrong position in compressed block log.", ("pos", pos));
+        --it;
+
+        const size_t n = it - _chunks.begin();
+        if (n != _cached_chunk)
+        {
+            std::vector<char> compressed(it->header.compressed_size);
+            _in.read(it->offset + sizeof(chunk_header), compressed.data(), compressed.size());
+
+            _cache.resize(it->header.raw_size);
+            uLongf raw_size = _cache.size();
+            FC_ASSERT(uncompress((Bytef*)_cache.data(), &raw_size, (const Bytef*)compressed.data(), compressed.size())
+                              == Z_OK
+                          && raw_size == _cache.size(),
+                      "Corrupted chunk of compressed block log.", ("offset", it->offset));
+
+            _cached_chunk = n;
+        }
+
+        return *it;
+    }
+
+    void compress_tail()
+    {
+        const uint64_t pos = tail_pos();
+
+        std::vector<char> raw(_tail->size() - pos);
+        _tail->flush();
+        _tail->read(pos, raw.data(), raw.size());
+
+        uLongf compressed_size = compressBound(raw.size());
+        std::vector<char> compressed(compressed_size);
+        FC_ASSERT(compress2((Bytef*)compressed.data(), &compressed_size, (const Bytef*)raw.data(), raw.size(),
+                            Z_DEFAULT_COMPRESSION)
+                      == Z_OK,
+                  "Can't compress block log chunk.");
+
+        chunk c = { _file_end, pos, { (uint32_t)raw.size(), (uint32_t)compressed_size } };
+        _out.write((const char*)&c.header, sizeof(c.header));
+        _out.write(compressed.data(), compressed_size);
+        _out.flush();
+        _file_end += sizeof(c.header) + compressed_size;
+
+        _chunks.push_back(c);
+        _tail->reset(tail_pos());
+    }
+
+    fc::path _file;
+    std::ofstream _out;
+    read_file _in;
+    uint64_t _file_end = 0;
+
+    uint32_t _blocks_per_chunk;
+    std::vector<chunk> _chunks;
+    std::unique_ptr<raw_block_storage> _tail;
+
+    std::mutex _cache_mutex;
+    size_t _cached_chunk = std::numeric_limits<size_t>::max();
+    std::vector<char> _cache;
 };
+
+bool is_compressed_log(const fc::path& file)
+{
+    if (!fc::exists(file) || fc::file_size(file) < sizeof(compressed_log_header))
+        return false;
+
+    char magic[sizeof(compressed_log_magic)];
+    std::ifstream in(file.generic_string().c_str(), LOG_READ);
+    in.read(magic, sizeof(magic));
+
+    return std::equal(magic, magic + sizeof(magic), compressed_log_magic);
+}
+
+class block_log_impl
+{
+public:
+    optional<signed_block> head;
+    block_id_type head_id;
+    uint32_t first_num = 0;
+    uint32_t prune_blocks = 0;
+    std::unique_ptr<block_storage> blocks;
+    std::ofstream index_out;
+    std::ofstream ids_out;
+    read_file index_in;
+    read_file ids_in;
+    uint64_t index_size = 0;
+    fc::path block_file;
+    fc::path index_file;
+    fc::path ids_file;
+
+    /// reads take it shared, appends and pruning exclusively, so readers of any thread see consistent files
+    mutable boost::shared_mutex mutex;
+
+    /// the kept part of the files is copied by 'prune_thread' and the files are replaced by the next append
+    std::thread prune_thread;
+    std::atomic<bool> prune_copied{ false };
+    bool prune_failed = false;
+    uint32_t prune_first_num = 0;
+    uint64_t prune_pos = 0;
+    uint64_t prune_end = 0;
+    uint64_t prune_index_end = 0;
+
+    void open_index()
+    {
+        index_out.exceptions(std::fstream::failbit | std::fstream::badbit);
+        index_out.open(index_file.generic_string().c_str(), LOG_WRITE);
+        index_in.open(index_file);
+        index_size = fc::file_size(index_file);
+    }
+
+    void open_ids()
+    {
+        ids_out.exceptions(std::fstream::failbit | std::fstream::badbit);
+        ids_out.open(ids_file.generic_string().c_str(), LOG_WRITE);
+        ids_in.open(ids_file);
+    }
+
+    void reset_index()
+    {
+        index_out.close();
+        fc::remove_all(index_file);
+        open_index();
+    }
+
+    void reset_ids()
+    {
+        ids_out.close();
+        fc::remove_all(ids_file);
+        open_ids();
+    }
+
+    void flush()
+    {
+        if (blocks)
+            blocks->flush();
+        index_out.flush();
+        ids_out.flush();
+    }
+
+    uint32_t head_num() const
+    {
+        return head.valid() ? protocol::block_header::num_from_id(head_id) : 0;
+    }
+
+    /// the index and ids files start from the first block of the log
+    uint64_t index_offset(uint32_t block_num) const
+    {
+        return sizeof(uint64_t) * (block_num - first_num);
+    }
+
+    uint64_t ids_offset(uint32_t block_num) const
+    {
+        return sizeof(block_id_type) * (block_num - first_num);
+    }
+
+    uint64_t get_block_pos(uint32_t block_num) const
+    {
+        if (!(head.valid() && block_num <= head_num() && block_num >= first_num && block_num > 0))
+            return block_log::npos;
+
+        uint64_t pos;
+        index_in.read(index_offset(block_num), (char*)&pos, sizeof(pos));
+        return pos;
+    }
+
+    std::pair<signed_block, uint64_t> read_block(uint64_t pos) const
+    {
+        return blocks->read_block(pos);
+    }
+
+    signed_block read_head() const
+    {
+        uint64_t pos;
+        blocks->read(blocks->size() - sizeof(pos), (char*)&pos, sizeof(pos));
+        return read_block(pos).first;
+    }
+
+    fc::path tmp_path(const fc::path& file) const
+    {
+        return fc::path(file.generic_string() + ".tmp");
+    }
+
+    void construct_index();
+    void prune();
+    void start_pruning(uint32_t new_first_num);
+    void finish_pruning();
+};
+
+void block_log_impl::construct_index()
+{
+    ilog("Reconstructing Block Log Index...");
+    reset_index();
+    reset_ids();
+
+    uint64_t end_pos;
+    blocks->read(blocks->size() - sizeof(end_pos), (char*)&end_pos, sizeof(end_pos));
+
+    uint64_t pos = blocks->begin();
+    while (pos <= end_pos)
+    {
+        auto block = blocks->read_block(pos);
+
+        index_out.write((char*)&pos, sizeof(pos));
+
+        const auto id = block.first.id();
+        ids_out.write((const char*)&id, sizeof(id));
+
+        pos = block.second;
+    }
+
+    index_out.flush();
+    ids_out.flush();
+    index_size = fc::file_size(index_file);
+}
+
+void block_log_impl::prune()
+{
+    if (prune_thread.joinable())
+    {
+        if (prune_copied)
+            finish_pruning();
+        return;
+    }
+
+    if (!prune_blocks || !head.valid())
+        return;
+
+    // the log grows up to twice the kept blocks, so every block is copied once on average
+    if (head_num() - first_num + 1 < 2 * prune_blocks)
+        return;
+
+    start_pruning(head_num() - prune_blocks + 1);
+}
+
+void block_log_impl::start_pruning(uint32_t new_first_num)
+{
+    ilog("Pruning block log before block ${n}", ("n", new_first_num));
+
+    flush();
+
+    prune_first_num = new_first_num;
+    prune_pos = get_block_pos(new_first_num);
+    prune_end = blocks->size();
+    prune_index_end = index_size;
+    prune_copied = false;
+    prune_failed = false;
+
+    const uint64_t index_begin = index_offset(new_first_num);
+    const uint64_t ids_begin = ids_offset(new_first_num);
+    const uint64_t ids_end = ids_offset(head_num() + 1);
+
+    // the copied parts of the files don't change, so they are read without the lock
+    prune_thread = std::thread([this, index_begin, ids_begin, ids_end]() {
+        try
+        {
+            std::ofstream blocks_out(tmp_path(block_file).generic_string().c_str(),
+                                     std::ios::out | std::ios::binary | std::ios::trunc);
+            static_cast<raw_block_storage*>(blocks.get())->copy(prune_pos, prune_end, blocks_out);
+
+            std::ofstream index_tmp(tmp_path(index_file).generic_string().c_str(),
+                                    std::ios::out | std::ios::binary | std::ios::trunc);
+            copy_file_part(index_in, index_begin, prune_index_end, index_tmp);
+
+            std::ofstream ids_tmp(tmp_path(ids_file).generic_string().c_str(),
+                                  std::ios::out | std::ios::binary | std::ios::trunc);
+            copy_file_part(ids_in, ids_begin, ids_end, ids_tmp);
+
+            blocks_out.flush();
+            index_tmp.flush();
+            ids_tmp.flush();
+            FC_ASSERT(blocks_out.good() && index_tmp.good() && ids_tmp.good(), "Can't write pruned block log");
+        }
+        catch (const fc::exception& e)
+        {
+            elog("Block log pruning failed: ${e}", ("e", e.to_detail_string()));
+            prune_failed = true;
+        }
+        catch (const std::exception& e)
+        {
+            elog("Block log pruning failed: ${e}", ("e", e.what()));
+            prune_failed = true;
+        }
+
+        prune_copied = true;
+    });
+}
+
+void block_log_impl::finish_pruning()
+{
+    prune_thread.join();
+    prune_copied = false;
+
+    if (prune_failed)
+    {
+        fc::remove_all(tmp_path(block_file));
+        fc::remove_all(tmp_path(index_file));
+        fc::remove_all(tmp_path(ids_file));
+        return;
+    }
+
+    flush();
+
+    // the entries of blocks appended while copying are copied here
+    const uint64_t ids_end = ids_offset(head_num() + 1);
+    const uint64_t copied_ids_end = prune_index_end / sizeof(uint64_t) * sizeof(block_id_type);
+    {
+        std::ofstream index_tmp(tmp_path(index_file).generic_string().c_str(), LOG_WRITE);
+        copy_file_part(index_in, prune_index_end, index_size, index_tmp);
+
+        std::ofstream ids_tmp(tmp_path(ids_file).generic_string().c_str(), LOG_WRITE);
+        copy_file_part(ids_in, copied_ids_end, ids_end, ids_tmp);
+    }
+
+    // the block log goes first, the index and ids are rebuilt on open if they are left behind
+    static_cast<raw_block_storage*>(blocks.get())->replace(tmp_path(block_file), prune_pos, prune_end);
+
+    index_out.close();
+    fc::rename(tmp_path(index_file), index_file);
+    open_index();
+
+    ids_out.close();
+    fc::rename(tmp_path(ids_file), ids_file);
+    open_ids();
+
+    first_num = prune_first_num;
+
+    ilog("Block log is pruned, it starts from block ${n}", ("n", first_num));
+}
 }
 
 block_log::block_log()
     : my(new detail::block_log_impl())
 {
-    my->block_stream.exceptions(std::fstream::failbit | std::fstream::badbit);
-    my->index_stream.exceptions(std::fstream::failbit | std::fstream::badbit);
 }
 
 block_log::~block_log()
 {
+    finish_pruning();
     flush();
 }
 
 void block_log::open(const fc::path& file)
 {
-    if (my->block_stream.is_open())
-        my->block_stream.close();
-    if (my->index_stream.is_open())
-        my->index_stream.close();
+    finish_pruning();
+
+    boost::unique_lock<boost::shared_mutex> lock(my->mutex);
+
+    my->blocks.reset();
+    my->index_out.close();
+    my->ids_out.close();
 
     my->block_file = file;
     my->index_file = block_log_index_path(file);
+    my->ids_file = block_log_ids_path(file);
 
-    my->block_stream.open(my->block_file.generic_string().c_str(), LOG_WRITE);
-    my->index_stream.open(my->index_file.generic_string().c_str(), LOG_WRITE);
-    my->block_write = true;
-    my->index_write = true;
+    if (detail::is_compressed_log(my->block_file))
+    {
+        ilog("Log is compressed");
+        my->blocks.reset(new detail::compressed_block_storage(my->block_file));
+    }
+    else
+    {
+        my->blocks.reset(new detail::raw_block_storage(my->block_file));
+    }
+
+    my->open_index();
+    my->open_ids();
 
     /* On startup of the block log, there are several states the log file and the index file can be
      * in relation to eachother.
@@ -123,65 +812,142 @@ void block_log::open(const fc::path& file)
      *  - If they are the same, do nothing.
      *  - If the index file head is not in the log file, delete the index and replay.
      *  - If the index file head is in the log, but not up to date, replay from index head.
+     *
+     * The ids file follows the index file, it is replayed if it doesn't hold an id for every block of the log.
      */
-    auto log_size = fc::file_size(my->block_file);
-    auto index_size = fc::file_size(my->index_file);
+    auto log_size = my->blocks->size();
+    auto index_size = my->index_size;
+    auto ids_size = fc::file_size(my->ids_file);
 
     if (log_size)
     {
         ilog("Log is nonempty");
-        my->head = read_head();
+        my->head = my->read_head();
         my->head_id = my->head->id();
+        my->first_num = my->read_block(my->blocks->begin()).first.block_num();
 
-        if (index_size)
-        {
-            my->check_block_read();
-            my->check_index_read();
+        if (my->first_num > 1)
+            ilog("Log is pruned, it starts from block ${n}", ("n", my->first_num));
 
+        const uint64_t blocks_count = my->head->block_num() - my->first_num + 1;
+        if (ids_size != sizeof(block_id_type) * blocks_count)
+        {
+            ilog("Ids file doesn't match the log");
+            my->construct_index();
+        }
+        else if (index_size && index_size != sizeof(uint64_t) * blocks_count)
+        {
+            ilog("Index doesn't match the log");
+            my->construct_index();
+        }
+        else if (index_size)
+        {
             ilog("Index is nonempty");
             uint64_t block_pos;
-            my->block_stream.seekg(-sizeof(uint64_t), std::ios::end);
-            my->block_stream.read((char*)&block_pos, sizeof(block_pos));
+            my->blocks->read(log_size - sizeof(uint64_t), (char*)&block_pos, sizeof(block_pos));
 
             uint64_t index_pos;
-            my->index_stream.seekg(-sizeof(uint64_t), std::ios::end);
-            my->index_stream.read((char*)&index_pos, sizeof(index_pos));
+            my->index_in.read(index_size - sizeof(uint64_t), (char*)&index_pos, sizeof(index_pos));
 
             if (block_pos < index_pos)
             {
                 ilog("block_pos < index_pos, close and reopen index_stream");
-                construct_index();
+                my->construct_index();
             }
             else if (block_pos > index_pos)
             {
                 ilog("Index is incomplete");
-                construct_index();
+                my->construct_index();
             }
         }
         else
         {
             ilog("Index is empty");
-            construct_index();
+            my->construct_index();
         }
     }
-    else if (index_size)
+    else
     {
-        ilog("Index is nonempty, remove and recreate it");
-        my->index_stream.close();
-        fc::remove_all(my->index_file);
-        my->index_stream.open(my->index_file.generic_string().c_str(), LOG_WRITE);
-        my->index_write = true;
+        if (index_size)
+        {
+            ilog("Index is nonempty, remove and recreate it");
+            my->reset_index();
+        }
+
+        if (ids_size)
+        {
+            ilog("Ids file is nonempty, remove and recreate it");
+            my->reset_ids();
+        }
     }
 }
 
 void block_log::close()
 {
-    my.reset(new detail::block_log_impl());
+    finish_pruning();
+
+    boost::unique_lock<boost::shared_mutex> lock(my->mutex);
+
+    my->flush();
+    my->blocks.reset();
+    my->index_out.close();
+    my->ids_out.close();
+    my->index_in.close();
+    my->ids_in.close();
+    my->head.reset();
+    my->head_id = block_id_type();
+    my->first_num = 0;
+    my->prune_blocks = 0;
+    my->index_size = 0;
 }
 
 bool block_log::is_open() const
 {
-    return my->block_stream.is_open();
+    return my->blocks != nullptr;
+}
+
+void block_log::create_compressed(const fc::path& file, uint32_t blocks_per_chunk)
+{
+    FC_ASSERT(blocks_per_chunk > 0, "Chunk must have blocks");
+    FC_ASSERT(!fc::exists(file) || fc::file_size(file) == 0, "Block log ${f} already exists", ("f", file));
+
+    detail::compressed_log_header header = {};
+    std::copy(detail::compressed_log_magic, detail::compressed_log_magic + sizeof(header.magic), header.magic);
+    header.blocks_per_chunk = blocks_per_chunk;
+
+    std::ofstream out(file.generic_string().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    out.write((const char*)&header, sizeof(header));
+
+    fc::remove_all(block_log_tail_path(file));
+}
+
+bool block_log::is_compressed() const
+{
+    return dynamic_cast<detail::compressed_block_storage*>(my->blocks.get()) != nullptr;
+}
+
+void block_log::set_prune_blocks(uint32_t blocks)
+{
+    FC_ASSERT(blocks == 0 || !is_compressed(), "Compressed block log can't be pruned.");
+
+    boost::unique_lock<boost::shared_mutex> lock(my->mutex);
+
+    my->prune_blocks = blocks;
+    my->prune();
+}
+
+void block_log::finish_pruning()
+{
+    boost::unique_lock<boost::shared_mutex> lock(my->mutex);
+
+    if (my->prune_thread.joinable())
+        my->finish_pruning();
+}
+
+uint32_t block_log::first_block_num() const
+{
+    boost::shared_lock<boost::shared_mutex> lock(my->mutex);
+    return my->first_num;
 }
 
 fc::path block_log::block_log_index_path(const fc::path& file)
@@ -189,25 +955,50 @@ fc::path block_log::block_log_index_path(const fc::path& file)
     return fc::path(file.generic_string() + ".index");
 }
 
+fc::path block_log::block_log_ids_path(const fc::path& file)
+{
+    return fc::path(file.generic_string() + ".ids");
+}
+
+fc::path block_log::block_log_tail_path(const fc::path& file)
+{
+    return fc::path(file.generic_string() + ".tail");
+}
+
 uint64_t block_log::append(const signed_block& b)
+{
+    return append(b, b.id());
+}
+
+uint64_t block_log::append(const signed_block& b, const block_id_type& id)
 {
     try
     {
-        my->check_block_write();
-        my->check_index_write();
-
-        uint64_t pos = my->block_stream.tellp();
-        FC_ASSERT((uint64_t)my->index_stream.tellp()
-                      == (std::fstream::streampos)sizeof(uint64_t) * ((uint64_t)b.block_num() - 1),
-                  "Append to index file occuring at wrong position.",
-                  ("position", (uint64_t)my->index_stream.tellp())("expected",
-                                                                   ((uint64_t)b.block_num() - 1) * sizeof(uint64_t)));
         auto data = fc::raw::pack(b);
-        my->block_stream.write(data.data(), data.size());
-        my->block_stream.write((char*)&pos, sizeof(pos));
-        my->index_stream.write((char*)&pos, sizeof(pos));
+
+        boost::unique_lock<boost::shared_mutex> lock(my->mutex);
+
+        uint64_t pos = my->blocks->size();
+        // a new log starts from the first block
+        const uint64_t expected_index_size = sizeof(uint64_t) * ((uint64_t)b.block_num() - std::max(my->first_num, 1u));
+        FC_ASSERT(my->index_size == expected_index_size, "Append to index file occuring at wrong position.",
+                  ("position", my->index_size)("expected", expected_index_size));
+        data.insert(data.end(), (const char*)&pos, (const char*)&pos + sizeof(pos));
+        my->blocks->append(b.block_num(), data.data(), data.size());
+        my->index_out.write((char*)&pos, sizeof(pos));
+        my->ids_out.write((const char*)&id, sizeof(id));
+        my->index_size += sizeof(pos);
+
+        // the readers use files directly, the appended block has to be there
+        my->flush();
+
         my->head = b;
-        my->head_id = b.id();
+        my->head_id = id;
+
+        if (!my->first_num)
+            my->first_num = b.block_num();
+
+        my->prune();
 
         return pos;
     }
@@ -216,21 +1007,16 @@ uint64_t block_log::append(const signed_block& b)
 
 void block_log::flush()
 {
-    my->block_stream.flush();
-    my->index_stream.flush();
+    boost::unique_lock<boost::shared_mutex> lock(my->mutex);
+    my->flush();
 }
 
 std::pair<signed_block, uint64_t> block_log::read_block(uint64_t pos) const
 {
     try
     {
-        my->check_block_read();
-
-        my->block_stream.seekg(pos);
-        std::pair<signed_block, uint64_t> result;
-        fc::raw::unpack(my->block_stream, result.first);
-        result.second = uint64_t(my->block_stream.tellg()) + 8;
-        return result;
+        boost::shared_lock<boost::shared_mutex> lock(my->mutex);
+        return my->read_block(pos);
     }
     FC_LOG_AND_RETHROW()
 }
@@ -239,11 +1025,13 @@ optional<signed_block> block_log::read_block_by_num(uint32_t block_num) const
 {
     try
     {
+        boost::shared_lock<boost::shared_mutex> lock(my->mutex);
+
         optional<signed_block> b;
-        uint64_t pos = get_block_pos(block_num);
+        uint64_t pos = my->get_block_pos(block_num);
         if (pos != npos)
         {
-            b = read_block(pos).first;
+            b = my->read_block(pos).first;
             FC_ASSERT(b->block_num() == block_num, "Wrong block was read from block log.",
                       ("returned", b->block_num())("expected", block_num));
         }
@@ -252,69 +1040,83 @@ optional<signed_block> block_log::read_block_by_num(uint32_t block_num) const
     FC_LOG_AND_RETHROW()
 }
 
-uint64_t block_log::get_block_pos(uint32_t block_num) const
+optional<block_id_type> block_log::read_block_id_by_num(uint32_t block_num) const
 {
     try
     {
-        my->check_index_read();
+        boost::shared_lock<boost::shared_mutex> lock(my->mutex);
 
-        if (!(my->head.valid() && block_num <= protocol::block_header::num_from_id(my->head_id) && block_num > 0))
-            return npos;
-        my->index_stream.seekg(sizeof(uint64_t) * (block_num - 1));
-        uint64_t pos;
-        my->index_stream.read((char*)&pos, sizeof(pos));
-        return pos;
+        optional<block_id_type> id;
+
+        if (!(my->head.valid() && block_num <= my->head_num() && block_num > 0))
+            return id;
+
+        if (block_num == my->head_num())
+            return my->head_id;
+
+        // ids of pruned blocks are dropped along with the blocks
+        if (block_num < my->first_num)
+            return id;
+
+        block_id_type log_id;
+        my->ids_in.read(my->ids_offset(block_num), (char*)&log_id, sizeof(block_id_type));
+        id = log_id;
+
+        return id;
     }
     FC_LOG_AND_RETHROW()
 }
 
-signed_block block_log::read_head() const
+optional<std::vector<char>> block_log::read_packed(uint32_t block_num) const
 {
     try
     {
-        my->check_block_read();
+        boost::shared_lock<boost::shared_mutex> lock(my->mutex);
 
-        uint64_t pos;
-        my->block_stream.seekg(-sizeof(pos), std::ios::end);
-        my->block_stream.read((char*)&pos, sizeof(pos));
-        return read_block(pos).first;
+        optional<std::vector<char>> data;
+
+        uint64_t pos = my->get_block_pos(block_num);
+        if (pos == npos)
+            return data;
+
+        // every block is followed by its 8 bytes position, the next block starts right after it
+        uint64_t end_pos = my->get_block_pos(block_num + 1);
+        if (end_pos == npos)
+            end_pos = my->blocks->size();
+
+        FC_ASSERT(end_pos >= pos + sizeof(uint64_t), "Wrong block position in block log.",
+                  ("block_num", block_num)("pos", pos)("end_pos", end_pos));
+
+        data = std::vector<char>(end_pos - pos - sizeof(uint64_t));
+        my->blocks->read(pos, data->data(), data->size());
+        return data;
     }
     FC_LOG_AND_RETHROW()
 }
 
-const optional<signed_block>& block_log::head() const
+uint64_t block_log::get_block_pos(uint32_t block_num) const
 {
-    return my->head;
+    try
+    {
+        boost::shared_lock<boost::shared_mutex> lock(my->mutex);
+        return my->get_block_pos(block_num);
+    }
+    FC_LOG_AND_RETHROW()
 }
 
-void block_log::construct_index()
+signed_block block_log::read_head() const
 {
     try
     {
-        ilog("Reconstructing Block Log Index...");
-        my->index_stream.close();
-        fc::remove_all(my->index_file);
-        my->index_stream.open(my->index_file.generic_string().c_str(), LOG_WRITE);
-        my->index_write = true;
-
-        uint64_t pos = 0;
-        uint64_t end_pos;
-        my->check_block_read();
-
-        my->block_stream.seekg(-sizeof(uint64_t), std::ios::end);
-        my->block_stream.read((char*)&end_pos, sizeof(end_pos));
-        signed_block tmp;
-
-        my->block_stream.seekg(pos);
-
-        while (pos < end_pos)
-        {
-            fc::raw::unpack(my->block_stream, tmp);
-            my->block_stream.read((char*)&pos, sizeof(pos));
-            my->index_stream.write((char*)&pos, sizeof(pos));
-        }
+        boost::shared_lock<boost::shared_mutex> lock(my->mutex);
+        return my->read_head();
     }
     FC_LOG_AND_RETHROW()
 }
+
+const optional<signed_block>& block_log::head() const
+{
+    return my->head;
+}
 }
 } // scorum::chain
@@ -9,6 +9,7 @@
 #include <scorum/chain/services/atomicswap.hpp>
 #include <scorum/chain/services/budgets.hpp>
 #include <scorum/chain/services/comment.hpp>
+#include <scorum/chain/services/comment_content.hpp>
 #include <scorum/chain/services/comment_statistic.hpp>
 #include <scorum/chain/services/comment_vote.hpp>
 #include <scorum/chain/services/decline_voting_rights_request.hpp>
@@ -50,6 +51,7 @@ DATA_SERVICE_FACTORY_IMPL(
         (post_budget)
         (banner_budget)
         (comment)
+        (comment_content)
         (comment_statistic_scr)
         (comment_statistic_sp)
         (comment_vote)
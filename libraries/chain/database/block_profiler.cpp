@@ -0,0 +1,123 @@
+#include <scorum/chain/database/block_profiler.hpp>
+
+#include <scorum/protocol/operations.hpp>
+#include <scorum/protocol/operation_util_impl.hpp>
+
+#include <fc/log/logger.hpp>
+
+#include <algorithm>
+
+namespace scorum {
+namespace chain {
+
+namespace {
+
+block_profile_entry make_entry(const std::string& name, const block_profile_counter& counter)
+{
+    block_profile_entry entry;
+    entry.name = name;
+    entry.calls = counter.calls;
+    entry.total_time_us = counter.total_time_ns / 1000;
+    entry.allocated_shared_memory = counter.allocated_shared_memory;
+    return entry;
+}
+
+template <typename Counters> std::vector<block_profile_entry> make_entries(const Counters& counters)
+{
+    std::vector<block_profile_entry> result;
+    result.reserve(counters.size());
+
+    for (const auto& counter : counters)
+        result.push_back(make_entry(counter.first, counter.second));
+
+    return result;
+}
+
+std::string get_operation_name(int op_which)
+{
+    protocol::operation op;
+    op.set_which(op_which);
+
+    std::string name;
+    op.visit(fc::get_operation_name(name));
+    return name;
+}
+
+void sort_by_time(std::vector<block_profile_entry>& entries)
+{
+    std::sort(entries.begin(), entries.end(), [](const block_profile_entry& lhs, const block_profile_entry& rhs) {
+        return lhs.total_time_us > rhs.total_time_us;
+    });
+}
+
+void dump_entries(const char* title, std::vector<block_profile_entry> entries)
+{
+    sort_by_time(entries);
+
+    for (const auto& entry : entries)
+    {
+        ilog("${t} ${n}: ${us} us, ${c} calls, ${m} bytes of shared memory",
+             ("t", title)("n", entry.name)("us", entry.total_time_us)("c", entry.calls)(
+                 "m", entry.allocated_shared_memory));
+    }
+}
+}
+
+block_profiler::block_profiler(free_memory_getter_type free_memory_getter)
+    : _free_memory_getter(free_memory_getter)
+{
+}
+
+void block_profiler::enable(bool enabled)
+{
+    _enabled = enabled;
+}
+
+void block_profiler::reset()
+{
+    _blocks = 0;
+    _block = block_profile_counter();
+    _block_tasks.clear();
+    _operations.clear();
+    _signal_handlers.clear();
+}
+
+block_profile_counter& block_profiler::get_counter(counters_type& counters, const char* name)
+{
+    auto it = counters.find(name);
+    if (it == counters.end())
+        it = counters.emplace(name, block_profile_counter()).first;
+
+    return it->second;
+}
+
+block_profile block_profiler::get_profile() const
+{
+    block_profile result;
+
+    result.blocks = _blocks;
+    result.total_time_us = _block.total_time_ns / 1000;
+    result.block_tasks = make_entries(_block_tasks);
+    result.signal_handlers = make_entries(_signal_handlers);
+
+    for (size_t which = 0; which < _operations.size(); ++which)
+    {
+        if (_operations[which].calls > 0)
+            result.operations.push_back(make_entry(get_operation_name(which), _operations[which]));
+    }
+
+    return result;
+}
+
+void block_profiler::dump() const
+{
+    auto profile = get_profile();
+
+    ilog("Block profile: ${b} blocks applied in ${us} us", ("b", profile.blocks)("us", profile.total_time_us));
+
+    dump_entries("block task", std::move(profile.block_tasks));
+    dump_entries("operation", std::move(profile.operations));
+    dump_entries("signal handler", std::move(profile.signal_handlers));
+}
+}
+}
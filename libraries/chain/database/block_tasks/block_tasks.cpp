@@ -24,6 +24,11 @@ void block_task_context::push_virtual_operation(const operation& op)
     _vops.push_virtual_operation(op);
 }
 
+bool block_task_context::is_virtual_operation_observed() const
+{
+    return _vops.is_virtual_operation_observed();
+}
+
 } // database_ns
 }
 }
@@ -33,7 +33,8 @@ void process_comments_cashout_impl::close_comment_payout(const comment_object& c
         c.last_payout = dgp_service.head_block_time();
     });
 
-    _ctx.push_virtual_operation(comment_payout_update_operation(comment.author, fc::to_string(comment.permlink)));
+    if (_ctx.is_virtual_operation_observed())
+        _ctx.push_virtual_operation(comment_payout_update_operation(comment.author, fc::to_string(comment.permlink)));
 
 #ifdef CLEAR_VOTES
     auto comment_votes = comment_vote_service.get_by_comment(comment.id);
@@ -44,19 +45,17 @@ void process_comments_cashout_impl::close_comment_payout(const comment_object& c
 #endif
 }
 
-fc::uint128_t process_comments_cashout_impl::get_total_claims(const comment_refs_type& comments,
-                                                              curve_id reward_curve,
-                                                              fc::uint128_t recent_claims) const
+claims_vector_type process_comments_cashout_impl::get_claims(const comment_refs_type& comments,
+                                                            curve_id reward_curve) const
 {
     shares_vector_type total_rshares;
+    total_rshares.reserve(comments.size());
     for (const comment_object& comment : comments)
     {
         total_rshares.push_back(comment.net_rshares);
     }
 
-    fc::uint128_t total_claims = rewards_math::calculate_total_claims(recent_claims, reward_curve, total_rshares);
-
-    return total_claims;
+    return rewards_math::evaluate_reward_curve(total_rshares, reward_curve);
 }
 
 template <typename TFundService>
@@ -66,10 +65,10 @@ void process_comments_cashout_impl::reward(TFundService& fund_service, const com
     if (fund.activity_reward_balance.amount < 1 || comments.empty())
         return;
 
-    auto total_claims = get_total_claims(comments, fund.author_reward_curve, fund.recent_claims);
+    auto claims = get_claims(comments, fund.author_reward_curve);
+    auto total_claims = rewards_math::calculate_total_claims(fund.recent_claims, claims);
 
-    auto fund_rewards
-        = calculate_comments_payout(comments, fund.activity_reward_balance, total_claims, fund.author_reward_curve);
+    auto fund_rewards = calculate_comments_payout(comments, claims, fund.activity_reward_balance, total_claims);
 
     auto total_reward = hardfork_service.has_hardfork(SCORUM_HARDFORK_0_3)
         ? pay_for_comments(comments, fund_rewards)
@@ -112,20 +111,24 @@ asset process_comments_cashout_impl::pay_for_comments(const comment_refs_type& c
         if (author_reward.amount > 0)
             comment_service.set_rewarded_flag(comment);
 
-        _ctx.push_virtual_operation(
-            author_reward_operation(comment.author, fc::to_string(comment.permlink), author_reward));
-
         // clang-format off
-        _ctx.push_virtual_operation(comment_reward_operation(
-                comment.author,
-                fc::to_string(comment.permlink),
-                fund_reward,
-                claimed_reward,
-                author_reward,
-                curators_reward,
-                asset(0, reward_symbol),
-                asset(0, reward_symbol),
-                beneficiaries_reward));
+        if (_ctx.is_virtual_operation_observed())
+        {
+            const auto permlink = fc::to_string(comment.permlink);
+
+            _ctx.push_virtual_operation(author_reward_operation(comment.author, permlink, author_reward));
+
+            _ctx.push_virtual_operation(comment_reward_operation(
+                    comment.author,
+                    permlink,
+                    fund_reward,
+                    claimed_reward,
+                    author_reward,
+                    curators_reward,
+                    asset(0, reward_symbol),
+                    asset(0, reward_symbol),
+                    beneficiaries_reward));
+        }
 
         accumulate_statistic(comment,
                              author,
@@ -155,19 +158,17 @@ asset process_comments_cashout_impl::pay_for_comments_legacy(const comment_refs_
         share_type fund; // reward accrued from fund
         share_type commenting; // reward accrued from children comments
     };
-    struct comment_key
-    {
-        account_name_type author;
-        fc::shared_string permlink;
-    };
-    auto less = [](const comment_key& l, const comment_key& r) {
-        return std::tie(l.author, l.permlink) < std::tie(r.author, r.permlink);
+    // Before SCORUM_HARDFORK_0_1 rewards were associated with the author only (all author's comments share the
+    // same slot), so the comment part of the key is reset to the same value for every comment
+    const bool by_comment = hardfork_service.has_hardfork(SCORUM_HARDFORK_0_1);
+    auto make_key = [by_comment](const account_name_type& author, const comment_id_type& id) {
+        return std::make_pair(author, by_comment ? id : comment_id_type());
     };
 
-    std::map<comment_key, comment_reward, decltype(less)> comment_rewards(less);
+    std::map<std::pair<account_name_type, comment_id_type>, comment_reward> comment_rewards;
     for (auto i = 0u; i < comments.size(); ++i)
     {
-        comment_rewards.emplace(comment_key{ comments[i].get().author, get_permlink(comments[i].get().permlink) },
+        comment_rewards.emplace(make_key(comments[i].get().author, comments[i].get().id),
                                 comment_reward{ fund_rewards[i].amount, 0 });
     }
 
@@ -178,7 +179,7 @@ asset process_comments_cashout_impl::pay_for_comments_legacy(const comment_refs_
 
     for (const comment_object& comment : comments_with_parents)
     {
-        const auto& reward = comment_rewards[comment_key{ comment.author, get_permlink(comment.permlink) }];
+        const auto& reward = comment_rewards[make_key(comment.author, comment.id)];
 
         asset fund_reward = asset(reward.fund, reward_symbol);
         asset parent_payout_value = asset(reward.commenting, reward_symbol);
@@ -188,7 +189,7 @@ asset process_comments_cashout_impl::pay_for_comments_legacy(const comment_refs_
         total_reward += payout_result.total_claimed_reward;
 
         // save payout for the parent comment
-        comment_rewards[comment_key{ comment.parent_author, get_permlink(comment.parent_permlink) }].commenting
+        comment_rewards[make_key(comment.parent_author, comment.parent_id)].commenting
             += payout_result.parent_comment_reward.amount;
     }
 
@@ -231,20 +232,24 @@ process_comments_cashout_impl::comment_payout_result process_comments_cashout_im
         if (author_reward.amount > 0 || payout_from_children.amount > 0)
             comment_service.set_rewarded_flag(comment);
 
-        _ctx.push_virtual_operation(
-            author_reward_operation(comment.author, fc::to_string(comment.permlink), author_reward));
-
         // clang-format off
-        _ctx.push_virtual_operation(comment_reward_operation(
-                             comment.author,
-                             fc::to_string(comment.permlink),
-                             fund_reward,
-                             payout_result.total_claimed_reward,
-                             author_reward,
-                             curators_reward,
-                             payout_from_children,
-                             payout_to_parent,
-                             beneficiaries_reward));
+        if (_ctx.is_virtual_operation_observed())
+        {
+            const auto permlink = fc::to_string(comment.permlink);
+
+            _ctx.push_virtual_operation(author_reward_operation(comment.author, permlink, author_reward));
+
+            _ctx.push_virtual_operation(comment_reward_operation(
+                                 comment.author,
+                                 permlink,
+                                 fund_reward,
+                                 payout_result.total_claimed_reward,
+                                 author_reward,
+                                 curators_reward,
+                                 payout_from_children,
+                                 payout_to_parent,
+                                 beneficiaries_reward));
+        }
 
         accumulate_statistic(comment,
                              author,
@@ -277,9 +282,19 @@ process_comments_cashout_impl::pay_curators(const comment_object& comment, const
 
         auto rewarded = asset(0, reward_symbol);
         auto comment_votes = comment_vote_service.get_by_comment_weight_voter(comment.id);
+
+        rewards_math::weights_vector_type weights;
+        weights.reserve(comment_votes.size());
         for (const comment_vote_object& vote : comment_votes)
+            weights.push_back(vote.weight);
+
+        auto claims
+            = rewards_math::calculate_curation_payouts(potential_reward.amount, comment.total_vote_weight, weights);
+
+        for (const auto& item : boost::combine(comment_votes, claims))
         {
-            auto claim = potential_reward * utils::make_fraction(vote.weight, comment.total_vote_weight);
+            const comment_vote_object& vote = item.get<0>().get();
+            const auto claim = asset(item.get<1>(), reward_symbol);
             if (claim.amount > 0)
             {
                 rewarded += claim;
@@ -287,8 +302,9 @@ process_comments_cashout_impl::pay_curators(const comment_object& comment, const
                 const auto& voter = account_service.get(vote.voter);
                 pay_account(voter, claim);
 
-                _ctx.push_virtual_operation(
-                    curation_reward_operation(voter.name, claim, comment.author, fc::to_string(comment.permlink)));
+                if (_ctx.is_virtual_operation_observed())
+                    _ctx.push_virtual_operation(
+                        curation_reward_operation(voter.name, claim, comment.author, fc::to_string(comment.permlink)));
 
                 accumulate_statistic(voter, claim);
             }
@@ -310,8 +326,9 @@ asset process_comments_cashout_impl::pay_beneficiaries(const comment_object& com
         pay_account(account_service.get_account(beneficiary.account), beneficiary_reward);
         beneficiaries_reward += beneficiary_reward;
 
-        _ctx.push_virtual_operation(comment_benefficiary_reward_operation(
-            beneficiary.account, comment.author, fc::to_string(comment.permlink), beneficiary_reward));
+        if (_ctx.is_virtual_operation_observed())
+            _ctx.push_virtual_operation(comment_benefficiary_reward_operation(
+                beneficiary.account, comment.author, fc::to_string(comment.permlink), beneficiary_reward));
     }
 
     return beneficiaries_reward;
@@ -330,19 +347,27 @@ void process_comments_cashout_impl::pay_account(const account_object& recipient,
 }
 
 std::vector<asset> process_comments_cashout_impl::calculate_comments_payout(const comment_refs_type& comments,
+                                                                            const claims_vector_type& claims,
                                                                             const asset& reward_fund_balance,
-                                                                            fc::uint128_t total_claims,
-                                                                            curve_id reward_curve) const
+                                                                            fc::uint128_t total_claims) const
 {
-    std::vector<asset> rewards;
-    rewards.reserve(comments.size());
-
+    shares_vector_type rshares;
+    shares_vector_type max_payouts;
+    rshares.reserve(comments.size());
+    max_payouts.reserve(comments.size());
     for (const comment_object& comment : comments)
     {
-        share_type payout = rewards_math::calculate_payout(
-            comment.net_rshares, total_claims, reward_fund_balance.amount, reward_curve,
-            comment.max_accepted_payout.amount, SCORUM_MIN_COMMENT_PAYOUT_SHARE);
+        rshares.push_back(comment.net_rshares);
+        max_payouts.push_back(comment.max_accepted_payout.amount);
+    }
+
+    auto payouts = rewards_math::calculate_payouts(rshares, claims, total_claims, reward_fund_balance.amount,
+                                                   max_payouts, SCORUM_MIN_COMMENT_PAYOUT_SHARE);
 
+    std::vector<asset> rewards;
+    rewards.reserve(payouts.size());
+    for (const share_type& payout : payouts)
+    {
         rewards.emplace_back(payout, reward_fund_balance.symbol());
     }
 
@@ -426,7 +451,7 @@ comment_refs_type process_comments_cashout_impl::collect_parents(const comment_r
     {
         const comment_object& comment = it->get();
 
-        const auto& parent_comment = comment_service.get(comment.parent_author, fc::to_string(comment.parent_permlink));
+        const auto& parent_comment = get_parent(comment);
 
         // insert parent if it doesn't exist or do nothing if exists. Insertable parent will be always 'after' current
         // comment because of the set ordering
@@ -438,12 +463,13 @@ comment_refs_type process_comments_cashout_impl::collect_parents(const comment_r
     return comments_with_parents;
 }
 
-fc::shared_string process_comments_cashout_impl::get_permlink(const fc::shared_string& str) const
+const comment_object& process_comments_cashout_impl::get_parent(const comment_object& comment)
 {
-    if (hardfork_service.has_hardfork(SCORUM_HARDFORK_0_1))
-        return str;
-    else
-        return fc::shared_string("", str.get_allocator());
+    auto it = _parents.find(comment.parent_id);
+    if (it == _parents.end())
+        it = _parents.emplace(comment.parent_id, std::cref(comment_service.get(comment.parent_id))).first;
+
+    return it->second.get();
 }
 
 // Explicit template instantiation
@@ -119,6 +119,7 @@ public:
     database& _self;
     evaluator_registry<operation> _evaluator_registry;
     genesis_persistent_state_type _genesis_persistent_state;
+    block_profiler _block_profiler;
 
     betting_service_i& get_betting_service()
     {
@@ -144,6 +145,7 @@ private:
 database_impl::database_impl(database& self)
     : _self(self)
     , _evaluator_registry(self)
+    , _block_profiler([&self]() { return self.get_free_memory(); })
     // TODO: using boost::di to avoid these explicit calls
     , _betting_service(_self.account_service(),
                        static_cast<database_virtual_operations_emmiter_i&>(_self),
@@ -230,6 +232,7 @@ void database::open(const fc::path& data_dir,
             }
 
             _block_log.open(block_log_path(data_dir));
+            _block_log.set_prune_blocks(_block_log_prune_blocks);
 
             auto log_head = _block_log.head();
 
@@ -299,6 +302,10 @@ void database::reindex(const fc::path& data_dir,
         auto start = fc::time_point::now();
         SCORUM_ASSERT(_block_log.head(), block_log_exception, "No blocks in block log. Cannot reindex an empty chain.");
 
+        SCORUM_ASSERT(_block_log.first_block_num() == 1, block_log_exception,
+                      "Block log is pruned before block ${n}. Cannot reindex a pruned chain.",
+                      ("n", _block_log.first_block_num()));
+
         auto last_block_num = _block_log.head()->block_num();
         uint log_interval_sz = std::max(last_block_num / 100u, 1000u);
 
@@ -314,6 +321,11 @@ void database::reindex(const fc::path& data_dir,
                     double percent = (cur_block_num * double(100)) / last_block_num;
                     ilog("${p}% applied. ${m}M free.",
                          ("p", (boost::format("%5.2f") % percent).str())("m", get_free_memory() / (1024 * 1024)));
+
+                    if (_my->_block_profiler.is_enabled())
+                    {
+                        _my->_block_profiler.dump();
+                    }
                 }
                 apply_block(itr.first, skip_flags);
                 if (cur_block_num != last_block_num)
@@ -345,6 +357,8 @@ void database::wipe(const fc::path& data_dir, const fc::path& shared_mem_dir, bo
         fc::path block_log_file = block_log_path(data_dir);
         fc::remove_all(block_log_file);
         fc::remove_all(block_log::block_log_index_path(block_log_file));
+        fc::remove_all(block_log::block_log_ids_path(block_log_file));
+        fc::remove_all(block_log::block_log_tail_path(block_log_file));
     }
 }
 
@@ -378,7 +392,11 @@ bool database::is_known_block(const block_id_type& id) const
 {
     try
     {
-        return fetch_block_by_id(id).valid();
+        if (_fork_db.fetch_block(id))
+            return true;
+
+        auto log_id = _block_log.read_block_id_by_num(protocol::block_header::num_from_id(id));
+        return log_id.valid() && *log_id == id;
     }
     FC_CAPTURE_AND_RETHROW()
 }
@@ -420,10 +438,10 @@ block_id_type database::find_block_id_for_num(uint32_t block_num) const
         }
 
         // Next we query the block log.   Irreversible blocks are here.
-        auto b = _block_log.read_block_by_num(block_num);
-        if (b.valid())
+        auto id = _block_log.read_block_id_by_num(block_num);
+        if (id.valid())
         {
-            return b->id();
+            return *id;
         }
 
         // Finally we query the fork DB.
@@ -452,15 +470,15 @@ optional<signed_block> database::fetch_block_by_id(const block_id_type& id) cons
         auto b = _fork_db.fetch_block(id);
         if (!b)
         {
-            auto tmp = _block_log.read_block_by_num(protocol::block_header::num_from_id(id));
+            const auto block_num = protocol::block_header::num_from_id(id);
 
-            if (tmp && tmp->id() == id)
+            auto log_id = _block_log.read_block_id_by_num(block_num);
+            if (log_id.valid() && *log_id == id)
             {
-                return tmp;
+                return _block_log.read_block_by_num(block_num);
             }
 
-            tmp.reset();
-            return tmp;
+            return optional<signed_block>();
         }
 
         return b->data;
@@ -494,6 +512,44 @@ optional<signed_block> database::read_block_by_number(uint32_t block_num) const
     return _block_log.read_block_by_num(block_num);
 }
 
+optional<std::vector<char>> database::fetch_packed_block_by_id(const block_id_type& id) const
+{
+    try
+    {
+        auto b = _fork_db.fetch_block(id);
+        if (b)
+        {
+            return fc::raw::pack(b->data);
+        }
+
+        const auto block_num = protocol::block_header::num_from_id(id);
+
+        auto log_id = _block_log.read_block_id_by_num(block_num);
+        if (log_id.valid() && *log_id == id)
+        {
+            return _block_log.read_packed(block_num);
+        }
+
+        return optional<std::vector<char>>();
+    }
+    FC_CAPTURE_AND_RETHROW()
+}
+
+optional<std::vector<char>> database::fetch_packed_block_by_number(uint32_t block_num) const
+{
+    try
+    {
+        auto results = _fork_db.fetch_block_by_number(block_num);
+        if (results.size() == 1)
+        {
+            return fc::raw::pack(results[0]->data);
+        }
+
+        return _block_log.read_packed(block_num);
+    }
+    FC_LOG_AND_RETHROW()
+}
+
 const signed_transaction database::get_recent_transaction(const transaction_id_type& trx_id) const
 {
     try
@@ -575,17 +631,18 @@ bool database::push_block(const signed_block& new_block, uint32_t skip)
 {
     // fc::time_point begin_time = fc::time_point::now();
 
-    block_info ctx(new_block);
+    const block_id_type new_block_id = new_block.id();
+    block_info ctx(new_block, new_block_id);
 
     debug_log(ctx, "push_block skip=${s}", ("s", skip));
 
     bool result;
     detail::with_skip_flags(*this, skip, [&]() {
         with_write_lock([&]() {
-            detail::without_pending_transactions(*this, std::move(_pending_tx), [&]() {
+            detail::without_pending_transactions(*this, new_block, [&]() {
                 try
                 {
-                    result = _push_block(new_block);
+                    result = _push_block(new_block, new_block_id);
                     debug_log(ctx, "push_block resut=${r}", ("r", result));
                 }
                 FC_CAPTURE_AND_RETHROW(((std::string)ctx))
@@ -608,7 +665,7 @@ void database::_maybe_warn_multiple_production(uint32_t height) const
         std::vector<std::pair<account_name_type, fc::time_point_sec>> witness_time_pairs;
         for (const auto& b : blocks)
         {
-            debug_log(block_info(b->data), "block_num_collision=${n}", ("n", height));
+            debug_log(block_info(b->data, b->id), "block_num_collision=${n}", ("n", height));
             witness_time_pairs.push_back(std::make_pair(b->data.witness, b->data.timestamp));
         }
 
@@ -618,9 +675,9 @@ void database::_maybe_warn_multiple_production(uint32_t height) const
     return;
 }
 
-bool database::_push_block(const signed_block& new_block)
+bool database::_push_block(const signed_block& new_block, const block_id_type& new_block_id)
 {
-    block_info ctx(new_block);
+    block_info ctx(new_block, new_block_id);
 
     debug_log(ctx, "_push_block");
 
@@ -629,11 +686,16 @@ bool database::_push_block(const signed_block& new_block)
         uint32_t skip = get_node_properties().skip_flags;
         // uint32_t skip_undo_db = skip & skip_undo_block;
 
+        // the fork item of the new block keeps its signee and merkle root for the next apply on a fork switch
+        std::shared_ptr<fork_item> new_item;
+
         if (!(skip & skip_fork_db))
         {
-            std::shared_ptr<fork_item> new_head = _fork_db.push_block(new_block);
+            std::shared_ptr<fork_item> new_head = _fork_db.push_block(new_block, new_block_id);
+            if (new_head->id == new_block_id)
+                new_item = new_head;
 
-            debug_log(ctx, "new_head_block=${b}", ("b", (std::string)block_info(new_head->data)));
+            debug_log(ctx, "new_head_block=${b}", ("b", (std::string)block_info(new_head->data, new_head->id)));
 
             _maybe_warn_multiple_production(new_head->num);
 
@@ -645,13 +707,14 @@ bool database::_push_block(const signed_block& new_block)
 
                 // If the newly pushed block is the same height as head, we get head back in new_head
                 // Only switch forks if new_head is actually higher than head
-                if (new_head->data.block_num() > head_block_num())
+                if (new_head->num > head_block_num())
                 {
                     debug_log(ctx, "current nead block_num=${h_num}", ("h_num", head_block_num()));
-                    debug_log(ctx, "new head block number=${f_num}", ("f_num", new_head->data.block_num()));
-                    debug_log(ctx, "switching to fork with block=${b}", ("b", (std::string)block_info(new_head->data)));
+                    debug_log(ctx, "new head block number=${f_num}", ("f_num", new_head->num));
+                    debug_log(ctx, "switching to fork with block=${b}",
+                              ("b", (std::string)block_info(new_head->data, new_head->id)));
 
-                    auto branches = _fork_db.fetch_branch_from(new_head->data.id(), head_block_id());
+                    auto branches = _fork_db.fetch_branch_from(new_head->id, head_block_id());
 
                     // pop blocks until we hit the forked block
                     while (head_block_id() != branches.second.back()->data.previous)
@@ -664,13 +727,14 @@ bool database::_push_block(const signed_block& new_block)
                     for (auto ritr = branches.first.rbegin(); ritr != branches.first.rend(); ++ritr)
                     {
                         debug_log(ctx, "pushing blocks from fork block=${b}",
-                                  ("b", (std::string)block_info((*ritr)->data)));
+                                  ("b", (std::string)block_info((*ritr)->data, (*ritr)->id)));
                         optional<fc::exception> except;
                         try
                         {
                             auto session = start_undo_session();
-                            apply_block((*ritr)->data, skip);
-                            debug_log(ctx, "applied block=${b}", ("b", (std::string)block_info((*ritr)->data)));
+                            apply_block(**ritr, skip);
+                            debug_log(ctx, "applied block=${b}",
+                                      ("b", (std::string)block_info((*ritr)->data, (*ritr)->id)));
                             session->push();
                         }
                         catch (const fc::exception& e)
@@ -685,8 +749,8 @@ bool database::_push_block(const signed_block& new_block)
                             while (ritr != branches.first.rend())
                             {
                                 debug_log(ctx, "removing_block=${b} from fork",
-                                          ("b", (std::string)block_info((*ritr)->data)));
-                                _fork_db.remove((*ritr)->data.id());
+                                          ("b", (std::string)block_info((*ritr)->data, (*ritr)->id)));
+                                _fork_db.remove((*ritr)->id);
                                 ++ritr;
                             }
                             _fork_db.set_head(branches.second.front());
@@ -702,8 +766,9 @@ bool database::_push_block(const signed_block& new_block)
                             for (auto ritr = branches.second.rbegin(); ritr != branches.second.rend(); ++ritr)
                             {
                                 auto session = start_undo_session();
-                                apply_block((*ritr)->data, skip);
-                                debug_log(ctx, "applied block=${b}", ("b", (std::string)block_info((*ritr)->data)));
+                                apply_block(**ritr, skip);
+                                debug_log(ctx, "applied block=${b}",
+                                          ("b", (std::string)block_info((*ritr)->data, (*ritr)->id)));
                                 session->push();
                             }
                             throw(*except);
@@ -724,13 +789,16 @@ bool database::_push_block(const signed_block& new_block)
         try
         {
             auto session = start_undo_session();
-            apply_block(new_block, skip);
+            if (new_item)
+                apply_block(*new_item, skip);
+            else
+                apply_block(new_block, new_block_id, skip);
             session->push();
         }
         catch (const fc::exception& e)
         {
             ctx_elog(ctx, "failed to push new block exception=${e}", ("e", e.to_detail_string()));
-            _fork_db.remove(new_block.id());
+            _fork_db.remove(new_block_id);
             throw;
         }
 
@@ -773,6 +841,17 @@ void database::push_transaction(const signed_transaction& trx, uint32_t skip)
 }
 
 void database::_push_transaction(const signed_transaction& trx)
+{
+    // all transactions waiting for revalidation are applied first, so the new transaction is applied after the
+    // earlier received ones as they will be included into a block
+    _revalidate_pending_transactions(0);
+
+    _pending_tx.check_limits(trx);
+
+    _apply_pending_transaction(trx);
+}
+
+void database::_apply_pending_transaction(const signed_transaction& trx)
 {
     // If this is the first transaction pushed after applying a block, start a new undo session.
     // This allows us to quickly rewind to the clean state of the head block, in case a new block arrives.
@@ -788,7 +867,7 @@ void database::_push_transaction(const signed_transaction& trx)
 
     auto temp_session = start_undo_session();
     _apply_transaction(trx);
-    _pending_tx.push_back(trx);
+    _pending_tx.push_applied(trx);
 
     // The transaction applied successfully. Merge its changes into the pending block session.
     for_each_index([&](chainbase::abstract_generic_index_i& item) { item.squash(); });
@@ -798,6 +877,74 @@ void database::_push_transaction(const signed_transaction& trx)
     notify_on_pending_transaction(trx);
 }
 
+bool database::revalidate_pending_transactions(uint32_t max_count)
+{
+    return with_write_lock([&]() { return _revalidate_pending_transactions(max_count); });
+}
+
+bool database::_revalidate_pending_transactions(uint32_t max_count)
+{
+    auto it = _pending_tx.first_unapplied();
+    for (uint32_t n = 0; it != _pending_tx.end() && (max_count == 0 || n < max_count); ++n)
+    {
+        if (is_known_transaction(it->id))
+        {
+            it = _pending_tx.remove(it);
+            continue;
+        }
+
+        try
+        {
+            if (!_pending_tx_session.valid())
+            {
+                _pending_tx_session = start_undo_session();
+            }
+
+            auto temp_session = start_undo_session();
+            _apply_transaction(it->trx);
+
+            for_each_index([&](chainbase::abstract_generic_index_i& item) { item.squash(); });
+            temp_session->push();
+        }
+        catch (const transaction_exception& e)
+        {
+            dlog("Pending transaction became invalid after switching to block ${b} ${n} ${t}",
+                 ("b", head_block_id())("n", head_block_num())("t", head_block_time()));
+            dlog("The invalid transaction caused exception ${e}", ("e", e.to_detail_string()));
+            dlog("${t}", ("t", it->trx));
+
+            it = _pending_tx.remove(it);
+            continue;
+        }
+        catch (const fc::exception&)
+        {
+            it = _pending_tx.remove(it);
+            continue;
+        }
+
+        _pending_tx.set_applied(it);
+        notify_on_pending_transaction(it->trx);
+
+        it = _pending_tx.first_unapplied();
+    }
+
+    return it != _pending_tx.end();
+}
+
+void database::_drop_included_pending_transactions(const signed_block& block)
+{
+    _pending_tx.remove_expired(head_block_time());
+
+    // the transactions are checked to be known, as the block isn't in the chain if it failed to apply. Transactions of
+    // the other blocks applied by a fork switch are dropped by the revalidation as known ones
+    for (const auto& trx : block.transactions)
+    {
+        const transaction_id_type id = trx.id();
+        if (_pending_tx.contains(id) && is_known_transaction(id))
+            _pending_tx.remove(id);
+    }
+}
+
 signed_block database::generate_block(fc::time_point_sec when,
                                       const account_name_type& witness_owner,
                                       const fc::ecc::private_key& block_signing_private_key,
@@ -865,12 +1012,15 @@ signed_block database::_generate_block(fc::time_point_sec when,
         // re-apply pending transactions in this method.
         //
         _pending_tx_session.reset();
+        _pending_tx.reset_applied();
         _pending_tx_session = start_undo_session();
 
         uint64_t postponed_tx_count = 0;
         // pop pending state (reset to head block state)
-        for (const signed_transaction& tx : _pending_tx)
+        for (const pending_transaction& pending : _pending_tx)
         {
+            const signed_transaction& tx = pending.trx;
+
             // Only include transactions that have not expired yet for currently generating block,
             // this should clear problem transactions and allow block production to continue
 
@@ -879,7 +1029,7 @@ signed_block database::_generate_block(fc::time_point_sec when,
                 continue;
             }
 
-            uint64_t new_total_size = total_block_size + fc::raw::pack_size(tx);
+            uint64_t new_total_size = total_block_size + pending.size;
 
             // postpone transaction if it would make block too big
             if (new_total_size >= maximum_block_size)
@@ -895,7 +1045,7 @@ signed_block database::_generate_block(fc::time_point_sec when,
                 for_each_index([&](chainbase::abstract_generic_index_i& item) { item.squash(); });
                 temp_session->push();
 
-                total_block_size += fc::raw::pack_size(tx);
+                total_block_size += pending.size;
                 pending_block.transactions.push_back(tx);
             }
             catch (const fc::exception& e)
@@ -981,14 +1131,14 @@ void database::pop_block()
 
     if (_fork_db.head())
     {
-        ctx = block_info(_fork_db.head()->data);
+        ctx = block_info(_fork_db.head()->data, _fork_db.head()->id);
     }
 
     debug_log(ctx, "pop_block");
 
     try
     {
-        _pending_tx_session.reset();
+        discard_pending_state();
         auto head_id = head_block_id();
 
         /// save the head block so we can recover its transactions
@@ -1010,21 +1160,29 @@ void database::clear_pending()
 {
     try
     {
-        assert((_pending_tx.size() == 0) || _pending_tx_session.valid());
+        assert((_pending_tx.applied_count() == 0) || _pending_tx_session.valid());
         _pending_tx.clear();
         _pending_tx_session.reset();
     }
     FC_CAPTURE_AND_RETHROW()
 }
 
+void database::discard_pending_state()
+{
+    _pending_tx_session.reset();
+    _pending_tx.reset_applied();
+}
+
 void database::notify_pre_apply_operation(const operation_notification& note)
 {
-    SCORUM_TRY_NOTIFY(pre_apply_operation, note);
+    _my->_block_profiler.measure_signal_handler("pre_apply_operation",
+                                                [&]() { SCORUM_TRY_NOTIFY(pre_apply_operation, note); });
 }
 
 void database::notify_post_apply_operation(const operation_notification& note)
 {
-    SCORUM_TRY_NOTIFY(post_apply_operation, note);
+    _my->_block_profiler.measure_signal_handler("post_apply_operation",
+                                                [&]() { SCORUM_TRY_NOTIFY(post_apply_operation, note); });
 }
 
 operation_notification database::create_notification(const operation& op) const
@@ -1032,9 +1190,19 @@ operation_notification database::create_notification(const operation& op) const
     return operation_notification(_current_trx_id, _current_block_num, _current_trx_in_block, _current_op_in_trx, op);
 }
 
+bool database::is_virtual_operation_observed() const
+{
+    return (_options & opt_notify_virtual_op_applying) && has_operation_observers();
+}
+
+bool database::has_operation_observers() const
+{
+    return !pre_apply_operation.empty() || !post_apply_operation.empty();
+}
+
 inline void database::push_virtual_operation(const operation& op)
 {
-    if (_options & opt_notify_virtual_op_applying)
+    if (is_virtual_operation_observed())
     {
         FC_ASSERT(is_virtual_operation(op));
 
@@ -1054,6 +1222,9 @@ inline void database::push_hf_operation(const operation& op)
 {
     FC_ASSERT(is_virtual_operation(op));
 
+    if (!has_operation_observers())
+        return;
+
     auto note = create_notification(op);
     notify_pre_apply_operation(note);
     notify_post_apply_operation(note);
@@ -1061,27 +1232,31 @@ inline void database::push_hf_operation(const operation& op)
 
 void database::notify_pre_applied_block(const signed_block& block)
 {
-    SCORUM_TRY_NOTIFY(pre_applied_block, block)
+    _my->_block_profiler.measure_signal_handler("pre_applied_block",
+                                                [&]() { SCORUM_TRY_NOTIFY(pre_applied_block, block) });
 }
 
 void database::notify_applied_block(const signed_block& block)
 {
-    SCORUM_TRY_NOTIFY(applied_block, block)
+    _my->_block_profiler.measure_signal_handler("applied_block", [&]() { SCORUM_TRY_NOTIFY(applied_block, block) });
 }
 
 void database::notify_on_pending_transaction(const signed_transaction& tx)
 {
-    SCORUM_TRY_NOTIFY(on_pending_transaction, tx)
+    _my->_block_profiler.measure_signal_handler("on_pending_transaction",
+                                                [&]() { SCORUM_TRY_NOTIFY(on_pending_transaction, tx) });
 }
 
 void database::notify_on_pre_apply_transaction(const signed_transaction& tx)
 {
-    SCORUM_TRY_NOTIFY(on_pre_apply_transaction, tx)
+    _my->_block_profiler.measure_signal_handler("on_pre_apply_transaction",
+                                                [&]() { SCORUM_TRY_NOTIFY(on_pre_apply_transaction, tx) });
 }
 
 void database::notify_on_applied_transaction(const signed_transaction& tx)
 {
-    SCORUM_TRY_NOTIFY(on_applied_transaction, tx);
+    _my->_block_profiler.measure_signal_handler("on_applied_transaction",
+                                                [&]() { SCORUM_TRY_NOTIFY(on_applied_transaction, tx) });
 }
 
 account_name_type database::get_scheduled_witness(uint32_t slot_num) const
@@ -1237,17 +1412,9 @@ block_id_type database::head_block_id() const
 
 block_info database::head_block_context() const
 {
-    block_info ret;
-    auto b = fetch_block_by_id(head_block_id());
-    if (b.valid())
-    {
-        ret = block_info(*b);
-    }
-    else
-    {
-        ret = block_info(head_block_time(), obtain_service<dbs_dynamic_global_property>().get().current_witness);
-    }
-    return ret;
+    // don't fetch the head block (a copy from the fork database or a read from the block log) just for a log context
+    const auto& dgp = obtain_service<dbs_dynamic_global_property>().get();
+    return block_info(dgp.head_block_number, dgp.head_block_id, dgp.time, dgp.current_witness);
 }
 
 node_property_object& database::node_properties()
@@ -1260,6 +1427,12 @@ uint32_t database::last_non_undoable_block_num() const
     return obtain_service<dbs_dynamic_global_property>().get().last_irreversible_block_num;
 }
 
+uint32_t database::first_available_block_num() const
+{
+    // blocks which are not in the log yet are in the fork database
+    return std::max(_block_log.first_block_num(), 1u);
+}
+
 void database::initialize_evaluators()
 {
     _my->_evaluator_registry.register_evaluator<account_create_evaluator>();
@@ -1349,6 +1522,7 @@ void database::initialize_indexes()
     add_index<chain_property_index>();
     add_index<change_recovery_account_request_index>();
     add_index<comment_index>();
+    add_index<comment_content_index>();
     add_index<comment_statistic_scr_index>();
     add_index<comment_statistic_sp_index>();
     add_index<comment_vote_index>();
@@ -1412,6 +1586,24 @@ void database::set_flush_interval(uint32_t flush_blocks)
     _next_flush_block = 0;
 }
 
+void database::set_pending_transactions_limits(uint32_t max_count, uint64_t max_size)
+{
+    _pending_tx.set_limits(max_count, max_size);
+}
+
+void database::set_pending_revalidation_batch(uint32_t batch)
+{
+    _pending_revalidation_batch = batch;
+}
+
+void database::set_block_log_prune_blocks(uint32_t blocks)
+{
+    _block_log_prune_blocks = blocks;
+
+    if (_block_log.is_open())
+        _block_log.set_prune_blocks(blocks);
+}
+
 void database::set_validate_invariants_on_apply_block(bool validate_invariants_on_apply_block)
 {
     _validate_invariants_on_apply_block = validate_invariants_on_apply_block;
@@ -1421,7 +1613,26 @@ void database::set_validate_invariants_on_apply_block(bool validate_invariants_o
 
 void database::apply_block(const signed_block& next_block, uint32_t skip)
 {
-    block_info ctx(next_block);
+    apply_block(next_block, next_block.id(), skip);
+}
+
+void database::apply_block(const signed_block& next_block, const block_id_type& next_block_id, uint32_t skip)
+{
+    block_validation_cache validation;
+    apply_block(next_block, next_block_id, validation, skip);
+}
+
+void database::apply_block(fork_item& item, uint32_t skip)
+{
+    apply_block(item.data, item.id, item.validation, skip);
+}
+
+void database::apply_block(const signed_block& next_block,
+                           const block_id_type& next_block_id,
+                           block_validation_cache& validation,
+                           uint32_t skip)
+{
+    block_info ctx(next_block, next_block_id);
 
     debug_log(ctx, "apply_block skip=${s}", ("s", skip));
 
@@ -1434,8 +1645,8 @@ void database::apply_block(const signed_block& next_block, uint32_t skip)
         {
             auto itr = _checkpoints.find(block_num);
             if (itr != _checkpoints.end())
-                FC_ASSERT(next_block.id() == itr->second, "Block did not match checkpoint",
-                          ("checkpoint", *itr)("block_id", next_block.id()));
+                FC_ASSERT(next_block_id == itr->second, "Block did not match checkpoint",
+                          ("checkpoint", *itr)("block_id", next_block_id));
 
             if (_checkpoints.rbegin()->first >= block_num)
                 skip = skip_witness_signature | skip_transaction_signatures | skip_transaction_dupe_check | skip_fork_db
@@ -1446,7 +1657,9 @@ void database::apply_block(const signed_block& next_block, uint32_t skip)
                     | skip_undo_history_check | skip_witness_schedule_check | skip_validate | skip_validate_invariants;
         }
 
-        detail::with_skip_flags(*this, skip, [&]() { _apply_block(next_block); });
+        detail::with_skip_flags(*this, skip, [&]() {
+            _my->_block_profiler.measure_block([&]() { _apply_block(next_block, next_block_id, validation); });
+        });
 
         /// check invariants
         if (_validate_invariants_on_apply_block)
@@ -1526,9 +1739,11 @@ void database::show_free_memory(bool force)
     }
 }
 
-void database::_apply_block(const signed_block& next_block)
+void database::_apply_block(const signed_block& next_block,
+                            const block_id_type& next_block_id,
+                            block_validation_cache& validation)
 {
-    block_info ctx(next_block);
+    block_info ctx(next_block, next_block_id);
 
     debug_log(ctx, "_apply_block");
 
@@ -1537,19 +1752,18 @@ void database::_apply_block(const signed_block& next_block)
         notify_pre_applied_block(next_block);
 
         uint32_t next_block_num = next_block.block_num();
-        // block_id_type next_block_id = next_block.id();
 
         uint32_t skip = get_node_properties().skip_flags;
 
         if (!(skip & skip_merkle_check))
         {
-            auto merkle_root = next_block.calculate_merkle_root();
+            const auto& merkle_root = validation.merkle_root(next_block);
 
             try
             {
                 FC_ASSERT(next_block.transaction_merkle_root == merkle_root, "Merkle check failed",
                           ("next_block.transaction_merkle_root", next_block.transaction_merkle_root)(
-                              "calc", merkle_root)("next_block", next_block)("id", next_block.id()));
+                              "calc", merkle_root)("next_block", next_block)("id", next_block_id));
             }
             catch (fc::assert_exception& e)
             {
@@ -1567,7 +1781,7 @@ void database::_apply_block(const signed_block& next_block)
             }
         }
 
-        const witness_object& signing_witness = validate_block_header(skip, next_block);
+        const witness_object& signing_witness = validate_block_header(skip, next_block, validation);
 
         _current_block_num = next_block_num;
         _current_trx_in_block = 0;
@@ -1608,55 +1822,93 @@ void database::_apply_block(const signed_block& next_block)
             ++_current_trx_in_block;
         }
 
+        auto& profiler = _my->_block_profiler;
+
         debug_log(ctx, "update_global_dynamic_data");
-        update_global_dynamic_data(next_block);
+        profiler.measure_block_task("update_global_dynamic_data",
+                                    [&]() { update_global_dynamic_data(next_block, next_block_id); });
         debug_log(ctx, "update_signing_witness");
         update_signing_witness(signing_witness, next_block);
 
         debug_log(ctx, "update_last_irreversible_block");
-        update_last_irreversible_block();
+        profiler.measure_block_task("update_last_irreversible_block", [&]() { update_last_irreversible_block(); });
 
         debug_log(ctx, "create_block_summary");
-        create_block_summary(next_block);
+        create_block_summary(next_block, next_block_id);
         debug_log(ctx, "clear_expired_transactions");
-        clear_expired_transactions();
+        profiler.measure_block_task("clear_expired_transactions", [&]() { clear_expired_transactions(); });
         debug_log(ctx, "clear_expired_delegations");
-        clear_expired_delegations();
+        profiler.measure_block_task("clear_expired_delegations", [&]() { clear_expired_delegations(); });
 
         // in dbs_database_witness_schedule.cpp
-        update_witness_schedule();
+        profiler.measure_block_task("update_witness_schedule", [&]() { update_witness_schedule(); });
+
+        // every SP change of a voter adjusts votes of witnesses (through proxies), the block tasks pay many accounts,
+        // so their adjustments are summed up and each witness is written once. Transactions adjust votes eagerly as
+        // evaluators read the vote order (the top witness as the default recovery account).
+        detail::witness_votes_deferrer deferred_witness_votes(witness_service());
 
         database_ns::block_task_context task_ctx(static_cast<data_service_factory&>(*this),
                                                  static_cast<database_virtual_operations_emmiter_i&>(*this),
                                                  _current_block_num, ctx);
 
-        database_ns::process_funds(task_ctx).apply(task_ctx);
-        database_ns::process_fifa_world_cup_2018_bounty_initialize().apply(task_ctx);
-        database_ns::process_comments_cashout().apply(task_ctx);
-        database_ns::process_fifa_world_cup_2018_bounty_cashout().apply(task_ctx);
-        database_ns::process_vesting_withdrawals().apply(task_ctx);
-        database_ns::process_contracts_expiration().apply(task_ctx);
-        database_ns::process_account_registration_bonus_expiration().apply(task_ctx);
-        database_ns::process_witness_reward_in_sp_migration().apply(task_ctx);
-        database_ns::process_active_sp_holders_cashout().apply(task_ctx);
-        database_ns::process_games_startup(_my->get_betting_service(), *this).apply(task_ctx);
-        database_ns::process_bets_resolving(_my->get_betting_service(), _my->get_betting_resolver(), *this,
-                                            get_dba<game_object>(), get_dba<dynamic_global_property_object>())
-            .apply(task_ctx);
-        // TODO: using boost::di to avoid these explicit calls
-        database_ns::process_bets_auto_resolving(_my->get_betting_service(), *this, get_dba<game_object>(),
-                                                 get_dba<dynamic_global_property_object>())
-            .apply(task_ctx);
+        // clang-format off
+        profiler.measure_block_task("process_funds", [&]() {
+            database_ns::process_funds(task_ctx).apply(task_ctx);
+        });
+        profiler.measure_block_task("process_fifa_world_cup_2018_bounty_initialize", [&]() {
+            database_ns::process_fifa_world_cup_2018_bounty_initialize().apply(task_ctx);
+        });
+        profiler.measure_block_task("process_comments_cashout", [&]() {
+            database_ns::process_comments_cashout().apply(task_ctx);
+        });
+        profiler.measure_block_task("process_fifa_world_cup_2018_bounty_cashout", [&]() {
+            database_ns::process_fifa_world_cup_2018_bounty_cashout().apply(task_ctx);
+        });
+        profiler.measure_block_task("process_vesting_withdrawals", [&]() {
+            database_ns::process_vesting_withdrawals().apply(task_ctx);
+        });
+        profiler.measure_block_task("process_contracts_expiration", [&]() {
+            database_ns::process_contracts_expiration().apply(task_ctx);
+        });
+        profiler.measure_block_task("process_account_registration_bonus_expiration", [&]() {
+            database_ns::process_account_registration_bonus_expiration().apply(task_ctx);
+        });
+        profiler.measure_block_task("process_witness_reward_in_sp_migration", [&]() {
+            database_ns::process_witness_reward_in_sp_migration().apply(task_ctx);
+        });
+        profiler.measure_block_task("process_active_sp_holders_cashout", [&]() {
+            database_ns::process_active_sp_holders_cashout().apply(task_ctx);
+        });
+        profiler.measure_block_task("process_games_startup", [&]() {
+            database_ns::process_games_startup(_my->get_betting_service(), *this).apply(task_ctx);
+        });
+        profiler.measure_block_task("process_bets_resolving", [&]() {
+            database_ns::process_bets_resolving(_my->get_betting_service(), _my->get_betting_resolver(), *this,
+                                                get_dba<game_object>(), get_dba<dynamic_global_property_object>())
+                .apply(task_ctx);
+        });
+        profiler.measure_block_task("process_bets_auto_resolving", [&]() {
+            // TODO: using boost::di to avoid these explicit calls
+            database_ns::process_bets_auto_resolving(_my->get_betting_service(), *this, get_dba<game_object>(),
+                                                     get_dba<dynamic_global_property_object>())
+                .apply(task_ctx);
+        });
+        // clang-format on
 
         debug_log(ctx, "account_recovery_processing");
-        account_recovery_processing();
+        profiler.measure_block_task("account_recovery_processing", [&]() { account_recovery_processing(); });
         debug_log(ctx, "expire_escrow_ratification");
-        expire_escrow_ratification();
+        profiler.measure_block_task("expire_escrow_ratification", [&]() { expire_escrow_ratification(); });
         debug_log(ctx, "process_decline_voting_rights");
-        process_decline_voting_rights();
+        profiler.measure_block_task("process_decline_voting_rights", [&]() { process_decline_voting_rights(); });
 
         debug_log(ctx, "clear_expired_proposals");
-        obtain_service<dbs_proposal>().clear_expired_proposals();
+        profiler.measure_block_task("clear_expired_proposals",
+                                    [&]() { obtain_service<dbs_proposal>().clear_expired_proposals(); });
+
+        // votes are adjusted eagerly from here
+        deferred_witness_votes.finish();
 
         debug_log(ctx, "process_hardforks");
         process_hardforks();
@@ -1726,7 +1978,8 @@ void database::_apply_transaction(const signed_transaction& trx)
 {
     try
     {
-        _current_trx_id = trx.id();
+        const transaction_id_type trx_id = trx.id();
+        _current_trx_id = trx_id;
         uint32_t skip = get_node_properties().skip_flags;
 
         if (!(skip & skip_validate)) /* issue #505 explains why this skip_flag is disabled */
@@ -1735,7 +1988,6 @@ void database::_apply_transaction(const signed_transaction& trx)
         }
 
         auto& trx_idx = get_index<transaction_index>();
-        auto trx_id = trx.id();
         // idump((trx_id)(skip&skip_transaction_dupe_check));
         FC_ASSERT((skip & skip_transaction_dupe_check)
                       || trx_idx.indices().get<by_trx_id>().find(trx_id) == trx_idx.indices().get<by_trx_id>().end(),
@@ -1821,14 +2073,20 @@ void database::_apply_transaction(const signed_transaction& trx)
 
 void database::apply_operation(const operation& op)
 {
+    const bool notify = has_operation_observers();
     auto note = create_notification(op);
 
-    notify_pre_apply_operation(note);
-    _my->_evaluator_registry.get_evaluator(op).apply(op);
-    notify_post_apply_operation(note);
+    if (notify)
+        notify_pre_apply_operation(note);
+    _my->_block_profiler.measure_operation(op.which(),
+                                           [&]() { _my->_evaluator_registry.get_evaluator(op).apply(op); });
+    if (notify)
+        notify_post_apply_operation(note);
 }
 
-const witness_object& database::validate_block_header(uint32_t skip, const signed_block& next_block) const
+const witness_object& database::validate_block_header(uint32_t skip,
+                                                      const signed_block& next_block,
+                                                      block_validation_cache& validation) const
 {
     try
     {
@@ -1842,7 +2100,7 @@ const witness_object& database::validate_block_header(uint32_t skip, const signe
 
         if (!(skip & skip_witness_signature))
         {
-            FC_ASSERT(next_block.validate_signee(witness.signing_key));
+            FC_ASSERT(validation.signee(next_block) == witness.signing_key);
         }
 
         if (!(skip & skip_witness_schedule_check))
@@ -1866,17 +2124,17 @@ const witness_object& database::validate_block_header(uint32_t skip, const signe
     FC_CAPTURE_AND_RETHROW()
 }
 
-void database::create_block_summary(const signed_block& next_block)
+void database::create_block_summary(const signed_block& next_block, const block_id_type& next_block_id)
 {
     try
     {
         block_summary_id_type sid(next_block.block_num() & (uint32_t)SCORUM_BLOCKID_POOL_SIZE);
-        modify(get<block_summary_object>(sid), [&](block_summary_object& p) { p.block_id = next_block.id(); });
+        modify(get<block_summary_object>(sid), [&](block_summary_object& p) { p.block_id = next_block_id; });
     }
     FC_CAPTURE_AND_RETHROW()
 }
 
-void database::update_global_dynamic_data(const signed_block& b)
+void database::update_global_dynamic_data(const signed_block& b, const block_id_type& b_id)
 {
     try
     {
@@ -1931,7 +2189,7 @@ void database::update_global_dynamic_data(const signed_block& b)
             }
 
             dgp.head_block_number = b.block_num();
-            dgp.head_block_id = b.id();
+            dgp.head_block_id = b_id;
             dgp.time = b.timestamp;
             dgp.current_aslot += missed_blocks + 1;
         });
@@ -2034,7 +2292,7 @@ void database::update_last_irreversible_block()
                 {
                     std::shared_ptr<fork_item> block = _fork_db.fetch_block_on_main_branch_by_number(log_head_num + 1);
                     FC_ASSERT(block, "Current fork in the fork database does not contain the last_irreversible_block");
-                    _block_log.append(block->data);
+                    _block_log.append(block->data, block->id);
                     log_head_num++;
                 }
 
@@ -2082,6 +2340,16 @@ const genesis_persistent_state_type& database::genesis_persistent_state() const
     return _my->_genesis_persistent_state;
 }
 
+block_profiler& database::get_block_profiler()
+{
+    return _my->_block_profiler;
+}
+
+const block_profiler& database::get_block_profiler() const
+{
+    return _my->_block_profiler;
+}
+
 void database::init_hardforks(time_point_sec genesis_time)
 {
     _hardfork_times[0] = genesis_time;
@@ -8,6 +8,8 @@
 
 #include <scorum/protocol/config.hpp>
 
+#include <algorithm>
+
 namespace scorum {
 namespace chain {
 
@@ -47,6 +49,22 @@ printable_schedule get_witness_schedule(const witness_schedule_object& wso, witn
 
     return ret;
 }
+
+/// the role of a witness rarely changes between rounds, don't touch (and copy to undo state) the object in that case
+void set_witness_schedule(database& db, const witness_object& witness, witness_object::witness_schedule_type schedule)
+{
+    if (witness.schedule != schedule)
+        db.modify(witness, [&](witness_object& wo) { wo.schedule = schedule; });
+}
+
+/// the same as sorting 'items' and taking the middle one, but O(n)
+template <typename Compare>
+const witness_object& get_median(std::vector<const witness_object*>& items, Compare&& compare)
+{
+    auto median = items.begin() + items.size() / 2;
+    std::nth_element(items.begin(), median, items.end(), std::forward<Compare>(compare));
+    return **median;
+}
 }
 
 /**
@@ -75,9 +93,12 @@ void database::update_witness_schedule()
 
         const auto& widx = _db.get_index<witness_index>().indices().get<by_vote_name>();
 
-        for (auto itr = widx.begin(); itr != widx.end(); ++itr)
+        if (debug_trace::is_enabled())
         {
-            debug_log(ctx, "witness=${w}", ("w", *itr));
+            for (auto itr = widx.begin(); itr != widx.end(); ++itr)
+            {
+                debug_log(ctx, "witness=${w}", ("w", *itr));
+            }
         }
 
         for (auto itr = widx.begin(); itr != widx.end() && active_witnesses.size() < SCORUM_MAX_VOTED_WITNESSES; ++itr)
@@ -90,7 +111,7 @@ void database::update_witness_schedule()
             debug_log(ctx, "active=${active}", ("active", itr->owner));
 
             FC_ASSERT(active_witnesses.insert(std::make_pair(itr->id, itr->owner)).second);
-            _db.modify(*itr, [&](witness_object& wo) { wo.schedule = witness_object::top20; });
+            witness_schedule::set_witness_schedule(_db, *itr, witness_object::top20);
         }
 
         /// Add the running witnesses in the lead
@@ -113,7 +134,7 @@ void database::update_witness_schedule()
             if (active_witnesses.find(sitr->id) == active_witnesses.end())
             {
                 FC_ASSERT(active_witnesses.insert(std::make_pair(sitr->id, sitr->owner)).second);
-                _db.modify(*sitr, [&](witness_object& wo) { wo.schedule = witness_object::timeshare; });
+                witness_schedule::set_witness_schedule(_db, *sitr, witness_object::timeshare);
 
                 debug_log(ctx, "runner=${runner}", ("runner", *sitr));
             }
@@ -236,22 +257,28 @@ void database::_update_witness_median_props()
         active.push_back(&witness_service.get(wso.current_shuffled_witnesses[i]));
     }
 
-    /// sort them by account_creation_fee
-    std::sort(active.begin(), active.end(), [&](const witness_object* a, const witness_object* b) {
+    auto by_account_creation_fee = [](const witness_object* a, const witness_object* b) {
         return a->proposed_chain_props.account_creation_fee.amount < b->proposed_chain_props.account_creation_fee.amount;
-    });
-    asset median_account_creation_fee = active[active.size() / 2]->proposed_chain_props.account_creation_fee;
+    };
+    asset median_account_creation_fee
+        = witness_schedule::get_median(active, by_account_creation_fee).proposed_chain_props.account_creation_fee;
 
-    /// sort them by maximum_block_size
-    std::sort(active.begin(), active.end(), [&](const witness_object* a, const witness_object* b) {
+    auto by_maximum_block_size = [](const witness_object* a, const witness_object* b) {
         return a->proposed_chain_props.maximum_block_size < b->proposed_chain_props.maximum_block_size;
-    });
-    uint32_t median_maximum_block_size = active[active.size() / 2]->proposed_chain_props.maximum_block_size;
-
-    _db.obtain_service<dbs_dynamic_global_property>().update([&](dynamic_global_property_object& _dgpo) {
-        _dgpo.median_chain_props.account_creation_fee = median_account_creation_fee;
-        _dgpo.median_chain_props.maximum_block_size = median_maximum_block_size;
-    });
+    };
+    uint32_t median_maximum_block_size
+        = witness_schedule::get_median(active, by_maximum_block_size).proposed_chain_props.maximum_block_size;
+
+    auto& dgp_service = _db.obtain_service<dbs_dynamic_global_property>();
+    const auto& median_chain_props = dgp_service.get().median_chain_props;
+    if (median_chain_props.account_creation_fee != median_account_creation_fee
+        || median_chain_props.maximum_block_size != median_maximum_block_size)
+    {
+        dgp_service.update([&](dynamic_global_property_object& _dgpo) {
+            _dgpo.median_chain_props.account_creation_fee = median_account_creation_fee;
+            _dgpo.median_chain_props.maximum_block_size = median_maximum_block_size;
+        });
+    }
 
     // clang-format on
 }
@@ -266,7 +293,7 @@ void database::_update_witness_majority_version()
     flat_map<version, uint32_t, std::greater<version>> witness_versions;
     for (uint32_t i = 0; i < wso.num_scheduled_witnesses; i++)
     {
-        auto witness = witness_service.get(wso.current_shuffled_witnesses[i]);
+        const auto& witness = witness_service.get(wso.current_shuffled_witnesses[i]);
         if (witness_versions.find(witness.running_version) == witness_versions.end())
         {
             witness_versions[witness.running_version] = 1;
@@ -277,7 +304,8 @@ void database::_update_witness_majority_version()
         }
     }
 
-    auto majority_version = _db.obtain_service<dbs_dynamic_global_property>().get().majority_version;
+    auto& dgp_service = _db.obtain_service<dbs_dynamic_global_property>();
+    auto majority_version = dgp_service.get().majority_version;
 
     // The map should be sorted highest version to smallest, so we iterate until we hit the majority of witnesses on
     // at least this version
@@ -291,8 +319,10 @@ void database::_update_witness_majority_version()
         }
     }
 
-    _db.obtain_service<dbs_dynamic_global_property>().update(
-        [&](dynamic_global_property_object& _dgpo) { _dgpo.majority_version = majority_version; });
+    if (dgp_service.get().majority_version != majority_version)
+    {
+        dgp_service.update([&](dynamic_global_property_object& _dgpo) { _dgpo.majority_version = majority_version; });
+    }
 }
 
 void database::_update_witness_hardfork_version_votes()
@@ -306,7 +336,7 @@ void database::_update_witness_hardfork_version_votes()
 
     for (uint32_t i = 0; i < wso.num_scheduled_witnesses; i++)
     {
-        auto witness = witness_service.get(wso.current_shuffled_witnesses[i]);
+        const auto& witness = witness_service.get(wso.current_shuffled_witnesses[i]);
 
         auto version_vote = std::make_tuple(witness.hardfork_version_vote, witness.hardfork_time_vote);
         if (hardfork_version_votes.find(version_vote) == hardfork_version_votes.end())
@@ -342,8 +372,12 @@ void database::_update_witness_hardfork_version_votes()
     // We no longer have a majority
     if (hf_itr == hardfork_version_votes.end())
     {
-        _db.obtain_service<dbs_hardfork_property>().update(
-            [&](hardfork_property_object& hpo) { hpo.next_hardfork = hpo.current_hardfork_version; });
+        auto& hardfork_property_service = _db.obtain_service<dbs_hardfork_property>();
+        if (hardfork_property_service.get().next_hardfork != hardfork_property_service.get().current_hardfork_version)
+        {
+            hardfork_property_service.update(
+                [&](hardfork_property_object& hpo) { hpo.next_hardfork = hpo.current_hardfork_version; });
+        }
     }
 }
 
@@ -0,0 +1,184 @@
+#include <scorum/chain/database/debug_trace.hpp>
+
+#include <fc/exception/exception.hpp>
+#include <fc/log/logger.hpp>
+#include <fc/time.hpp>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+namespace scorum {
+namespace chain {
+
+namespace {
+
+const uint64_t trace_magic = 0x4543415254524353; // "SCRTRACE" in little endian
+
+struct trace_header
+{
+    uint64_t magic;
+    uint32_t record_size;
+    uint32_t capacity;
+    uint64_t written; ///< total number of written records, the next one goes to 'written % capacity'
+};
+
+struct trace_record
+{
+    int64_t time_us;
+    uint32_t block_num;
+    uint32_t length;
+    char text[debug_trace::record_size - sizeof(int64_t) - 2 * sizeof(uint32_t)];
+};
+
+static_assert(sizeof(trace_record) == debug_trace::record_size, "unexpected padding of trace_record");
+
+class trace_file
+{
+public:
+    trace_file(const fc::path& file, boost::interprocess::mode_t mode)
+        : _mapping(file.generic_string().c_str(), mode)
+        , _region(_mapping, mode)
+    {
+        FC_ASSERT(_region.get_size() >= sizeof(trace_header), "Invalid debug trace file ${f}", ("f", file));
+        FC_ASSERT(header().magic == trace_magic && header().record_size == debug_trace::record_size,
+                  "Invalid debug trace file ${f}", ("f", file));
+        FC_ASSERT(_region.get_size() >= sizeof(trace_header) + header().capacity * sizeof(trace_record),
+                  "Truncated debug trace file ${f}", ("f", file));
+    }
+
+    static void create(const fc::path& file, uint32_t capacity)
+    {
+        {
+            std::ofstream out(file.generic_string(), std::ios::binary | std::ios::trunc);
+
+            trace_header header = { trace_magic, debug_trace::record_size, capacity, 0 };
+            out.write((const char*)&header, sizeof(header));
+        }
+
+        fc::resize_file(file, sizeof(trace_header) + (size_t)capacity * sizeof(trace_record));
+    }
+
+    const trace_header& header() const
+    {
+        return *static_cast<const trace_header*>(_region.get_address());
+    }
+
+    const trace_record& record(uint64_t n) const
+    {
+        return records()[n % header().capacity];
+    }
+
+    void push(uint32_t block_num, const std::string& text)
+    {
+        auto& h = *static_cast<trace_header*>(_region.get_address());
+        auto& r = records()[h.written % h.capacity];
+
+        r.time_us = fc::time_point::now().time_since_epoch().count();
+        r.block_num = block_num;
+        r.length = (uint32_t)std::min(text.size(), sizeof(r.text));
+        std::memcpy(r.text, text.data(), r.length);
+
+        ++h.written;
+    }
+
+private:
+    trace_record* records() const
+    {
+        return reinterpret_cast<trace_record*>(static_cast<char*>(_region.get_address()) + sizeof(trace_header));
+    }
+
+    boost::interprocess::file_mapping _mapping;
+    boost::interprocess::mapped_region _region;
+};
+
+std::mutex trace_mutex;
+bool logger_enabled = false;
+std::unique_ptr<trace_file> trace_buffer;
+}
+
+constexpr uint32_t debug_trace::record_size;
+
+std::atomic<bool> debug_trace::_enabled{ false };
+
+void debug_trace::enable_logger(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(trace_mutex);
+
+    logger_enabled = enabled;
+    update_enabled();
+}
+
+void debug_trace::open(const fc::path& file, uint32_t capacity)
+{
+    FC_ASSERT(capacity > 0, "Debug trace capacity must be positive");
+
+    std::lock_guard<std::mutex> lock(trace_mutex);
+
+    if (fc::exists(file))
+        fc::rename(file, file.generic_string() + ".old");
+
+    trace_file::create(file, capacity);
+    trace_buffer.reset(new trace_file(file, boost::interprocess::read_write));
+    update_enabled();
+}
+
+void debug_trace::close()
+{
+    std::lock_guard<std::mutex> lock(trace_mutex);
+
+    trace_buffer.reset();
+    update_enabled();
+}
+
+void debug_trace::write(const char* file,
+                        uint32_t line,
+                        const char* method,
+                        const block_info& ctx,
+                        const char* format,
+                        const fc::variant_object& args)
+{
+    const std::string prefix = (std::string)ctx + " ";
+
+    std::lock_guard<std::mutex> lock(trace_mutex);
+
+    if (trace_buffer)
+    {
+        trace_buffer->push(ctx.block_num(), prefix + fc::format_string(format, args));
+    }
+
+    if (logger_enabled)
+    {
+        fc::logger::get("debug").log(
+            fc::log_message(fc::log_context(fc::log_level::debug, file, line, method), prefix + format, args));
+    }
+}
+
+void debug_trace::dump(const fc::path& file, std::ostream& out)
+{
+    trace_file trace(file, boost::interprocess::read_only);
+
+    const auto& header = trace.header();
+    const uint64_t first = header.written > header.capacity ? header.written - header.capacity : 0;
+
+    for (uint64_t n = first; n < header.written; ++n)
+    {
+        const auto& r = trace.record(n);
+
+        out << (std::string)fc::time_point(fc::microseconds(r.time_us)) << " " << r.block_num << " ";
+        out.write(r.text, std::min<size_t>(r.length, sizeof(r.text)));
+        out << "\n";
+    }
+}
+
+void debug_trace::update_enabled()
+{
+    _enabled.store(logger_enabled || trace_buffer, std::memory_order_relaxed);
+}
+}
+}
@@ -5,6 +5,20 @@
 namespace scorum {
 namespace chain {
 
+const fc::ecc::public_key& block_validation_cache::signee(const signed_block& b)
+{
+    if (!_signee.valid())
+        _signee = b.signee();
+    return *_signee;
+}
+
+const checksum_type& block_validation_cache::merkle_root(const signed_block& b)
+{
+    if (!_merkle_root.valid())
+        _merkle_root = b.calculate_merkle_root();
+    return *_merkle_root;
+}
+
 fork_database::fork_database()
 {
 }
@@ -22,9 +36,19 @@ void fork_database::pop_block()
     _head = prev;
 }
 
+item_ptr fork_database::create_item(signed_block b) const
+{
+    return std::allocate_shared<fork_item>(item_allocator_type(), std::move(b));
+}
+
+item_ptr fork_database::create_item(signed_block b, const block_id_type& id) const
+{
+    return std::allocate_shared<fork_item>(item_allocator_type(), std::move(b), id);
+}
+
 void fork_database::start_block(signed_block b)
 {
-    auto item = std::make_shared<fork_item>(std::move(b));
+    auto item = create_item(std::move(b));
     _index.insert(item);
     _head = item;
 }
@@ -35,15 +59,20 @@ void fork_database::start_block(signed_block b)
  */
 std::shared_ptr<fork_item> fork_database::push_block(const signed_block& b)
 {
-    auto item = std::make_shared<fork_item>(b);
+    return push_block(b, b.id());
+}
+
+std::shared_ptr<fork_item> fork_database::push_block(const signed_block& b, const block_id_type& id)
+{
+    auto item = create_item(b, id);
     try
     {
         _push_block(item);
     }
     catch (const unlinkable_block_exception&)
     {
-        wlog("Pushing block to fork database that failed to link: ${id}, ${num}", ("id", b.id())("num", b.block_num()));
-        wlog("Head: ${num}, ${id}", ("num", _head->data.block_num())("id", _head->data.id()));
+        wlog("Pushing block to fork database that failed to link: ${id}, ${num}", ("id", item->id)("num", item->num));
+        wlog("Head: ${num}, ${id}", ("num", _head->num)("id", _head->id));
         throw;
         _unlinked_index.insert(item);
     }
@@ -100,30 +129,16 @@ void fork_database::set_max_size(uint32_t s)
     if (!_head)
         return;
 
-    { /// index
-        auto& by_num_idx = _index.get<block_num>();
-        auto itr = by_num_idx.begin();
-        while (itr != by_num_idx.end())
-        {
-            if ((*itr)->num < std::max(int64_t(0), int64_t(_head->num) - _max_size))
-                by_num_idx.erase(itr);
-            else
-                break;
-            itr = by_num_idx.begin();
-        }
-    }
-    { /// unlinked_index
-        auto& by_num_idx = _unlinked_index.get<block_num>();
-        auto itr = by_num_idx.begin();
-        while (itr != by_num_idx.end())
-        {
-            if ((*itr)->num < std::max(int64_t(0), int64_t(_head->num) - _max_size))
-                by_num_idx.erase(itr);
-            else
-                break;
-            itr = by_num_idx.begin();
-        }
-    }
+    remove_old_blocks(_index);
+    remove_old_blocks(_unlinked_index);
+}
+
+template <typename Index> void fork_database::remove_old_blocks(Index& index)
+{
+    auto& by_num_idx = index.template get<block_num>();
+    auto min_num = (uint32_t)std::max(int64_t(0), int64_t(_head->num) - _max_size);
+
+    by_num_idx.erase(by_num_idx.begin(), by_num_idx.lower_bound(min_num));
 }
 
 bool fork_database::is_known_block(const block_id_type& id) const
@@ -154,17 +169,8 @@ std::vector<item_ptr> fork_database::fetch_block_by_number(uint32_t num) const
 {
     try
     {
-        std::vector<item_ptr> result;
-        auto itr = _index.get<block_num>().find(num);
-        while (itr != _index.get<block_num>().end())
-        {
-            if ((*itr)->num == num)
-                result.push_back(*itr);
-            else
-                break;
-            ++itr;
-        }
-        return result;
+        auto range = _index.get<block_num>().equal_range(num);
+        return std::vector<item_ptr>(range.first, range.second);
     }
     FC_LOG_AND_RETHROW()
 }
@@ -185,13 +191,13 @@ fork_database::fetch_branch_from(block_id_type first, block_id_type second) cons
         FC_ASSERT(second_branch_itr != _index.get<block_id>().end());
         auto second_branch = *second_branch_itr;
 
-        while (first_branch->data.block_num() > second_branch->data.block_num())
+        while (first_branch->num > second_branch->num)
         {
             result.first.push_back(first_branch);
             first_branch = first_branch->prev.lock();
             FC_ASSERT(first_branch);
         }
-        while (second_branch->data.block_num() > first_branch->data.block_num())
+        while (second_branch->num > first_branch->num)
         {
             result.second.push_back(second_branch);
             second_branch = second_branch->prev.lock();
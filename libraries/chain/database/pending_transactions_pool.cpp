@@ -0,0 +1,159 @@
+#include <scorum/chain/database/pending_transactions_pool.hpp>
+
+#include <scorum/chain/database_exceptions.hpp>
+
+#include <fc/io/raw.hpp>
+
+namespace scorum {
+namespace chain {
+
+pending_transaction::pending_transaction(const signed_transaction& t)
+    : id(t.id())
+    , expiration(t.expiration)
+    , size(fc::raw::pack_size(t))
+    , trx(t)
+{
+}
+
+void pending_transactions_pool::set_limits(uint32_t max_count, uint64_t max_size)
+{
+    _max_count = max_count;
+    _max_size = max_size;
+}
+
+void pending_transactions_pool::check_limits(const signed_transaction& trx) const
+{
+    SCORUM_ASSERT(!_max_count || _index.size() < _max_count, pending_transactions_overflow_exception,
+                  "Too many pending transactions: ${n}", ("n", _index.size()));
+    SCORUM_ASSERT(!_max_size || _packed_size + fc::raw::pack_size(trx) <= _max_size,
+                  pending_transactions_overflow_exception, "Pending transactions size limit is reached: ${s} bytes",
+                  ("s", _packed_size));
+}
+
+void pending_transactions_pool::push_applied(const signed_transaction& trx)
+{
+    auto& seq = _index.get<by_order>();
+
+    auto result = seq.insert(_first_unapplied, pending_transaction(trx));
+    FC_ASSERT(result.second, "Duplicate pending transaction ${id}", ("id", result.first->id));
+
+    result.first->applied = true;
+    _packed_size += result.first->size;
+    ++_applied_count;
+}
+
+void pending_transactions_pool::push_unapplied(const signed_transaction& trx)
+{
+    auto& seq = _index.get<by_order>();
+
+    auto result = seq.push_back(pending_transaction(trx));
+    if (!result.second)
+        return;
+
+    _packed_size += result.first->size;
+    if (_first_unapplied == seq.end())
+        _first_unapplied = result.first;
+}
+
+bool pending_transactions_pool::contains(const transaction_id_type& id) const
+{
+    return _index.get<by_id>().count(id) > 0;
+}
+
+pending_transactions_pool::iterator pending_transactions_pool::first_unapplied() const
+{
+    return _first_unapplied;
+}
+
+void pending_transactions_pool::set_applied(iterator it)
+{
+    FC_ASSERT(it == _first_unapplied, "Pending transactions must be applied in order");
+
+    it->applied = true;
+    ++_applied_count;
+    ++_first_unapplied;
+}
+
+pending_transactions_pool::iterator pending_transactions_pool::remove(iterator it)
+{
+    if (it == _first_unapplied)
+        ++_first_unapplied;
+
+    if (it->applied)
+        --_applied_count;
+    _packed_size -= it->size;
+
+    return _index.get<by_order>().erase(it);
+}
+
+bool pending_transactions_pool::remove(const transaction_id_type& id)
+{
+    const auto& idx = _index.get<by_id>();
+
+    auto it = idx.find(id);
+    if (it == idx.end())
+        return false;
+
+    remove(_index.project<by_order>(it));
+    return true;
+}
+
+size_t pending_transactions_pool::remove_expired(const fc::time_point_sec& now)
+{
+    const auto& idx = _index.get<by_expiration>();
+
+    size_t removed = 0;
+    while (!idx.empty() && idx.begin()->expiration <= now)
+    {
+        remove(_index.project<by_order>(idx.begin()));
+        ++removed;
+    }
+
+    return removed;
+}
+
+void pending_transactions_pool::reset_applied()
+{
+    for (const auto& t : _index.get<by_order>())
+        t.applied = false;
+
+    _applied_count = 0;
+    _first_unapplied = _index.get<by_order>().begin();
+}
+
+void pending_transactions_pool::clear()
+{
+    _index.clear();
+
+    _packed_size = 0;
+    _applied_count = 0;
+    _first_unapplied = _index.get<by_order>().end();
+}
+
+pending_transactions_pool::iterator pending_transactions_pool::begin() const
+{
+    return _index.get<by_order>().begin();
+}
+
+pending_transactions_pool::iterator pending_transactions_pool::end() const
+{
+    return _index.get<by_order>().end();
+}
+
+size_t pending_transactions_pool::size() const
+{
+    return _index.size();
+}
+
+uint64_t pending_transactions_pool::packed_size() const
+{
+    return _packed_size;
+}
+
+size_t pending_transactions_pool::applied_count() const
+{
+    return _applied_count;
+}
+
+} // namespace chain
+} // namespace scorum
@@ -6,6 +6,7 @@
 #include <scorum/chain/services/witness.hpp>
 #include <scorum/chain/services/witness_vote.hpp>
 #include <scorum/chain/services/comment.hpp>
+#include <scorum/chain/services/comment_content.hpp>
 #include <scorum/chain/services/comment_vote.hpp>
 #include <scorum/chain/services/registration_pool.hpp>
 #include <scorum/chain/services/registration_committee.hpp>
@@ -222,6 +223,7 @@ void delete_comment_evaluator::do_apply(const delete_comment_operation& o)
 {
     account_service_i& account_service = db().account_service();
     comment_service_i& comment_service = db().comment_service();
+    comment_content_service_i& comment_content_service = db().comment_content_service();
     comment_vote_service_i& comment_vote_service = db().comment_vote_service();
     dynamic_global_property_service_i& dprops_service = db().dynamic_global_property_service();
 
@@ -263,6 +265,7 @@ void delete_comment_evaluator::do_apply(const delete_comment_operation& o)
 #endif
     }
 
+    comment_content_service.remove(comment_content_service.get(comment.id));
     comment_service.remove(comment);
 }
 
@@ -328,6 +331,7 @@ void comment_evaluator::do_apply(const comment_operation& o)
 {
     account_service_i& account_service = db().account_service();
     comment_service_i& comment_service = db().comment_service();
+    comment_content_service_i& comment_content_service = db().comment_content_service();
     comment_statistic_scr_service_i& comment_statistic_scr_service = db().comment_statistic_scr_service();
     comment_statistic_sp_service_i& comment_statistic_sp_service = db().comment_statistic_sp_service();
     dynamic_global_property_service_i& dprops_service = db().dynamic_global_property_service();
@@ -383,6 +387,7 @@ void comment_evaluator::do_apply(const comment_operation& o)
             uint16_t pr_depth = 0;
             std::string pr_category;
             comment_id_type pr_root_comment;
+            comment_id_type pr_parent_id;
             if (parent_author != SCORUM_ROOT_POST_PARENT_ACCOUNT)
             {
                 const comment_object& parent = comment_service.get(parent_author, parent_permlink);
@@ -391,6 +396,7 @@ void comment_evaluator::do_apply(const comment_operation& o)
                 pr_depth = parent.depth;
                 pr_category = fc::to_string(parent.category);
                 pr_root_comment = parent.root_comment;
+                pr_parent_id = parent.id;
             }
 
             const comment_object& new_comment = comment_service.create([&](comment_object& com) {
@@ -408,6 +414,7 @@ void comment_evaluator::do_apply(const comment_operation& o)
                     fc::from_string(com.parent_permlink, parent_permlink);
                     fc::from_string(com.category, parent_permlink);
                     com.root_comment = com.id;
+                    com.parent_id = com.id;
                 }
                 else
                 {
@@ -416,18 +423,22 @@ void comment_evaluator::do_apply(const comment_operation& o)
                     com.depth = pr_depth + 1;
                     fc::from_string(com.category, pr_category);
                     com.root_comment = pr_root_comment;
+                    com.parent_id = pr_parent_id;
                 }
 
                 com.cashout_time = com.created + SCORUM_CASHOUT_WINDOW_SECONDS;
+            });
 
+            comment_content_service.create([&](comment_content_object& content) {
+                content.comment = new_comment.id;
 #ifndef IS_LOW_MEM
-                fc::from_string(com.title, o.title);
+                fc::from_string(content.title, o.title);
                 if (o.body.size() < 1024 * 1024 * 128)
                 {
-                    fc::from_string(com.body, o.body);
+                    fc::from_string(content.body, o.body);
                 }
 
-                fc::from_string(com.json_metadata, o.json_metadata);
+                fc::from_string(content.json_metadata, o.json_metadata);
 #endif
             });
 
@@ -450,17 +461,16 @@ void comment_evaluator::do_apply(const comment_operation& o)
             }
 #endif
             /// this loop can be skiped for validate-only nodes as it is merely gathering stats for indices
-            while (parent_author != SCORUM_ROOT_POST_PARENT_ACCOUNT)
+            for (const comment_object* comment = &new_comment; comment->depth != 0;)
             {
-                const comment_object& parent = comment_service.get(parent_author, parent_permlink);
-
-                parent_author = parent.parent_author;
-                parent_permlink = fc::to_string(parent.parent_permlink);
+                const comment_object& parent = comment_service.get(comment->parent_id);
 
                 comment_service.update(parent, [&](comment_object& p) {
                     p.children++;
                     p.active = now;
                 });
+
+                comment = &parent;
 #ifdef IS_LOW_MEM
                 break;
 #endif
@@ -485,8 +495,10 @@ void comment_evaluator::do_apply(const comment_operation& o)
                     FC_ASSERT(com.parent_author == o.parent_author, "The parent of a comment cannot be changed.");
                     FC_ASSERT(equal(com.parent_permlink, parent_permlink), "The permlink of a comment cannot change.");
                 }
+            });
 
 #ifndef IS_LOW_MEM
+            comment_content_service.update(comment_content_service.get(comment.id), [&](comment_content_object& com) {
                 if (o.title.size())
                     fc::from_string(com.title, o.title);
                 if (!o.json_metadata.empty())
@@ -524,8 +536,8 @@ void comment_evaluator::do_apply(const comment_operation& o)
                         fc::from_string(com.body, o.body);
                     }
                 }
-#endif
             });
+#endif
 
         } // end EDIT case
     }
@@ -32,8 +32,26 @@ class block_log_impl;
  * Blocks can be accessed at random via block number through the index file. Seek to 8 * (block_num - 1)
  * to find the position of the block in the main file.
  *
- * The main file is the only file that needs to persist. The index file can be reconstructed during a
+ * The ids file keeps the id of every block at the same block number order, so ids are looked up without
+ * reading and hashing blocks. Seek to sizeof(block_id_type) * (block_num - 1) to find the id of the block.
+ *
+ * +---------------+---------------+-----+------------------+
+ * | Id of Block 1 | Id of Block 2 | ... | Id of Head Block |
+ * +---------------+---------------+-----+------------------+
+ *
+ * The main file is the only file that needs to persist. The index and ids files can be reconstructed during a
  * linear scan of the main file.
+ *
+ * The main file can also be compressed (see create_compressed): the same stream of blocks and positions is split
+ * into chunks of a fixed number of blocks, every chunk is compressed independently. Positions in the index file
+ * are positions in the uncompressed stream, so both formats are read the same way. Blocks of the unfinished
+ * chunk are kept uncompressed in the tail file until the chunk is complete.
+ *
+ * A raw log can be pruned (see set_prune_blocks): blocks before the last N ones are cut off the beginning of the
+ * main file, positions of the kept blocks don't change. The index and ids files start from the first block of the
+ * main file and are cut along with it. The kept part of the files is copied by a background thread, the files are
+ * replaced by the first append after the copy is done, so the appending thread only copies the blocks appended
+ * meanwhile.
  */
 
 class block_log
@@ -42,17 +60,39 @@ public:
     block_log();
     ~block_log();
 
+    /// opens both raw and compressed logs, a new log is raw
     void open(const fc::path& file);
     void close();
     bool is_open() const;
+    bool is_compressed() const;
+
+    /// keeps only the last 'blocks' blocks in the log, 0 keeps all of them
+    void set_prune_blocks(uint32_t blocks);
+    /// waits for the started pruning and replaces the files, 'close' does it as well
+    void finish_pruning();
+    /// the first block stored in the log, 0 if the log is empty
+    uint32_t first_block_num() const;
+
+    /// creates an empty compressed log, blocks appended after 'open' are compressed by 'blocks_per_chunk'
+    static void create_compressed(const fc::path& file, uint32_t blocks_per_chunk = default_blocks_per_chunk);
 
     static fc::path block_log_index_path(const fc::path& block_log_file);
+    static fc::path block_log_ids_path(const fc::path& block_log_file);
+    static fc::path block_log_tail_path(const fc::path& block_log_file);
 
     uint64_t append(const signed_block& b);
+    /// @param id must be equal to b.id(), it is passed by callers which already computed it
+    uint64_t append(const signed_block& b, const block_id_type& id);
     void flush();
     std::pair<signed_block, uint64_t> read_block(uint64_t file_pos) const;
     optional<signed_block> read_block_by_num(uint32_t block_num) const;
 
+    /// reads the ids file only, blocks are not deserialized
+    optional<block_id_type> read_block_id_by_num(uint32_t block_num) const;
+
+    /// reads the block as it is stored, fc::raw::pack of the signed_block, without deserialization
+    optional<std::vector<char>> read_packed(uint32_t block_num) const;
+
     /**
      * Return offset of block in file, or block_log::npos if it does not exist.
      */
@@ -61,10 +101,9 @@ public:
     const optional<signed_block>& head() const;
 
     static const uint64_t npos = std::numeric_limits<uint64_t>::max();
+    static const uint32_t default_blocks_per_chunk = 1000;
 
 private:
-    void construct_index();
-
     std::unique_ptr<detail::block_log_impl> my;
 };
 }
@@ -11,6 +11,7 @@ DATA_SERVICE_FACTORY_DECLARE(
         (post_budget)
         (banner_budget)
         (comment)
+        (comment_content)
         (comment_statistic_scr)
         (comment_statistic_sp)
         (comment_vote)
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <fc/reflect/reflect.hpp>
+
+namespace scorum {
+namespace chain {
+
+struct block_profile_counter
+{
+    uint64_t calls = 0;
+    uint64_t total_time_ns = 0;
+    int64_t allocated_shared_memory = 0; ///< bytes, negative when the measured code frees shared memory
+};
+
+struct block_profile_entry
+{
+    std::string name;
+    uint64_t calls = 0;
+    uint64_t total_time_us = 0;
+    int64_t allocated_shared_memory = 0;
+};
+
+struct block_profile
+{
+    uint32_t blocks = 0;
+    uint64_t total_time_us = 0;
+
+    std::vector<block_profile_entry> block_tasks;
+    std::vector<block_profile_entry> operations;
+    std::vector<block_profile_entry> signal_handlers;
+};
+
+/**
+ * @brief Cumulative per-block instrumentation of database::_apply_block
+ *
+ * Collects wall time, call count and shared memory allocation for block tasks,
+ * operation evaluators (by operation type) and signal handlers (plugins).
+ * Disabled by default. While disabled every probe costs a single branch.
+ */
+class block_profiler
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+    using free_memory_getter_type = std::function<size_t()>;
+
+    explicit block_profiler(free_memory_getter_type free_memory_getter);
+
+    bool is_enabled() const
+    {
+        return _enabled;
+    }
+
+    void enable(bool enabled);
+    void reset();
+
+    template <typename Fn> void measure_block(Fn&& fn)
+    {
+        if (!_enabled)
+            return fn();
+
+        measure(_block, std::forward<Fn>(fn));
+        ++_blocks;
+    }
+
+    template <typename Fn> void measure_block_task(const char* name, Fn&& fn)
+    {
+        if (!_enabled)
+            return fn();
+
+        measure(get_counter(_block_tasks, name), std::forward<Fn>(fn));
+    }
+
+    template <typename Fn> void measure_operation(int op_which, Fn&& fn)
+    {
+        if (!_enabled)
+            return fn();
+
+        if (_operations.size() <= (size_t)op_which)
+            _operations.resize(op_which + 1);
+
+        measure(_operations[op_which], std::forward<Fn>(fn));
+    }
+
+    template <typename Fn> void measure_signal_handler(const char* name, Fn&& fn)
+    {
+        if (!_enabled)
+            return fn();
+
+        measure(get_counter(_signal_handlers, name), std::forward<Fn>(fn));
+    }
+
+    block_profile get_profile() const;
+
+    /// prints collected statistics to the log, the most expensive entries first
+    void dump() const;
+
+private:
+    using counters_type = std::map<std::string, block_profile_counter, std::less<>>;
+
+    template <typename Fn> void measure(block_profile_counter& counter, Fn&& fn)
+    {
+        const size_t free_memory_before = _free_memory_getter();
+        const auto start = clock_type::now();
+
+        fn();
+
+        counter.total_time_ns
+            += std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - start).count();
+        counter.allocated_shared_memory += (int64_t)free_memory_before - (int64_t)_free_memory_getter();
+        ++counter.calls;
+    }
+
+    block_profile_counter& get_counter(counters_type& counters, const char* name);
+
+    free_memory_getter_type _free_memory_getter;
+
+    bool _enabled = false;
+
+    uint32_t _blocks = 0;
+    block_profile_counter _block;
+    counters_type _block_tasks;
+    std::vector<block_profile_counter> _operations;
+    counters_type _signal_handlers;
+};
+}
+}
+
+FC_REFLECT(scorum::chain::block_profile_entry, (name)(calls)(total_time_us)(allocated_shared_memory))
+FC_REFLECT(scorum::chain::block_profile, (blocks)(total_time_us)(block_tasks)(operations)(signal_handlers))
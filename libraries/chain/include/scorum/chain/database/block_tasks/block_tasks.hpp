@@ -21,6 +21,7 @@ public:
                        block_info& block_info);
 
     virtual void push_virtual_operation(const operation& op);
+    virtual bool is_virtual_operation_observed() const;
 
     data_service_factory_i& services() const
     {
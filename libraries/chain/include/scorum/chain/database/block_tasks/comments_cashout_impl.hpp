@@ -18,6 +18,7 @@
 
 #include <scorum/rewards_math/curve.hpp>
 #include <scorum/rewards_math/formulas.hpp>
+#include <scorum/rewards_math/batch.hpp>
 
 #include <boost/range/adaptor/reversed.hpp>
 #include <map>
@@ -27,6 +28,7 @@ namespace chain {
 namespace database_ns {
 
 using scorum::rewards_math::shares_vector_type;
+using scorum::rewards_math::claims_vector_type;
 using comment_refs_type = scorum::chain::comment_service_i::comment_refs_type;
 
 class process_comments_cashout_impl
@@ -78,12 +80,12 @@ public:
 
 private:
     std::vector<asset> calculate_comments_payout(const comment_refs_type& comments,
+                                                 const claims_vector_type& claims,
                                                  const asset& reward_fund_balance,
-                                                 fc::uint128_t total_claims,
-                                                 curve_id reward_curve) const;
+                                                 fc::uint128_t total_claims) const;
 
-    fc::uint128_t
-    get_total_claims(const comment_refs_type& comments, curve_id reward_curve, fc::uint128_t recent_claims) const;
+    /// reward curve values of the comments net_rshares, they are evaluated once for both total claims and payouts
+    claims_vector_type get_claims(const comment_refs_type& comments, curve_id reward_curve) const;
 
     curators_author_rewards pay_curators(const comment_object& comment, const asset& fund_reward);
     asset pay_beneficiaries(const comment_object& comment, const asset& author_reward);
@@ -129,7 +131,8 @@ private:
 
     comment_refs_type collect_parents(const comment_refs_type& comments);
 
-    fc::shared_string get_permlink(const fc::shared_string& str) const;
+    /// parents are memoized, so deep threads paid by both reward funds in the same block are resolved once
+    const comment_object& get_parent(const comment_object& comment);
 
 private:
     block_task_context& _ctx;
@@ -141,6 +144,8 @@ private:
     comment_statistic_sp_service_i& comment_statistic_sp_service;
     comment_vote_service_i& comment_vote_service;
     hardfork_property_service_i& hardfork_service;
+
+    std::map<comment_id_type, std::reference_wrapper<const comment_object>> _parents;
 };
 }
 }
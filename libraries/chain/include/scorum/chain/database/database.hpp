@@ -7,6 +7,7 @@
 #include <scorum/chain/hardfork.hpp>
 #include <scorum/chain/node_property_object.hpp>
 #include <scorum/chain/database/fork_database.hpp>
+#include <scorum/chain/database/pending_transactions_pool.hpp>
 #include <scorum/chain/block_log.hpp>
 #include <scorum/chain/operation_notification.hpp>
 
@@ -17,6 +18,7 @@
 #include <scorum/chain/data_service_factory.hpp>
 
 #include <scorum/chain/database/database_virtual_operations.hpp>
+#include <scorum/chain/database/block_profiler.hpp>
 
 #include <scorum/chain/database/debug_log.hpp>
 #include <fc/signals.hpp>
@@ -148,6 +150,10 @@ public:
     optional<signed_block> fetch_block_by_number(uint32_t num) const;
     optional<signed_block> read_block_by_number(uint32_t num) const;
 
+    /// fc::raw::pack of the block, irreversible blocks are served from the block log without deserialization
+    optional<std::vector<char>> fetch_packed_block_by_id(const block_id_type& id) const;
+    optional<std::vector<char>> fetch_packed_block_by_number(uint32_t num) const;
+
     const signed_transaction get_recent_transaction(const transaction_id_type& trx_id) const;
     std::vector<block_id_type> get_block_ids_on_fork(block_id_type head_of_fork) const;
 
@@ -175,6 +181,25 @@ public:
 
     void _push_transaction(const signed_transaction& trx);
 
+    /// applies the transaction to the pending state and adds it to the pool without checking the pool limits
+    void _apply_pending_transaction(const signed_transaction& trx);
+
+    /**
+     * Applies up to 'max_count' pending transactions waiting for revalidation, 0 applies all of them.
+     * Transactions which no longer validate are dropped.
+     * @return true if some transactions still wait for revalidation
+     */
+    bool revalidate_pending_transactions(uint32_t max_count);
+    bool _revalidate_pending_transactions(uint32_t max_count);
+
+    /// drops the pending transactions included into the block if it's in the chain or expired without applying them
+    void _drop_included_pending_transactions(const signed_block& block);
+
+    const pending_transactions_pool& pending_transactions() const
+    {
+        return _pending_tx;
+    }
+
     signed_block generate_block(const fc::time_point_sec when,
                                 const account_name_type& witness_owner,
                                 const fc::ecc::private_key& block_signing_private_key,
@@ -183,6 +208,9 @@ public:
     void pop_block();
     void clear_pending();
 
+    /// undoes the pending state, the pending transactions are kept and wait for revalidation
+    void discard_pending_state();
+
     /**
      *  This method is used to track applied operations during the evaluation of a block, these
      *  operations should include any operation actually included in a transaction as well
@@ -197,6 +225,9 @@ public:
     inline void push_virtual_operation(const operation& op);
     inline void push_hf_operation(const operation& op);
 
+    /// virtual operations are notified only if enabled by options and somebody is connected to the operation signals
+    bool is_virtual_operation_observed() const override;
+
     void notify_pre_applied_block(const signed_block& block);
     void notify_applied_block(const signed_block& block);
     void notify_on_pending_transaction(const signed_transaction& tx);
@@ -289,6 +320,9 @@ public:
     node_property_object& node_properties();
 
     uint32_t last_non_undoable_block_num() const;
+
+    /// the oldest block the node can serve, blocks before it are pruned from the block log
+    uint32_t first_available_block_num() const;
     //////////////////// db_init.cpp ////////////////////
 
     void initialize_evaluators();
@@ -319,6 +353,16 @@ public:
     void validate_invariants() const;
 
     void set_flush_interval(uint32_t flush_blocks);
+    /// bounds the pending transactions by number and packed size, 0 for no limit
+    void set_pending_transactions_limits(uint32_t max_count, uint64_t max_size);
+    /// the number of pending transactions revalidated while pushing a block, 0 revalidates all of them
+    void set_pending_revalidation_batch(uint32_t batch);
+    uint32_t pending_revalidation_batch() const
+    {
+        return _pending_revalidation_batch;
+    }
+    /// keeps only the last 'blocks' irreversible blocks in the block log, 0 keeps all of them
+    void set_block_log_prune_blocks(uint32_t blocks);
     void show_free_memory(bool force);
     void set_validate_invariants_on_apply_block(bool validate_invariants_on_apply_block);
 
@@ -331,6 +375,9 @@ public:
 
     const genesis_persistent_state_type& genesis_persistent_state() const;
 
+    block_profiler& get_block_profiler();
+    const block_profiler& get_block_profiler() const;
+
 private:
     // witness_schedule
     void update_witness_schedule();
@@ -340,7 +387,9 @@ private:
     void _update_witness_hardfork_version_votes();
 
     void _maybe_warn_multiple_production(uint32_t height) const;
-    bool _push_block(const signed_block& b);
+    bool _push_block(const signed_block& b, const block_id_type& id);
+
+    bool has_operation_observers() const;
 
     signed_block _generate_block(const fc::time_point_sec when,
                                  const account_name_type& witness_owner,
@@ -353,18 +402,30 @@ protected:
     }
 
     void apply_block(const signed_block& next_block, uint32_t skip = skip_nothing);
+    /// the block id is computed once per block and passed down the apply pipeline
+    void apply_block(const signed_block& next_block, const block_id_type& next_block_id, uint32_t skip);
+    /// the signee and the merkle root are kept in the fork item for the next apply of the block
+    void apply_block(fork_item& item, uint32_t skip);
+    void apply_block(const signed_block& next_block,
+                     const block_id_type& next_block_id,
+                     block_validation_cache& validation,
+                     uint32_t skip);
     void apply_transaction(const signed_transaction& trx, uint32_t skip = skip_nothing);
-    void _apply_block(const signed_block& next_block);
+    void _apply_block(const signed_block& next_block,
+                      const block_id_type& next_block_id,
+                      block_validation_cache& validation);
     void _apply_transaction(const signed_transaction& trx);
     void apply_operation(const operation& op);
 
     /// Steps involved in applying a new block
     ///@{
 
-    const witness_object& validate_block_header(uint32_t skip, const signed_block& next_block) const;
-    void create_block_summary(const signed_block& next_block);
+    const witness_object& validate_block_header(uint32_t skip,
+                                                const signed_block& next_block,
+                                                block_validation_cache& validation) const;
+    void create_block_summary(const signed_block& next_block, const block_id_type& next_block_id);
 
-    void update_global_dynamic_data(const signed_block& b);
+    void update_global_dynamic_data(const signed_block& b, const block_id_type& b_id);
     void update_signing_witness(const witness_object& signing_witness, const signed_block& new_block);
     void update_last_irreversible_block();
     void clear_expired_transactions();
@@ -384,7 +445,8 @@ private:
 
     optional<chainbase::abstract_undo_session_ptr> _pending_tx_session;
 
-    std::vector<signed_transaction> _pending_tx;
+    pending_transactions_pool _pending_tx;
+    uint32_t _pending_revalidation_batch = 0;
     fork_database _fork_db;
     fc::time_point_sec _hardfork_times[SCORUM_NUM_HARDFORKS + 1];
     protocol::hardfork_version _hardfork_versions[SCORUM_NUM_HARDFORKS + 1];
@@ -405,6 +467,8 @@ private:
     uint32_t _flush_blocks = 0;
     uint32_t _next_flush_block = 0;
 
+    uint32_t _block_log_prune_blocks = 0;
+
     uint32_t _last_free_gb_printed = 0;
 
     fc::time_point_sec _const_genesis_time; // should be const
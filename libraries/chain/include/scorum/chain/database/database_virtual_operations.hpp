@@ -11,6 +11,14 @@ using scorum::protocol::operation;
 struct database_virtual_operations_emmiter_i
 {
     virtual void push_virtual_operation(const operation& op) = 0;
+
+    /// Returns false when pushed virtual operations are dropped (nobody listens to them),
+    /// emitters may skip building expensive operations in that case
+    virtual bool is_virtual_operation_observed() const
+    {
+        return true;
+    }
+
     virtual ~database_virtual_operations_emmiter_i() = default;
 };
 }
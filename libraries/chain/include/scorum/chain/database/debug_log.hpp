@@ -1,3 +1,14 @@
 #pragma once
 
-#define debug_log(CTX, FORMAT, ...) fc_ctx_dlog(fc::logger::get("debug"), CTX, FORMAT, __VA_ARGS__)
+#include <scorum/chain/database/debug_trace.hpp>
+
+#include <boost/config.hpp>
+
+// CTX and arguments are evaluated only when the trace is enabled
+#define debug_log(CTX, FORMAT, ...)                                                                                    \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (BOOST_UNLIKELY(scorum::chain::debug_trace::is_enabled()))                                                  \
+            scorum::chain::debug_trace::write(__FILE__, __LINE__, __func__, CTX, FORMAT,                               \
+                                              fc::mutable_variant_object() __VA_ARGS__);                               \
+    } while (false)
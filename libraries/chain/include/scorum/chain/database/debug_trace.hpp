@@ -0,0 +1,58 @@
+#pragma once
+
+#include <scorum/protocol/block.hpp>
+
+#include <fc/filesystem.hpp>
+#include <fc/variant_object.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+
+namespace scorum {
+namespace chain {
+
+/**
+ * @brief Sink of the 'debug_log' records (consensus debugging)
+ *
+ * Records go to the "debug" fc logger and/or to a binary ring buffer of fixed size records in a memory mapped file.
+ * The file survives a crash of the node and is printed with 'dump'.
+ * Disabled by default. While disabled every 'debug_log' call site costs a single branch, neither contexts nor
+ * messages are built.
+ */
+class debug_trace
+{
+public:
+    static constexpr uint32_t record_size = 256;
+
+    /// the flag is switched from the API thread and read on every call site, a relaxed load is enough as the
+    /// records themselves are written under the lock
+    static bool is_enabled()
+    {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+
+    /// forwards records to the "debug" fc logger
+    static void enable_logger(bool enabled);
+
+    /// keeps last 'capacity' records in 'file', the file of the previous run is moved to 'file'.old
+    static void open(const fc::path& file, uint32_t capacity);
+    static void close();
+
+    static void write(const char* file,
+                      uint32_t line,
+                      const char* method,
+                      const block_info& ctx,
+                      const char* format,
+                      const fc::variant_object& args);
+
+    /// prints records of the ring buffer 'file', the oldest first
+    static void dump(const fc::path& file, std::ostream& out);
+
+private:
+    static void update_enabled();
+
+    static std::atomic<bool> _enabled;
+};
+}
+}
@@ -6,6 +6,7 @@
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/mem_fun.hpp>
+#include <boost/pool/pool_alloc.hpp>
 
 namespace scorum {
 namespace chain {
@@ -14,6 +15,23 @@ using namespace boost::multi_index;
 
 using scorum::protocol::signed_block;
 using scorum::protocol::block_id_type;
+using scorum::protocol::block_header;
+using scorum::protocol::checksum_type;
+
+/**
+ * Values of the block data that are checked every time the block is applied. A block of a fork item can be applied
+ * several times on fork switches, so they are computed on the first apply only.
+ */
+class block_validation_cache
+{
+public:
+    const fc::ecc::public_key& signee(const signed_block& b);
+    const checksum_type& merkle_root(const signed_block& b);
+
+private:
+    fc::optional<fc::ecc::public_key> _signee;
+    fc::optional<checksum_type> _merkle_root;
+};
 
 struct fork_item
 {
@@ -24,6 +42,13 @@ struct fork_item
     {
     }
 
+    fork_item(signed_block d, const block_id_type& d_id)
+        : num(block_header::num_from_id(d_id))
+        , id(d_id)
+        , data(std::move(d))
+    {
+    }
+
     block_id_type previous_id() const
     {
         return data.previous;
@@ -38,6 +63,7 @@ struct fork_item
     bool invalid = false;
     block_id_type id;
     signed_block data;
+    block_validation_cache validation;
 };
 typedef std::shared_ptr<fork_item> item_ptr;
 
@@ -72,6 +98,8 @@ public:
      *  @return the new head block ( the longest fork )
      */
     std::shared_ptr<fork_item> push_block(const signed_block& b);
+    /// @param id must be equal to b.id(), it is passed by callers which already computed it
+    std::shared_ptr<fork_item> push_block(const signed_block& b, const block_id_type& id);
     std::shared_ptr<fork_item> head() const
     {
         return _head;
@@ -102,17 +130,34 @@ public:
                                                                 member<fork_item, uint32_t, &fork_item::num>>>>
         fork_multi_index_type;
 
+    /// linked blocks are never searched by previous id, so the index is not maintained for them
+    typedef multi_index_container<item_ptr,
+                                  indexed_by<hashed_unique<tag<block_id>,
+                                                           member<fork_item, block_id_type, &fork_item::id>,
+                                                           std::hash<fc::ripemd160>>,
+                                             ordered_non_unique<tag<block_num>,
+                                                                member<fork_item, uint32_t, &fork_item::num>>>>
+        fork_linked_index_type;
+
     void set_max_size(uint32_t s);
 
 private:
+    /// fork items (and their shared_ptr control blocks) are recycled through a pool, blocks come and go constantly
+    using item_allocator_type = boost::fast_pool_allocator<fork_item>;
+
+    item_ptr create_item(signed_block b) const;
+    item_ptr create_item(signed_block b, const block_id_type& id) const;
+
     /** @return a pointer to the newly pushed item */
     void _push_block(const item_ptr& b);
     void _push_next(const item_ptr& newly_inserted);
 
+    template <typename Index> void remove_old_blocks(Index& index);
+
     uint32_t _max_size = 1024;
 
     fork_multi_index_type _unlinked_index;
-    fork_multi_index_type _index;
+    fork_linked_index_type _index;
     std::shared_ptr<fork_item> _head;
 };
 
@@ -0,0 +1,114 @@
+#pragma once
+#include <scorum/protocol/transaction.hpp>
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+
+namespace scorum {
+namespace chain {
+using boost::multi_index_container;
+using namespace boost::multi_index;
+
+using scorum::protocol::signed_transaction;
+using scorum::protocol::transaction_id_type;
+
+struct pending_transaction
+{
+    explicit pending_transaction(const signed_transaction& t);
+
+    transaction_id_type id;
+    fc::time_point_sec expiration;
+    uint32_t size;
+
+    /// the transaction is applied to the pending state, otherwise it waits for revalidation
+    mutable bool applied = false;
+
+    signed_transaction trx;
+};
+
+/**
+ *  Transactions waiting to be included into a block, in the order they were received.
+ *
+ *  The applied transactions are always the head of the queue: the pending state is the head block state with them
+ *  applied in order. After a block is pushed the pending state is rebuilt, transactions included into the block or
+ *  expired are dropped by the ids of the block transactions and by expiration without being applied, the rest wait
+ *  for revalidation.
+ *
+ *  The pool is bounded by the number of transactions and their packed size, 0 means no limit. Only new transactions
+ *  are checked, transactions of popped blocks are restored even if the pool is full.
+ */
+class pending_transactions_pool
+{
+public:
+    struct by_id;
+    struct by_expiration;
+    struct by_order;
+
+    typedef multi_index_container<pending_transaction,
+                                  indexed_by<sequenced<tag<by_order>>,
+                                             hashed_unique<tag<by_id>,
+                                                           member<pending_transaction,
+                                                                  transaction_id_type,
+                                                                  &pending_transaction::id>,
+                                                           std::hash<fc::ripemd160>>,
+                                             ordered_non_unique<tag<by_expiration>,
+                                                                member<pending_transaction,
+                                                                       fc::time_point_sec,
+                                                                       &pending_transaction::expiration>>>>
+        pending_transactions_index_type;
+
+    using iterator = pending_transactions_index_type::index<by_order>::type::const_iterator;
+
+    void set_limits(uint32_t max_count, uint64_t max_size);
+
+    /// @throw pending_transactions_overflow_exception if the transaction doesn't fit into the limits
+    void check_limits(const signed_transaction& trx) const;
+
+    /// adds the transaction applied to the pending state, it goes after the rest of the applied ones
+    void push_applied(const signed_transaction& trx);
+
+    /// adds the transaction waiting for revalidation to the end of the queue, duplicates are ignored
+    void push_unapplied(const signed_transaction& trx);
+
+    bool contains(const transaction_id_type& id) const;
+
+    /// the first transaction waiting for revalidation or end()
+    iterator first_unapplied() const;
+
+    void set_applied(iterator it);
+    iterator remove(iterator it);
+
+    /// drops the transaction if it's in the pool
+    bool remove(const transaction_id_type& id);
+
+    /// drops the transactions expired by 'now'
+    size_t remove_expired(const fc::time_point_sec& now);
+
+    /// marks all transactions as waiting for revalidation, it's used when the pending state is discarded
+    void reset_applied();
+
+    void clear();
+
+    iterator begin() const;
+    iterator end() const;
+
+    size_t size() const;
+    uint64_t packed_size() const;
+    size_t applied_count() const;
+
+private:
+    pending_transactions_index_type _index;
+    iterator _first_unapplied = _index.get<by_order>().end();
+
+    uint32_t _max_count = 0;
+    uint64_t _max_size = 0;
+
+    uint64_t _packed_size = 0;
+    size_t _applied_count = 0;
+};
+
+} // namespace chain
+} // namespace scorum
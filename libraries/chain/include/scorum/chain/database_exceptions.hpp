@@ -86,6 +86,10 @@ FC_DECLARE_DERIVED_EXCEPTION(transaction_tapos_exception,
                              scorum::chain::transaction_exception,
                              4030200,
                              "transaction tapos exception")
+FC_DECLARE_DERIVED_EXCEPTION(pending_transactions_overflow_exception,
+                             scorum::chain::transaction_exception,
+                             4030300,
+                             "pending transactions overflow exception")
 
 FC_DECLARE_DERIVED_EXCEPTION(pop_empty_chain,
                              scorum::chain::undo_database_exception,
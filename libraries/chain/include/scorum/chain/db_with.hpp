@@ -1,6 +1,7 @@
 #pragma once
 
 #include <scorum/chain/database/database.hpp>
+#include <scorum/chain/services/witness.hpp>
 
 /*
  * This file provides with() functions which modify the database
@@ -40,6 +41,39 @@ struct skip_flags_restorer
     uint32_t _old_skip_flags; // initialized in ctor
 };
 
+/**
+ * Defers witness vote adjustments until finish() flushes them. Votes are
+ * dropped only if finish() wasn't reached, it happens when applying the
+ * block failed and its changes are being undone anyway.
+ */
+struct witness_votes_deferrer
+{
+    witness_votes_deferrer(witness_service_i& witness_service)
+        : _witness_service(witness_service)
+    {
+        _witness_service.defer_witness_votes(true);
+    }
+
+    void finish()
+    {
+        _witness_service.flush_witness_votes();
+        _witness_service.defer_witness_votes(false);
+        _finished = true;
+    }
+
+    ~witness_votes_deferrer()
+    {
+        if (_finished)
+            return;
+
+        _witness_service.drop_witness_votes();
+        _witness_service.defer_witness_votes(false);
+    }
+
+    witness_service_i& _witness_service;
+    bool _finished = false;
+};
+
 /**
  * Class used to help the without_pending_transactions
  * implementation.
@@ -49,15 +83,18 @@ struct skip_flags_restorer
  */
 struct pending_transactions_restorer
 {
-    pending_transactions_restorer(database& db, std::vector<signed_transaction>&& pending_transactions)
+    pending_transactions_restorer(database& db, const signed_block& new_block)
         : _db(db)
-        , _pending_transactions(std::move(pending_transactions))
+        , _new_block(new_block)
     {
-        _db.clear_pending();
+        _db.discard_pending_state();
     }
 
     ~pending_transactions_restorer()
     {
+        // popped transactions were received before the pending ones, they go first. They bypass the pool limits: they
+        // are bounded by the size of the popped blocks and dropping them would lose transactions which were already
+        // in the chain
         for (const auto& tx : _db._popped_tx)
         {
             try
@@ -66,7 +103,7 @@ struct pending_transactions_restorer
                 {
                     // since push_transaction() takes a signed_transaction,
                     // the operation_results field will be ignored.
-                    _db._push_transaction(tx);
+                    _db._apply_pending_transaction(tx);
                 }
             }
             catch (const fc::exception&)
@@ -74,39 +111,15 @@ struct pending_transactions_restorer
             }
         }
         _db._popped_tx.clear();
-        for (const signed_transaction& tx : _pending_transactions)
-        {
-            try
-            {
-                if (!_db.is_known_transaction(tx.id()))
-                {
-                    // since push_transaction() takes a signed_transaction,
-                    // the operation_results field will be ignored.
-                    _db._push_transaction(tx);
-                }
-            }
-            catch (const transaction_exception& e)
-            {
-                dlog("Pending transaction became invalid after switching to block ${b} ${n} ${t}",
-                     ("b", _db.head_block_id())("n", _db.head_block_num())("t", _db.head_block_time()));
-                dlog("The invalid transaction caused exception ${e}", ("e", e.to_detail_string()));
-                dlog("${t}", ("t", tx));
-            }
-            catch (const fc::exception& e)
-            {
 
-                /*
-                dlog( "Pending transaction became invalid after switching to block ${b} ${n} ${t}",
-                   ("b", _db.head_block_id())("n", _db.head_block_num())("t", _db.head_block_time()) );
-                dlog( "The invalid pending transaction caused exception ${e}", ("e", e.to_detail_string() ) );
-                dlog( "${t}", ("t", tx) );
-                */
-            }
-        }
+        // the transactions included into the block are dropped without being applied,
+        // the rest are revalidated in batches
+        _db._drop_included_pending_transactions(_new_block);
+        _db._revalidate_pending_transactions(_db.pending_revalidation_batch());
     }
 
     database& _db;
-    std::vector<signed_transaction> _pending_transactions;
+    const signed_block& _new_block;
 };
 
 /**
@@ -124,15 +137,16 @@ template <typename Lambda> void with_skip_flags(database& db, uint32_t skip_flag
 }
 
 /**
- * Empty pending_transactions, call callback,
- * then reset pending_transactions after callback is done.
+ * Discard the pending state, call callback,
+ * then restore the pending state after callback is done.
  *
- * Pending transactions which no longer validate will be culled.
+ * Pending transactions which no longer validate will be culled,
+ * the ones included into new_block are dropped.
  */
 template <typename Lambda>
-void without_pending_transactions(database& db, std::vector<signed_transaction>&& pending_transactions, Lambda callback)
+void without_pending_transactions(database& db, const signed_block& new_block, Lambda callback)
 {
-    pending_transactions_restorer restorer(db, std::move(pending_transactions));
+    pending_transactions_restorer restorer(db, new_block);
     callback();
     return;
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include <boost/container/flat_map.hpp>
 #include <boost/any.hpp>
+#include <boost/type_index.hpp>
 
 #include <scorum/chain/dba/dba.hpp>
 
@@ -2,6 +2,7 @@
 
 #include <fc/shared_string.hpp>
 #include <fc/shared_buffer.hpp>
+#include <fc/crypto/city.hpp>
 
 #include <scorum/protocol/authority.hpp>
 #include <scorum/protocol/scorum_operations.hpp>
@@ -10,6 +11,8 @@
 #include <scorum/chain/schema/witness_objects.hpp>
 
 #include <boost/multi_index/composite_key.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/utility/string_ref.hpp>
 
 #include <limits>
 
@@ -19,12 +22,31 @@ namespace chain {
 using scorum::protocol::beneficiary_route_type;
 using scorum::protocol::vote_weight_type;
 
+/// the key of the by_permlink_hash index, different (author, permlink) pairs can have the same hash
+inline uint64_t comment_permlink_hash(const account_name_type& author, const boost::string_ref& permlink)
+{
+    // the name is hashed as its fixed size storage, so nothing is allocated; the two hashes are combined as
+    // Hash128to64 of CityHash does
+    const uint64_t author_hash = fc::city_hash64(reinterpret_cast<const char*>(&author.data), sizeof(author.data));
+    const uint64_t permlink_hash = fc::city_hash64(permlink.data(), permlink.size());
+
+    const uint64_t k_mul = 0x9ddfea08eb382d69ULL;
+    uint64_t a = (permlink_hash ^ author_hash) * k_mul;
+    a ^= (a >> 47);
+    uint64_t b = (author_hash ^ a) * k_mul;
+    b ^= (b >> 47);
+    return b * k_mul;
+}
+
+/**
+ * Accounting part of a comment, it is modified by every vote and payout. The content is kept in
+ * comment_content_object, so these modifications don't copy it.
+ */
 class comment_object : public object<comment_object_type, comment_object>
 {
 public:
     /// \cond DO_NOT_DOCUMENT
-    CHAINBASE_DEFAULT_DYNAMIC_CONSTRUCTOR(
-        comment_object, (category)(parent_permlink)(permlink)(title)(body)(json_metadata)(beneficiaries))
+    CHAINBASE_DEFAULT_DYNAMIC_CONSTRUCTOR(comment_object, (category)(parent_permlink)(permlink)(beneficiaries))
 
     id_type id;
 
@@ -34,9 +56,6 @@ public:
     account_name_type author;
     fc::shared_string permlink;
 
-    fc::shared_string title;
-    fc::shared_string body;
-    fc::shared_string json_metadata;
     time_point_sec last_update;
     time_point_sec created;
 
@@ -75,6 +94,9 @@ public:
 
     id_type root_comment;
 
+    /// resolved (parent_author, parent_permlink), equals to id for root posts
+    id_type parent_id;
+
     /// SCR value of the maximum payout this post will receive
     asset max_accepted_payout = asset::maximum(SCORUM_SYMBOL);
 
@@ -92,6 +114,49 @@ public:
     bool rewarded = false;
 };
 
+/// computes comment_permlink_hash for the by_permlink_hash index, so it isn't stored in the object
+struct comment_permlink_hash_key
+{
+    typedef uint64_t result_type;
+
+    result_type operator()(const comment_object& c) const
+    {
+        return comment_permlink_hash(c.author, boost::string_ref(c.permlink.data(), c.permlink.size()));
+    }
+};
+
+/// the comment of 'author' and 'permlink' among [first, last) comments with the same comment_permlink_hash, the hash
+/// can collide, so the key is compared
+template <typename Iterator>
+const comment_object* find_comment_by_permlink(Iterator first,
+                                               Iterator last,
+                                               const account_name_type& author,
+                                               const boost::string_ref& permlink)
+{
+    for (auto it = first; it != last; ++it)
+    {
+        if (it->author == author && boost::string_ref(it->permlink.data(), it->permlink.size()) == permlink)
+            return &(*it);
+    }
+
+    return nullptr;
+}
+
+/// content of a comment, it is modified by comment edits only
+class comment_content_object : public object<comment_content_object_type, comment_content_object>
+{
+public:
+    CHAINBASE_DEFAULT_DYNAMIC_CONSTRUCTOR(comment_content_object, (title)(body)(json_metadata))
+
+    id_type id;
+
+    comment_id_type comment;
+
+    fc::shared_string title;
+    fc::shared_string body;
+    fc::shared_string json_metadata;
+};
+
 /**
  * This index maintains the set of voter/comment pairs that have been used, voters cannot
  * vote on the same comment more than once per payout period.
@@ -160,6 +225,7 @@ using comment_statistic_sp_object = comment_statistic_object<comment_statistic_s
 struct by_created;
 struct by_cashout_time;
 struct by_permlink;
+struct by_permlink_hash;
 struct by_root;
 struct by_parent;
 struct by_last_update;
@@ -198,6 +264,7 @@ typedef shared_multi_index_container<comment_object,
                                                                              &comment_object::permlink>>,
                                                         composite_key_compare<std::less<account_name_type>,
                                                                               fc::strcmp_less>>,
+                                         hashed_non_unique<tag<by_permlink_hash>, comment_permlink_hash_key>,
                                          ordered_unique<tag<by_root>,
                                                         composite_key<comment_object,
                                                                       member<comment_object,
@@ -329,6 +396,17 @@ using comment_statistic_index
                                                                     comment_id_type,
                                                                     &CommentStatisticObjectType::comment>>>>;
 
+typedef shared_multi_index_container<comment_content_object,
+                                     indexed_by<ordered_unique<tag<by_id>,
+                                                               member<comment_content_object,
+                                                                      comment_content_id_type,
+                                                                      &comment_content_object::id>>,
+                                                ordered_unique<tag<by_comment_id>,
+                                                               member<comment_content_object,
+                                                                      comment_id_type,
+                                                                      &comment_content_object::comment>>>>
+    comment_content_index;
+
 using comment_statistic_scr_index = comment_statistic_index<comment_statistic_scr_object>;
 using comment_statistic_sp_index = comment_statistic_index<comment_statistic_sp_object>;
 
@@ -344,9 +422,6 @@ FC_REFLECT( scorum::chain::comment_object,
             (category)
             (parent_author)
             (parent_permlink)
-            (title)
-            (body)
-            (json_metadata)
             (last_update)
             (created)
             (active)
@@ -361,6 +436,7 @@ FC_REFLECT( scorum::chain::comment_object,
             (total_vote_weight)
             (net_votes)
             (root_comment)
+            (parent_id)
             (max_accepted_payout)
             (allow_replies)
             (allow_votes)
@@ -370,6 +446,15 @@ FC_REFLECT( scorum::chain::comment_object,
           )
 CHAINBASE_SET_INDEX_TYPE( scorum::chain::comment_object, scorum::chain::comment_index )
 
+FC_REFLECT( scorum::chain::comment_content_object,
+            (id)
+            (comment)
+            (title)
+            (body)
+            (json_metadata)
+          )
+CHAINBASE_SET_INDEX_TYPE( scorum::chain::comment_content_object, scorum::chain::comment_content_index )
+
 FC_REFLECT( scorum::chain::comment_vote_object,
             (id)
             (voter)
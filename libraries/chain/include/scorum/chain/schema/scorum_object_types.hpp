@@ -88,7 +88,8 @@ enum object_type
     bet_uuid_history_object_type,
     game_uuid_history_object_type,
     nft_object_type,
-    game_round_object_type
+    game_round_object_type,
+    comment_content_object_type
 };
 
 using account_authority_id_type = oid<account_authority_object>;
@@ -103,6 +104,7 @@ using chain_property_id_type = oid<chain_property_object>;
 using change_recovery_account_request_id_type = oid<change_recovery_account_request_object>;
 using account_registration_bonus_id_type = oid<account_registration_bonus_object>;
 using comment_id_type = oid<comment_object>;
+using comment_content_id_type = oid<comment_content_object>;
 using comments_bounty_fund_id_type = oid<comments_bounty_fund_object>;
 using comment_vote_id_type = oid<comment_vote_object>;
 using decline_voting_rights_request_id_type = oid<decline_voting_rights_request_object>;
@@ -204,7 +206,8 @@ FC_REFLECT_ENUM(scorum::chain::object_type,
                 (bet_uuid_history_object_type)
                 (game_uuid_history_object_type)
                 (nft_object_type)
-                (game_round_object_type))
+                (game_round_object_type)
+                (comment_content_object_type))
 
 FC_REFLECT_ENUM( scorum::chain::bandwidth_type, (post)(forum)(market) )
 
@@ -14,6 +14,7 @@ class chain_property_object;
 class change_recovery_account_request_object;
 class account_registration_bonus_object;
 class comment_object;
+class comment_content_object;
 class comments_bounty_fund_object;
 class comment_vote_object;
 class decline_voting_rights_request_object;
@@ -3,6 +3,8 @@
 #include <scorum/chain/services/service_base.hpp>
 #include <scorum/chain/schema/comment_objects.hpp>
 
+#include <boost/utility/string_ref.hpp>
+
 namespace scorum {
 namespace chain {
 
@@ -14,6 +16,9 @@ struct comment_service_i : public base_service_i<comment_object>
     virtual const comment_object& get(const comment_id_type& comment_id) const = 0;
     virtual const comment_object& get(const account_name_type& author, const std::string& permlink) const = 0;
 
+    /// looks the comment up by the permlink hash, returns nullptr if there is no such comment
+    virtual const comment_object* find(const account_name_type& author, const boost::string_ref& permlink) const = 0;
+
     using comment_refs_type = std::vector<typename base_service_i::object_cref_type>;
 
     virtual comment_refs_type get_by_cashout_time(const fc::time_point_sec& until) const = 0;
@@ -44,6 +49,8 @@ public:
     const comment_object& get(const comment_id_type& comment_id) const override;
     const comment_object& get(const account_name_type& author, const std::string& permlink) const override;
 
+    const comment_object* find(const account_name_type& author, const boost::string_ref& permlink) const override;
+
     comment_refs_type get_by_cashout_time(const fc::time_point_sec& until) const override;
 
     comment_refs_type get_by_create_time(const fc::time_point_sec& until, const checker_type&) const override;
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <scorum/chain/services/service_base.hpp>
+#include <scorum/chain/schema/comment_objects.hpp>
+
+namespace scorum {
+namespace chain {
+
+struct comment_content_service_i : public base_service_i<comment_content_object>
+{
+    using base_service_i<comment_content_object>::get;
+
+    virtual const comment_content_object& get(const comment_id_type& comment_id) const = 0;
+};
+
+class dbs_comment_content : public dbs_service_base<comment_content_service_i>
+{
+    friend class dbservice_dbs_factory;
+
+protected:
+    explicit dbs_comment_content(database& db);
+
+public:
+    using base_service_i<comment_content_object>::get;
+
+    const comment_content_object& get(const comment_id_type& comment_id) const override;
+};
+} // namespace chain
+} // namespace scorum
@@ -3,6 +3,8 @@
 #include <scorum/chain/services/service_base.hpp>
 #include <scorum/chain/schema/witness_objects.hpp>
 
+#include <boost/container/flat_map.hpp>
+
 namespace scorum {
 namespace protocol {
 struct chain_properties;
@@ -49,6 +51,16 @@ struct witness_service_i : public base_service_i<witness_object>
 
     /** this is called by `adjust_proxied_witness_votes` when account proxy to self */
     virtual void adjust_witness_votes(const account_object& account, const share_type& delta) = 0;
+
+    /**
+     * While deferred, `adjust_witness_vote` only sums deltas per witness and `flush_witness_votes` applies them. The
+     * result is the same as of eager adjustments while witness_schedule_object::current_virtual_time doesn't change
+     * and nothing reads the votes (get_top_witness, the schedule). Deltas have to be flushed or dropped before turning
+     * it off.
+     */
+    virtual void defer_witness_votes(bool deferred) = 0;
+    virtual void flush_witness_votes() = 0;
+    virtual void drop_witness_votes() = 0;
 };
 
 class dbs_witness : public dbs_service_base<witness_service_i>
@@ -89,13 +101,21 @@ public:
     /** this is called by `adjust_proxied_witness_votes` when account proxy to self */
     void adjust_witness_votes(const account_object& account, const share_type& delta) override;
 
+    void defer_witness_votes(bool deferred) override;
+    void flush_witness_votes() override;
+    void drop_witness_votes() override;
+
 private:
     const witness_object& create_internal(const account_name_type& owner, const public_key_type& block_signing_key);
+    void apply_witness_vote(const witness_object& witness, const share_type& delta);
     block_info get_head_block_context();
 
     dynamic_global_property_service_i& _dgp_svc;
     witness_schedule_service_i& _witness_schedule_svc;
     dba::db_accessor<chain_property_object>& _chain_dba;
+
+    bool _votes_deferred = false;
+    boost::container::flat_map<witness_id_type, share_type> _deferred_votes;
 };
 } // namespace chain
 } // namespace scorum
@@ -2,7 +2,6 @@
 
 #include <vector>
 #include <functional>
-#include <boost/type_index.hpp>
 #include <fc/log/logger.hpp>
 
 namespace scorum {
@@ -63,8 +62,6 @@ public:
             r.apply(ctx);
         }
 
-        auto impl = boost::typeindex::type_id_runtime(*this).pretty_name();
-
         on_apply(ctx);
 
         for (task& r : _before)
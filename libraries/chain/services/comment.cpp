@@ -29,11 +29,21 @@ const comment_object& dbs_comment::get(const account_name_type& author, const st
 {
     try
     {
-        return get_by<by_permlink>(boost::make_tuple(author, permlink));
+        const comment_object* comment = find(author, permlink);
+        FC_ASSERT(comment != nullptr, "Comment doesn't exist.");
+        return *comment;
     }
     FC_CAPTURE_AND_RETHROW((author)(permlink))
 }
 
+const comment_object* dbs_comment::find(const account_name_type& author, const boost::string_ref& permlink) const
+{
+    const auto& idx = db_impl().get_index<comment_index>().indices().get<by_permlink_hash>();
+
+    auto range = idx.equal_range(comment_permlink_hash(author, permlink));
+    return find_comment_by_permlink(range.first, range.second, author, permlink);
+}
+
 dbs_comment::comment_refs_type dbs_comment::get_by_cashout_time(const fc::time_point_sec& until) const
 {
     try
@@ -57,7 +67,7 @@ dbs_comment::comment_refs_type dbs_comment::get_by_create_time(const fc::time_po
 
 bool dbs_comment::is_exists(const account_name_type& author, const std::string& permlink) const
 {
-    return find_by<by_permlink>(std::make_tuple(author, permlink)) != nullptr;
+    return find(author, permlink) != nullptr;
 }
 
 comment_service_i::comment_refs_type dbs_comment::get_children(const account_name_type& parent_author,
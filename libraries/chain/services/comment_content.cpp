@@ -0,0 +1,22 @@
+#include <scorum/chain/services/comment_content.hpp>
+#include <scorum/chain/database/database.hpp>
+
+namespace scorum {
+namespace chain {
+
+dbs_comment_content::dbs_comment_content(database& db)
+    : base_service_type(db)
+{
+}
+
+const comment_content_object& dbs_comment_content::get(const comment_id_type& comment_id) const
+{
+    try
+    {
+        return get_by<by_comment_id>(comment_id);
+    }
+    FC_CAPTURE_AND_RETHROW((comment_id))
+}
+
+} // namespace chain
+} // namespace scorum
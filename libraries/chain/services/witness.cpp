@@ -108,20 +108,59 @@ void dbs_witness::adjust_witness_votes(const account_object& account, const shar
 
 void dbs_witness::adjust_witness_vote(const witness_object& witness, const share_type& delta)
 {
-    block_info ctx = get_head_block_context();
+    if (_votes_deferred)
+    {
+        auto& deferred_delta = _deferred_votes[witness.id];
+        deferred_delta += delta;
+
+        // the votes are checked on every adjustment as the eager path does
+        const auto& props = _dgp_svc.get();
+        FC_ASSERT(witness.votes + deferred_delta <= props.total_scorumpower.amount, "",
+                  ("w.votes", witness.votes + deferred_delta)("props", props.total_scorumpower));
+        return;
+    }
+
+    apply_witness_vote(witness, delta);
+}
+
+void dbs_witness::defer_witness_votes(bool deferred)
+{
+    FC_ASSERT(_deferred_votes.empty(), "Deferred witness votes are not flushed.");
+
+    _votes_deferred = deferred;
+}
+
+void dbs_witness::drop_witness_votes()
+{
+    _deferred_votes.clear();
+}
 
+void dbs_witness::flush_witness_votes()
+{
+    decltype(_deferred_votes) votes;
+    votes.swap(_deferred_votes);
+
+    // a witness is updated even if its deltas sum to zero, as the eager path would do
+    for (const auto& vote : votes)
+    {
+        apply_witness_vote(db_impl().get(vote.first), vote.second);
+    }
+}
+
+void dbs_witness::apply_witness_vote(const witness_object& witness, const share_type& delta)
+{
     const auto& props = _dgp_svc.get();
     const auto& wso = _witness_schedule_svc.get();
 
     update(witness, [&](witness_object& w) {
-        debug_log(ctx, "updating votes for witness=${w}", ("w", w.owner));
+        debug_log(get_head_block_context(), "updating votes for witness=${w}", ("w", w.owner));
 
         auto delta_pos = w.votes.value * (wso.current_virtual_time - w.virtual_last_update);
         w.virtual_position += delta_pos;
 
         w.virtual_last_update = wso.current_virtual_time;
 
-        debug_log(ctx, "old_votes=${v}", ("v", w.votes));
+        debug_log(get_head_block_context(), "old_votes=${v}", ("v", w.votes));
 
         w.votes += delta;
         FC_ASSERT(w.votes <= props.total_scorumpower.amount, "",
@@ -135,14 +174,14 @@ void dbs_witness::adjust_witness_vote(const witness_object& witness, const share
         if (w.virtual_scheduled_time < wso.current_virtual_time)
             w.virtual_scheduled_time = fc::uint128::max_value();
 
-        debug_log(ctx, "new_votes=${v}", ("v", w.votes));
+        debug_log(get_head_block_context(), "new_votes=${v}", ("v", w.votes));
     });
 }
 
 block_info dbs_witness::get_head_block_context()
 {
     const auto& dprop = _dgp_svc.get();
-    block_info ctx(dprop.head_block_number, dprop.head_block_id.str(), dprop.time, dprop.current_witness);
+    block_info ctx(dprop.head_block_number, dprop.head_block_id, dprop.time, dprop.current_witness);
 
     return ctx;
 }
@@ -46,7 +46,8 @@ class database_guard
 protected:
     read_write_mutex_manager* _rw_manager = nullptr;
 
-    int32_t _read_lock_count = 0;
+    // read locks are taken by RPC worker threads concurrently
+    std::atomic<int32_t> _read_lock_count{ 0 };
     int32_t _write_lock_count = 0;
     bool _enable_require_locking = false;
 
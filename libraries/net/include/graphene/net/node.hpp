@@ -169,6 +169,9 @@ public:
 
     virtual item_hash_t get_head_block_id() const = 0;
 
+    /** returns the oldest block we can send to peers, the older ones are pruned */
+    virtual uint32_t get_first_available_block_number() const = 0;
+
     virtual uint32_t estimate_last_known_fork_from_git_revision_timestamp(uint32_t unix_timestamp) const = 0;
 
     virtual void error_encountered(const std::string& message, const fc::oexception& error) = 0;
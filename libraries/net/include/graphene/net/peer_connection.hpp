@@ -282,6 +282,9 @@ public:
 
     uint32_t last_known_fork_block_number;
 
+    /// blocks below this one are pruned from the peer's block log, 0 if the peer didn't tell
+    uint32_t first_available_block_number;
+
     fc::future<void> accept_or_connect_task_done;
 
     firewall_check_state_data* firewall_check_state;
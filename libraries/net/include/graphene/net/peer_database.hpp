@@ -32,6 +32,8 @@
 #include <fc/exception/exception.hpp>
 #include <fc/io/raw.hpp>
 
+#include <functional>
+
 namespace graphene {
 namespace net {
 
@@ -95,6 +97,10 @@ private:
 };
 }
 
+/**
+ *  Potential peers are kept in a binary file: a snapshot of all records followed by a journal of the updates made
+ *  since. Every update is appended to the journal, the file is rewritten when the journal grows too big and on close.
+ */
 class peer_database
 {
 public:
@@ -111,6 +117,19 @@ public:
     potential_peer_record lookup_or_create_entry_for_endpoint(const fc::ip::endpoint& endpointToLookup);
     fc::optional<potential_peer_record> lookup_entry_for_endpoint(const fc::ip::endpoint& endpointToLookup);
 
+    /**
+     *  Returns up to 'max_count' peers worth connecting to, the best first: the peers we were connected to, then the
+     *  new ones, then the failed ones with fewer failures. Peers seen more recently go first within a group.
+     *  A failed peer is retried when (number_of_failed_connection_attempts + 1) * 'retry_timeout' seconds have passed
+     *  since the last attempt. Peers the 'skip' callback returns true for aren't returned.
+     */
+    std::vector<potential_peer_record>
+    get_connection_candidates(size_t max_count,
+                              const fc::time_point& now,
+                              uint32_t retry_timeout,
+                              const std::function<bool(const fc::ip::endpoint&)>& skip) const;
+
+    /// iterates peers from the least recently seen
     typedef detail::peer_database_iterator iterator;
     iterator begin() const;
     iterator end() const;
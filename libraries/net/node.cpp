@@ -312,6 +312,7 @@ private:
                                    (get_block_number) \
                                    (get_block_time) \
                                    (get_head_block_id) \
+                                   (get_first_available_block_number) \
                                    (estimate_last_known_fork_from_git_revision_timestamp) \
                                    (error_encountered)
 // clang-format on
@@ -418,6 +419,7 @@ public:
     fc::time_point_sec get_block_time(const item_hash_t& block_id) override;
     fc::time_point_sec get_blockchain_now() override;
     item_hash_t get_head_block_id() const override;
+    uint32_t get_first_available_block_number() const override;
     uint32_t estimate_last_known_fork_from_git_revision_timestamp(uint32_t unix_timestamp) const override;
     void error_encountered(const std::string& message, const fc::oexception& error) override;
 };
@@ -434,7 +436,8 @@ public:
     fc::sha256 _chain_id;
 
 #define NODE_CONFIGURATION_FILENAME "node_config.json"
-#define POTENTIAL_PEER_DATABASE_FILENAME "peers.json"
+#define POTENTIAL_PEER_DATABASE_FILENAME "peers.dat"
+#define LEGACY_POTENTIAL_PEER_DATABASE_FILENAME "peers.json"
     fc::path _node_configuration_directory;
     node_configuration _node_configuration;
 
@@ -984,21 +987,20 @@ void node_impl::p2p_network_connect_loop()
                 bool initiated_connection_this_pass = false;
                 _potential_peer_database_updated = false;
 
-                for (peer_database::iterator iter = _potential_peer_db.begin();
-                     iter != _potential_peer_db.end() && is_wanting_new_connections(); ++iter)
+                // the best peers go first, the scan stops as soon as there are enough of them
+                const auto candidates = _potential_peer_db.get_connection_candidates(
+                    _desired_number_of_connections - get_number_of_connections(), fc::time_point::now(),
+                    _peer_connection_retry_timeout, [this](const fc::ip::endpoint& endpoint) {
+                        return is_connection_to_endpoint_in_progress(endpoint);
+                    });
+
+                for (const potential_peer_record& candidate : candidates)
                 {
-                    fc::microseconds delay_until_retry = fc::seconds((iter->number_of_failed_connection_attempts + 1)
-                                                                     * _peer_connection_retry_timeout);
-
-                    if (!is_connection_to_endpoint_in_progress(iter->endpoint)
-                        && ((iter->last_connection_disposition != last_connection_failed
-                             && iter->last_connection_disposition != last_connection_rejected
-                             && iter->last_connection_disposition != last_connection_handshaking_failed)
-                            || (fc::time_point::now() - iter->last_connection_attempt_time) > delay_until_retry))
-                    {
-                        connect_to_endpoint(iter->endpoint);
-                        initiated_connection_this_pass = true;
-                    }
+                    if (!is_wanting_new_connections())
+                        break;
+
+                    connect_to_endpoint(candidate.endpoint);
+                    initiated_connection_this_pass = true;
                 }
 
                 if (!initiated_connection_this_pass && !_potential_peer_database_updated)
@@ -2036,6 +2038,7 @@ fc::variant_object node_impl::generate_hello_user_data()
         user_data["last_known_fork_block_number"] = _hard_fork_block_numbers.back();
 
     user_data["chain_id"] = _chain_id;
+    user_data["first_available_block_number"] = _delegate->get_first_available_block_number();
 
     return user_data;
 }
@@ -2064,6 +2067,8 @@ void node_impl::parse_hello_user_data_for_peer(peer_connection* originating_peer
         originating_peer->last_known_fork_block_number = user_data["last_known_fork_block_number"].as<uint32_t>();
     if (user_data.contains("chain_id"))
         originating_peer->chain_id = user_data["chain_id"].as<scorum::protocol::chain_id_type>();
+    if (user_data.contains("first_available_block_number"))
+        originating_peer->first_available_block_number = user_data["first_available_block_number"].as<uint32_t>();
 }
 
 void node_impl::on_hello_message(peer_connection* originating_peer, const hello_message& hello_message_received)
@@ -3063,6 +3068,25 @@ void node_impl::on_item_not_available_message(peer_connection* originating_peer,
     {
         originating_peer->sync_items_requested_from_peer.erase(sync_item_iter);
 
+        // the peer told us its first available block in hello, it has pruned its block log since then
+        if (requested_item.item_type == block_message_type && originating_peer->first_available_block_number > 0
+            && !originating_peer->peer_needs_sync_items_from_us)
+        {
+            const uint32_t block_num = _delegate->get_block_number(requested_item.item_hash);
+            originating_peer->first_available_block_number
+                = std::max(originating_peer->first_available_block_number, block_num + 1);
+
+            wlog("Peer ${peer} has pruned block ${n}, not syncing with it",
+                 ("peer", originating_peer->get_remote_endpoint())("n", block_num));
+
+            _active_sync_requests.erase(requested_item.item_hash);
+            originating_peer->ids_of_items_to_get.clear();
+            originating_peer->number_of_unfetched_item_ids = 0;
+            originating_peer->we_need_sync_items_from_peer = false;
+            trigger_fetch_sync_items_loop();
+            return;
+        }
+
         if (originating_peer->peer_needs_sync_items_from_us)
             originating_peer->inhibit_fetching_sync_blocks = true;
         else
@@ -4237,6 +4261,17 @@ void node_impl::start_synchronizing_with_peer(const peer_connection_ptr& peer)
     VERIFY_CORRECT_THREAD();
     peer->ids_of_items_to_get.clear();
     peer->number_of_unfetched_item_ids = 0;
+
+    // a peer with a pruned block log can't send us the blocks we are missing
+    const uint32_t head_block_num = _delegate->get_block_number(_delegate->get_head_block_id());
+    if (peer->first_available_block_number > head_block_num + 1)
+    {
+        dlog("Not syncing with peer ${peer}, its block log starts from ${n} and our head block is ${head}",
+             ("peer", peer->get_remote_endpoint())("n", peer->first_available_block_number)("head", head_block_num));
+        peer->we_need_sync_items_from_peer = false;
+        return;
+    }
+
     peer->we_need_sync_items_from_peer = true;
     peer->last_block_delegate_has_seen = item_hash_t();
     peer->last_block_time_delegate_has_seen = _delegate->get_block_time(item_hash_t());
@@ -4808,6 +4843,11 @@ void node_impl::load_configuration(const fc::path& configuration_directory)
     fc::path potential_peer_database_file_name(_node_configuration_directory / POTENTIAL_PEER_DATABASE_FILENAME);
     try
     {
+        // the binary database reads the json one, it's converted on open
+        fc::path legacy_file_name(_node_configuration_directory / LEGACY_POTENTIAL_PEER_DATABASE_FILENAME);
+        if (!fc::exists(potential_peer_database_file_name) && fc::exists(legacy_file_name))
+            fc::rename(legacy_file_name, potential_peer_database_file_name);
+
         _potential_peer_db.open(potential_peer_database_file_name);
 
         // push back the time on all peers loaded from the database so we will be able to retry them immediately
@@ -5918,6 +5958,11 @@ item_hash_t statistics_gathering_node_delegate_wrapper::get_head_block_id() cons
     INVOKE_AND_COLLECT_STATISTICS(get_head_block_id);
 }
 
+uint32_t statistics_gathering_node_delegate_wrapper::get_first_available_block_number() const
+{
+    INVOKE_AND_COLLECT_STATISTICS(get_first_available_block_number);
+}
+
 uint32_t statistics_gathering_node_delegate_wrapper::estimate_last_known_fork_from_git_revision_timestamp(
     uint32_t unix_timestamp) const
 {
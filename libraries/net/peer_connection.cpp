@@ -90,6 +90,7 @@ peer_connection::peer_connection(peer_connection_delegate* delegate)
     , inhibit_fetching_sync_blocks(false)
     , transaction_fetching_inhibited_until(fc::time_point::min())
     , last_known_fork_block_number(0)
+    , first_available_block_number(0)
     , firewall_check_state(nullptr)
     ,
 #ifndef NDEBUG
@@ -26,20 +26,58 @@
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index/mem_fun.hpp>
+#include <boost/multi_index/composite_key.hpp>
 #include <boost/multi_index/tag.hpp>
 
 #include <fc/io/raw.hpp>
 #include <fc/io/raw_variant.hpp>
 #include <fc/log/logger.hpp>
 #include <fc/io/json.hpp>
+#include <fc/filesystem.hpp>
 
 #include <graphene/net/peer_database.hpp>
 
+#include <fstream>
+
+#define MAXIMUM_PEERDB_SIZE 1000
+
+#define PEER_DATABASE_MAGIC 0x52454550 // "PEER"
+#define PEER_DATABASE_VERSION 1
+
+// the file is rewritten when the journal has this many records more than the database
+#define PEER_DATABASE_MAX_JOURNAL_OVERHEAD 10000
+
 namespace graphene {
 namespace net {
 namespace detail {
 using namespace boost::multi_index;
 
+/// the lower rank, the better candidate to connect to
+struct connection_rank
+{
+    typedef uint8_t result_type;
+
+    enum : result_type
+    {
+        succeeded = 0,
+        never_attempted,
+        failed
+    };
+
+    result_type operator()(const potential_peer_record& record) const
+    {
+        switch (record.last_connection_disposition)
+        {
+        case last_connection_succeeded:
+            return succeeded;
+        case never_attempted_to_connect:
+            return never_attempted;
+        default:
+            return failed;
+        }
+    }
+};
+
 class peer_database_impl
 {
 public:
@@ -49,22 +87,54 @@ public:
     struct endpoint_index
     {
     };
-    typedef boost::multi_index_container<potential_peer_record,
-                                         indexed_by<ordered_non_unique<tag<last_seen_time_index>,
-                                                                       member<potential_peer_record,
-                                                                              fc::time_point_sec,
-                                                                              &potential_peer_record::last_seen_time>>,
-                                                    hashed_unique<tag<endpoint_index>,
-                                                                  member<potential_peer_record,
-                                                                         fc::ip::endpoint,
-                                                                         &potential_peer_record::endpoint>,
-                                                                  std::hash<fc::ip::endpoint>>>>
+    struct connection_rank_index
+    {
+    };
+    typedef boost::multi_index_container<
+        potential_peer_record,
+        indexed_by<ordered_non_unique<tag<last_seen_time_index>,
+                                      member<potential_peer_record,
+                                             fc::time_point_sec,
+                                             &potential_peer_record::last_seen_time>>,
+                   hashed_unique<tag<endpoint_index>,
+                                 member<potential_peer_record, fc::ip::endpoint, &potential_peer_record::endpoint>,
+                                 std::hash<fc::ip::endpoint>>,
+                   ordered_non_unique<tag<connection_rank_index>,
+                                      composite_key<potential_peer_record,
+                                                    connection_rank,
+                                                    member<potential_peer_record,
+                                                           uint32_t,
+                                                           &potential_peer_record::
+                                                               number_of_failed_connection_attempts>,
+                                                    member<potential_peer_record,
+                                                           fc::time_point_sec,
+                                                           &potential_peer_record::last_seen_time>>,
+                                      composite_key_compare<std::less<uint8_t>,
+                                                            std::less<uint32_t>,
+                                                            std::greater<fc::time_point_sec>>>>>
         potential_peer_set;
 
+    enum journal_operation : uint8_t
+    {
+        journal_update = 0,
+        journal_erase = 1
+    };
+
 private:
     potential_peer_set _potential_peer_set;
     fc::path _peer_database_filename;
 
+    std::ofstream _journal;
+    size_t _journal_records = 0;
+
+    void load();
+    bool load_binary(const std::vector<char>& data);
+    void load_json();
+
+    void append(journal_operation op, const potential_peer_record& record);
+    void rewrite();
+    void save();
+
 public:
     void open(const fc::path& databaseFilename);
     void close();
@@ -74,6 +144,12 @@ public:
     potential_peer_record lookup_or_create_entry_for_endpoint(const fc::ip::endpoint& endpointToLookup);
     fc::optional<potential_peer_record> lookup_entry_for_endpoint(const fc::ip::endpoint& endpointToLookup);
 
+    std::vector<potential_peer_record>
+    get_connection_candidates(size_t max_count,
+                              const fc::time_point& now,
+                              uint32_t retry_timeout,
+                              const std::function<bool(const fc::ip::endpoint&)>& skip) const;
+
     peer_database::iterator begin() const;
     peer_database::iterator end() const;
     size_t size() const;
@@ -92,54 +168,188 @@ public:
 };
 peer_database_iterator::peer_database_iterator(const peer_database_iterator& c)
     : boost::iterator_facade<peer_database_iterator, const potential_peer_record, boost::forward_traversal_tag>(c)
+    , my(c.my ? new peer_database_iterator_impl(*c.my) : nullptr)
 {
 }
 
 void peer_database_impl::open(const fc::path& peer_database_filename)
 {
     _peer_database_filename = peer_database_filename;
+    _potential_peer_set.clear();
+
     if (fc::exists(_peer_database_filename))
     {
         try
         {
-            std::vector<potential_peer_record> peer_records
-                = fc::json::from_file(_peer_database_filename).as<std::vector<potential_peer_record>>();
-            std::copy(peer_records.begin(), peer_records.end(),
-                      std::inserter(_potential_peer_set, _potential_peer_set.end()));
-#define MAXIMUM_PEERDB_SIZE 1000
+            load();
+
             if (_potential_peer_set.size() > MAXIMUM_PEERDB_SIZE)
             {
-                // prune database to a reasonable size
-                auto iter = _potential_peer_set.begin();
-                std::advance(iter, MAXIMUM_PEERDB_SIZE);
-                _potential_peer_set.erase(iter, _potential_peer_set.end());
+                // prune database to a reasonable size, the least recently seen peers go first
+                auto& idx = _potential_peer_set.get<last_seen_time_index>();
+                auto iter = idx.begin();
+                std::advance(iter, _potential_peer_set.size() - MAXIMUM_PEERDB_SIZE);
+                idx.erase(idx.begin(), iter);
             }
         }
         catch (const fc::exception&)
         {
             elog("error opening peer database file ${peer_database_filename}, starting with a clean database",
                  ("peer_database_filename", _peer_database_filename));
+            _potential_peer_set.clear();
         }
     }
+
+    // the journal starts from a compact snapshot
+    save();
 }
 
-void peer_database_impl::close()
+void peer_database_impl::load()
+{
+    std::vector<char> data(fc::file_size(_peer_database_filename));
+    {
+        std::ifstream in(_peer_database_filename.generic_string().c_str(), std::ios::in | std::ios::binary);
+        in.read(data.data(), data.size());
+        FC_ASSERT(in.good(), "Can't read ${f}", ("f", _peer_database_filename));
+    }
+
+    if (!load_binary(data))
+        load_json();
+}
+
+bool peer_database_impl::load_binary(const std::vector<char>& data)
+{
+    fc::datastream<const char*> ds(data.data(), data.size());
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    if (data.size() < sizeof(magic) + sizeof(version))
+        return false;
+
+    fc::raw::unpack(ds, magic);
+    if (magic != PEER_DATABASE_MAGIC)
+        return false;
+
+    fc::raw::unpack(ds, version);
+    FC_ASSERT(version == PEER_DATABASE_VERSION, "Unsupported peer database version ${v}", ("v", version));
+
+    auto& idx = _potential_peer_set.get<endpoint_index>();
+    while (ds.remaining())
+    {
+        uint8_t op = journal_update;
+        potential_peer_record record;
+        try
+        {
+            fc::raw::unpack(ds, op);
+            fc::raw::unpack(ds, record);
+        }
+        catch (const fc::exception&)
+        {
+            // the last record could be cut by a crash, the file is rewritten after load
+            wlog("peer database ${peer_database_filename} has a broken record at the end, dropping it",
+                 ("peer_database_filename", _peer_database_filename));
+            break;
+        }
+
+        auto iter = idx.find(record.endpoint);
+        if (op == journal_erase)
+        {
+            if (iter != idx.end())
+                idx.erase(iter);
+        }
+        else if (iter != idx.end())
+            idx.replace(iter, record);
+        else
+            idx.insert(record);
+    }
+
+    return true;
+}
+
+void peer_database_impl::load_json()
+{
+    ilog("converting peer database ${peer_database_filename} from json",
+         ("peer_database_filename", _peer_database_filename));
+
+    std::vector<potential_peer_record> peer_records
+        = fc::json::from_file(_peer_database_filename).as<std::vector<potential_peer_record>>();
+    std::copy(peer_records.begin(), peer_records.end(), std::inserter(_potential_peer_set, _potential_peer_set.end()));
+}
+
+void peer_database_impl::rewrite()
 {
-    std::vector<potential_peer_record> peer_records;
-    peer_records.reserve(_potential_peer_set.size());
-    std::copy(_potential_peer_set.begin(), _potential_peer_set.end(), std::back_inserter(peer_records));
+    if (_journal.is_open())
+        _journal.close();
+
+    fc::path peer_database_filename_dir = _peer_database_filename.parent_path();
+    if (!fc::exists(peer_database_filename_dir))
+        fc::create_directories(peer_database_filename_dir);
+
+    const fc::path tmp_file = _peer_database_filename.generic_string() + ".tmp";
+    {
+        std::ofstream out(tmp_file.generic_string().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+        fc::raw::pack(out, uint32_t(PEER_DATABASE_MAGIC));
+        fc::raw::pack(out, uint32_t(PEER_DATABASE_VERSION));
+        for (const auto& record : _potential_peer_set)
+        {
+            fc::raw::pack(out, uint8_t(journal_update));
+            fc::raw::pack(out, record);
+        }
 
+        out.flush();
+        FC_ASSERT(out.good(), "Can't write ${f}", ("f", tmp_file));
+    }
+
+    fc::rename(tmp_file, _peer_database_filename);
+
+    _journal.open(_peer_database_filename.generic_string().c_str(), std::ios::out | std::ios::binary | std::ios::app);
+    _journal_records = _potential_peer_set.size();
+}
+
+void peer_database_impl::save()
+{
     try
     {
-        fc::path peer_database_filename_dir = _peer_database_filename.parent_path();
-        if (!fc::exists(peer_database_filename_dir))
-            fc::create_directories(peer_database_filename_dir);
-        fc::json::save_to_file(peer_records, _peer_database_filename);
+        rewrite();
     }
     catch (const fc::exception& e)
+    {
+        elog("error saving peer database to file ${peer_database_filename}: ${e}",
+             ("peer_database_filename", _peer_database_filename)("e", e.to_detail_string()));
+    }
+}
+
+void peer_database_impl::append(journal_operation op, const potential_peer_record& record)
+{
+    if (!_journal.is_open())
+        return;
+
+    if (_journal_records >= _potential_peer_set.size() + PEER_DATABASE_MAX_JOURNAL_OVERHEAD)
+    {
+        save();
+        return;
+    }
+
+    fc::raw::pack(_journal, uint8_t(op));
+    fc::raw::pack(_journal, record);
+    _journal.flush();
+    ++_journal_records;
+
+    if (!_journal.good())
     {
         elog("error saving peer database to file ${peer_database_filename}",
              ("peer_database_filename", _peer_database_filename));
+        _journal.close();
+    }
+}
+
+void peer_database_impl::close()
+{
+    if (_journal.is_open())
+    {
+        save();
+        _journal.close();
     }
     _potential_peer_set.clear();
 }
@@ -147,23 +357,29 @@ void peer_database_impl::close()
 void peer_database_impl::clear()
 {
     _potential_peer_set.clear();
+    if (_journal.is_open())
+        save();
 }
 
 void peer_database_impl::erase(const fc::ip::endpoint& endpointToErase)
 {
     auto iter = _potential_peer_set.get<endpoint_index>().find(endpointToErase);
     if (iter != _potential_peer_set.get<endpoint_index>().end())
+    {
         _potential_peer_set.get<endpoint_index>().erase(iter);
+        append(journal_erase, potential_peer_record(endpointToErase));
+    }
 }
 
 void peer_database_impl::update_entry(const potential_peer_record& updatedRecord)
 {
     auto iter = _potential_peer_set.get<endpoint_index>().find(updatedRecord.endpoint);
     if (iter != _potential_peer_set.get<endpoint_index>().end())
-        _potential_peer_set.get<endpoint_index>().modify(
-            iter, [&updatedRecord](potential_peer_record& record) { record = updatedRecord; });
+        _potential_peer_set.get<endpoint_index>().replace(iter, updatedRecord);
     else
         _potential_peer_set.get<endpoint_index>().insert(updatedRecord);
+
+    append(journal_update, updatedRecord);
 }
 
 potential_peer_record peer_database_impl::lookup_or_create_entry_for_endpoint(const fc::ip::endpoint& endpointToLookup)
@@ -183,6 +399,34 @@ peer_database_impl::lookup_entry_for_endpoint(const fc::ip::endpoint& endpointTo
     return fc::optional<potential_peer_record>();
 }
 
+std::vector<potential_peer_record>
+peer_database_impl::get_connection_candidates(size_t max_count,
+                                              const fc::time_point& now,
+                                              uint32_t retry_timeout,
+                                              const std::function<bool(const fc::ip::endpoint&)>& skip) const
+{
+    std::vector<potential_peer_record> result;
+
+    for (const auto& record : _potential_peer_set.get<connection_rank_index>())
+    {
+        if (result.size() >= max_count)
+            break;
+
+        if (connection_rank()(record) == connection_rank::failed)
+        {
+            fc::microseconds delay_until_retry
+                = fc::seconds((record.number_of_failed_connection_attempts + 1) * retry_timeout);
+            if (now - record.last_connection_attempt_time <= delay_until_retry)
+                continue;
+        }
+
+        if (!skip(record.endpoint))
+            result.push_back(record);
+    }
+
+    return result;
+}
+
 peer_database::iterator peer_database_impl::begin() const
 {
     return peer_database::iterator(
@@ -274,6 +518,15 @@ fc::optional<potential_peer_record> peer_database::lookup_entry_for_endpoint(con
     return my->lookup_entry_for_endpoint(endpoint_to_lookup);
 }
 
+std::vector<potential_peer_record>
+peer_database::get_connection_candidates(size_t max_count,
+                                         const fc::time_point& now,
+                                         uint32_t retry_timeout,
+                                         const std::function<bool(const fc::ip::endpoint&)>& skip) const
+{
+    return my->get_connection_candidates(max_count, now, retry_timeout, skip);
+}
+
 peer_database::iterator peer_database::begin() const
 {
     return my->begin();
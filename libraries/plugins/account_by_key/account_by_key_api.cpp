@@ -1,5 +1,9 @@
 #include <scorum/account_by_key/account_by_key_api.hpp>
 #include <scorum/account_by_key/account_by_key_objects.hpp>
+#include <scorum/account_by_key/account_by_key_plugin.hpp>
+
+#include <algorithm>
+#include <numeric>
 
 namespace scorum {
 namespace account_by_key {
@@ -14,31 +18,57 @@ public:
     {
     }
 
-    std::vector<std::vector<account_name_type>> get_key_references(std::vector<public_key_type>& keys) const;
+    std::shared_ptr<account_by_key_plugin> get_plugin() const
+    {
+        auto plugin = _app.get_plugin<account_by_key_plugin>(ACCOUNT_BY_KEY_PLUGIN_NAME);
+
+        FC_ASSERT(plugin, "Cann't get " ACCOUNT_BY_KEY_PLUGIN_NAME " plugin from application.");
+
+        return plugin;
+    }
+
+    std::vector<std::vector<account_name_type>> get_key_references(const std::vector<public_key_type>& keys) const;
 
     scorum::app::application& _app;
 };
 
 std::vector<std::vector<account_name_type>>
-account_by_key_api_impl::get_key_references(std::vector<public_key_type>& keys) const
+account_by_key_api_impl::get_key_references(const std::vector<public_key_type>& keys) const
 {
-    std::vector<std::vector<account_name_type>> final_result;
-    final_result.reserve(keys.size());
+    std::vector<std::vector<account_name_type>> final_result(keys.size());
 
     const auto& key_idx = _app.chain_database()->get_index<key_lookup_index>().indices().get<by_key>();
+    const auto plugin = get_plugin();
+
+    // Keys are processed in the index order, so the index is walked once in one direction
+    // and the tree lookup is skipped when the current position already is the lower bound for the next key.
+    std::vector<size_t> order(keys.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) { return keys[lhs] < keys[rhs]; });
 
-    for (auto& key : keys)
+    auto lookup_itr = key_idx.begin();
+    for (size_t i = 0; i < order.size(); ++i)
     {
-        std::vector<account_name_type> result;
-        auto lookup_itr = key_idx.lower_bound(key);
+        const auto& key = keys[order[i]];
+        auto& result = final_result[order[i]];
+
+        if (i > 0 && keys[order[i - 1]] == key)
+        {
+            result = final_result[order[i - 1]];
+            continue;
+        }
+
+        if (!plugin->may_have_key_references(key))
+            continue;
+
+        if (lookup_itr != key_idx.end() && lookup_itr->key < key)
+            lookup_itr = key_idx.lower_bound(key);
 
         while (lookup_itr != key_idx.end() && lookup_itr->key == key)
         {
             result.push_back(lookup_itr->account);
             ++lookup_itr;
         }
-
-        final_result.emplace_back(std::move(result));
     }
 
     return final_result;
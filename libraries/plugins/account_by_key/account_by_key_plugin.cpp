@@ -3,9 +3,13 @@
 #include <scorum/account_by_key/account_by_key_api.hpp>
 
 #include <scorum/chain/schema/account_objects.hpp>
+#include <scorum/chain/schema/dynamic_global_property_object.hpp>
+#include <scorum/chain/services/dynamic_global_property.hpp>
 #include <scorum/chain/database/database.hpp>
 #include <scorum/chain/operation_notification.hpp>
 
+#include <scorum/utils/bloom_filter.hpp>
+
 #include <graphene/schema/schema.hpp>
 #include <graphene/schema/schema_impl.hpp>
 
@@ -33,10 +37,27 @@ public:
     void cache_auths(const account_authority_object& a);
     void update_key_lookup(const account_authority_object& a);
 
+    void add_to_key_filter(const public_key_type& key);
+    void rebuild_key_filter();
+    void on_applied_block();
+
     flat_set<public_key_type> cached_keys;
     account_by_key_plugin& _self;
+
+    // Most of requested keys are unknown, the filter answers them without index lookup.
+    // Removed (or undone) lookups stay in the filter until it is rebuilt, that only costs an extra lookup.
+    utils::bloom_filter key_filter{ min_key_filter_capacity };
+
+    // Keys of removed lookups by the number of the block they were removed in. The filter is rebuilt from the index,
+    // but an undo or a fork switch can restore a removed lookup, so the keys go to the rebuilt filter too until
+    // the block is irreversible.
+    std::map<uint32_t, std::vector<public_key_type>> reversibly_removed_keys;
+
+    static constexpr size_t min_key_filter_capacity = 1 << 16;
 };
 
+constexpr size_t account_by_key_plugin_impl::min_key_filter_capacity;
+
 struct pre_operation_visitor
 {
     account_by_key_plugin& _plugin;
@@ -188,6 +209,8 @@ void account_by_key_plugin_impl::update_key_lookup(const account_authority_objec
                     o.key = key;
                     o.account = a.account;
                 });
+
+                add_to_key_filter(key);
             }
         }
         else
@@ -205,12 +228,50 @@ void account_by_key_plugin_impl::update_key_lookup(const account_authority_objec
         if (lookup_itr != nullptr)
         {
             db.remove(*lookup_itr);
+
+            reversibly_removed_keys[db.head_block_num() + 1].push_back(key);
         }
     }
 
     cached_keys.clear();
 }
 
+void account_by_key_plugin_impl::add_to_key_filter(const public_key_type& key)
+{
+    if (key_filter.size() >= key_filter.capacity())
+        rebuild_key_filter();
+
+    key_filter.insert(key.key_data.begin(), key.key_data.size());
+}
+
+void account_by_key_plugin_impl::rebuild_key_filter()
+{
+    const auto& key_idx = database().get_index<key_lookup_index>().indices().get<by_key>();
+
+    size_t removed_count = 0;
+    for (const auto& removed : reversibly_removed_keys)
+        removed_count += removed.second.size();
+
+    key_filter = utils::bloom_filter(std::max((key_idx.size() + removed_count) * 2, min_key_filter_capacity));
+
+    for (const key_lookup_object& lookup : key_idx)
+        key_filter.insert(lookup.key.key_data.begin(), lookup.key.key_data.size());
+
+    for (const auto& removed : reversibly_removed_keys)
+    {
+        for (const public_key_type& key : removed.second)
+            key_filter.insert(key.key_data.begin(), key.key_data.size());
+    }
+}
+
+void account_by_key_plugin_impl::on_applied_block()
+{
+    const auto& dgpo = database().obtain_service<chain::dbs_dynamic_global_property>().get();
+
+    reversibly_removed_keys.erase(reversibly_removed_keys.begin(),
+                                  reversibly_removed_keys.upper_bound(dgpo.last_irreversible_block_num));
+}
+
 void account_by_key_plugin_impl::pre_operation(const operation_notification& note)
 {
     note.op.visit(pre_operation_visitor(_self));
@@ -242,6 +303,7 @@ void account_by_key_plugin::plugin_initialize(const boost::program_options::vari
 
         db.pre_apply_operation.connect([&](const operation_notification& o) { my->pre_operation(o); });
         db.post_apply_operation.connect([&](const operation_notification& o) { my->post_operation(o); });
+        db.applied_block.connect([&](const chain::signed_block&) { my->on_applied_block(); });
 
         db.add_plugin_index<key_lookup_index>();
     }
@@ -270,6 +332,18 @@ void account_by_key_plugin::plugin_startup()
         }
         ++it;
     }
+
+    my->rebuild_key_filter();
+}
+
+bool account_by_key_plugin::may_have_key_references(const scorum::protocol::public_key_type& key) const
+{
+    return my->key_filter.may_contain(key.key_data.begin(), key.key_data.size());
+}
+
+void account_by_key_plugin::rebuild_key_filter()
+{
+    my->rebuild_key_filter();
 }
 }
 } // scorum::account_by_key
@@ -1,6 +1,7 @@
 #pragma once
 #include <scorum/app/plugin.hpp>
 #include <scorum/chain/database/database.hpp>
+#include <scorum/protocol/types.hpp>
 
 namespace scorum {
 namespace account_by_key {
@@ -31,6 +32,12 @@ public:
     virtual void plugin_initialize(const boost::program_options::variables_map& options) override;
     virtual void plugin_startup() override;
 
+    /// false if the key is definitely not referenced by any account (checked without index lookup)
+    bool may_have_key_references(const scorum::protocol::public_key_type& key) const;
+
+    /// fills the filter from the index again, it is done on startup and when the filter outgrows its capacity
+    void rebuild_key_filter();
+
     friend class detail::account_by_key_plugin_impl;
     std::unique_ptr<detail::account_by_key_plugin_impl> my;
 };
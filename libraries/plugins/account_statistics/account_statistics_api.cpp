@@ -13,6 +13,18 @@ public:
         : base_api_impl(app, ACCOUNT_STATISTICS_PLUGIN_NAME)
     {
     }
+
+    void add_bucket_statistic(statistics& result, const bucket_object& bucket) const override
+    {
+        const auto& statistic_idx
+            = _app.chain_database()->get_index<account_bucket_statistic_index, by_bucket_account>();
+
+        for (auto itr = statistic_idx.lower_bound(boost::make_tuple(bucket.id));
+             itr != statistic_idx.end() && itr->bucket == bucket.id; ++itr)
+        {
+            result.statistic_map[itr->account] += itr->statistic;
+        }
+    }
 };
 } // namespace detail
 
@@ -12,6 +12,8 @@ namespace account_statistics {
 
 namespace detail {
 
+using account_statistic_map = std::map<account_name_type, account_statistic>;
+
 class account_statistics_plugin_impl
     : public common_statistics::common_statistics_plugin_impl<bucket_object, account_statistics_plugin>
 {
@@ -24,7 +26,27 @@ public:
     {
     }
 
-    virtual void process_post_operation(const bucket_object& bucket, const operation_notification& o) override;
+    void initialize()
+    {
+        base_plugin_impl::initialize();
+
+        auto& db = _self.database();
+
+        db.pre_applied_block.connect([&](const signed_block&) { _block_statistic.clear(); });
+        db.post_apply_operation.connect([&](const operation_notification& o) { this->collect_statistic(o); });
+
+        db.add_plugin_index<account_bucket_statistic_index>();
+    }
+
+    void collect_statistic(const operation_notification& o);
+
+    virtual void process_block(const bucket_object& bucket, const signed_block& b) override;
+    virtual void process_bucket_removal(const bucket_object& bucket) override;
+
+private:
+    // Operations of the block being applied are accumulated here and added to the buckets once per block.
+    // It is cleared in the beginning of every block, so pending transactions (applied outside blocks) are not counted.
+    account_statistic_map _block_statistic;
 };
 
 struct activity_operation_process
@@ -45,12 +67,10 @@ struct activity_operation_process
 
 struct operation_process
 {
-    chain::database& _db;
-    const bucket_object& _bucket;
+    account_statistic_map& _statistic;
 
-    operation_process(chain::database& db, const bucket_object& b)
-        : _db(db)
-        , _bucket(b)
+    operation_process(account_statistic_map& statistic)
+        : _statistic(statistic)
     {
     }
 
@@ -60,24 +80,56 @@ struct operation_process
 
     void operator()(const transfer_operation& op) const
     {
-        _db.modify(_bucket, [&](bucket_object& b) {
-            auto& from_stat = b.account_statistic[op.from];
-            from_stat.transfers_from++;
-            from_stat.scorum_sent += op.amount;
-
-            auto& to_stat = b.account_statistic[op.to];
-            to_stat.transfers_to++;
-            to_stat.scorum_received += op.amount;
-        });
+        auto& from_stat = _statistic[op.from];
+        from_stat.transfers_from++;
+        from_stat.scorum_sent += op.amount;
+
+        auto& to_stat = _statistic[op.to];
+        to_stat.transfers_to++;
+        to_stat.scorum_received += op.amount;
     }
 };
 
-void account_statistics_plugin_impl::process_post_operation(const bucket_object& bucket,
-                                                            const operation_notification& o)
+void account_statistics_plugin_impl::collect_statistic(const operation_notification& o)
+{
+    o.op.visit(operation_process(_block_statistic));
+}
+
+void account_statistics_plugin_impl::process_block(const bucket_object& bucket, const signed_block&)
+{
+    auto& db = _self.database();
+    const auto& statistic_idx = db.get_index<account_bucket_statistic_index, by_bucket_account>();
+
+    for (const auto& item : _block_statistic)
+    {
+        auto itr = statistic_idx.find(boost::make_tuple(bucket.id, item.first));
+        if (itr == statistic_idx.end())
+        {
+            db.create<account_bucket_statistic_object>([&](account_bucket_statistic_object& o) {
+                o.bucket = bucket.id;
+                o.account = item.first;
+                o.statistic += item.second;
+            });
+        }
+        else
+        {
+            db.modify(*itr, [&](account_bucket_statistic_object& o) { o.statistic += item.second; });
+        }
+    }
+}
+
+void account_statistics_plugin_impl::process_bucket_removal(const bucket_object& bucket)
 {
     auto& db = _self.database();
+    const auto& statistic_idx = db.get_index<account_bucket_statistic_index, by_bucket_account>();
 
-    o.op.visit(operation_process(db, bucket));
+    auto itr = statistic_idx.lower_bound(boost::make_tuple(bucket.id));
+    while (itr != statistic_idx.end() && itr->bucket == bucket.id)
+    {
+        const auto& statistic = *itr;
+        ++itr;
+        db.remove(statistic);
+    }
 }
 
 } // namespace detail
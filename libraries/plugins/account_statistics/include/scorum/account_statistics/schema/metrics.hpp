@@ -10,8 +10,6 @@ namespace account_statistics {
 using scorum::protocol::asset;
 using scorum::protocol::account_name_type;
 
-struct bucket_object;
-
 // clang-format off
 struct account_metric
 {
@@ -75,8 +73,6 @@ struct account_statistic : public account_metric
 struct statistics
 {
     std::map<account_name_type, account_statistic> statistic_map;
-
-    statistics& operator+=(const bucket_object&);
 };
 }
 } // scorum::account_statistics
@@ -2,8 +2,6 @@
 
 #include <boost/multi_index/composite_key.hpp>
 
-#include <fc/shared_containers.hpp>
-
 #include <scorum/chain/schema/scorum_object_types.hpp>
 #include <scorum/account_statistics/schema/metrics.hpp>
 #include <scorum/common_statistics/base_bucket_object.hpp>
@@ -30,19 +28,33 @@ using namespace scorum::chain;
 enum account_statistics_plugin_object_types
 {
     bucket_object_type = (ACCOUNT_STATISTICS_SPACE_ID << 8),
-    activity_bucket_object_type
+    activity_bucket_object_type,
+    account_bucket_statistic_object_type
 };
 
 struct bucket_object : public common_statistics::base_bucket_object, public object<bucket_object_type, bucket_object>
 {
-    CHAINBASE_DEFAULT_DYNAMIC_CONSTRUCTOR(bucket_object, (account_statistic))
+    CHAINBASE_DEFAULT_CONSTRUCTOR(bucket_object)
 
     id_type id;
-
-    fc::shared_map<account_name_type, account_metric> account_statistic;
 };
 typedef bucket_object::id_type bucket_id_type;
 
+/// statistic of the single account collected in the bucket
+struct account_bucket_statistic_object
+    : public object<account_bucket_statistic_object_type, account_bucket_statistic_object>
+{
+    CHAINBASE_DEFAULT_CONSTRUCTOR(account_bucket_statistic_object)
+
+    id_type id;
+
+    bucket_id_type bucket;
+    account_name_type account;
+
+    account_statistic statistic;
+};
+typedef account_bucket_statistic_object::id_type account_bucket_statistic_id_type;
+
 struct activity_bucket_object : public common_statistics::base_bucket_object,
                                 public object<activity_bucket_object_type, activity_bucket_object>
 {
@@ -75,15 +87,36 @@ typedef shared_multi_index_container<bucket_object,
                                                                                     &common_statistics::
                                                                                         base_bucket_object::open>>>>>
     bucket_index;
+
+struct by_bucket_account;
+typedef shared_multi_index_container<account_bucket_statistic_object,
+                                     indexed_by<ordered_unique<tag<by_id>,
+                                                               member<account_bucket_statistic_object,
+                                                                      account_bucket_statistic_id_type,
+                                                                      &account_bucket_statistic_object::id>>,
+                                                ordered_unique<tag<by_bucket_account>,
+                                                               composite_key<account_bucket_statistic_object,
+                                                                             member<account_bucket_statistic_object,
+                                                                                    bucket_id_type,
+                                                                                    &account_bucket_statistic_object::
+                                                                                        bucket>,
+                                                                             member<account_bucket_statistic_object,
+                                                                                    account_name_type,
+                                                                                    &account_bucket_statistic_object::
+                                                                                        account>>>>>
+    account_bucket_statistic_index;
 } // namespace account_statistics
 } // namespace scorum
 
-FC_REFLECT_DERIVED(scorum::account_statistics::bucket_object,
-                   (scorum::common_statistics::base_bucket_object)(scorum::account_statistics::account_metric),
-                   (id))
+FC_REFLECT_DERIVED(scorum::account_statistics::bucket_object, (scorum::common_statistics::base_bucket_object), (id))
 
 CHAINBASE_SET_INDEX_TYPE(scorum::account_statistics::bucket_object, scorum::account_statistics::bucket_index)
 
+FC_REFLECT(scorum::account_statistics::account_bucket_statistic_object, (id)(bucket)(account)(statistic))
+
+CHAINBASE_SET_INDEX_TYPE(scorum::account_statistics::account_bucket_statistic_object,
+                         scorum::account_statistics::account_bucket_statistic_index)
+
 // clang-format off
 
 FC_REFLECT_DERIVED(
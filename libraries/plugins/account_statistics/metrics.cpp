@@ -1,5 +1,4 @@
 #include <scorum/account_statistics/schema/metrics.hpp>
-#include <scorum/account_statistics/schema/objects.hpp>
 
 namespace scorum {
 namespace account_statistics {
@@ -57,16 +56,5 @@ account_statistic& account_statistic::operator+=(const account_metric& stat)
 
     return (*this);
 }
-
-//////////////////////////////////////////////////////////////////////////
-statistics& statistics::operator+=(const bucket_object& bucket)
-{
-    for (auto& item : bucket.account_statistic)
-    {
-        statistic_map[item.first] += item.second;
-    }
-
-    return (*this);
-}
 }
 } // scorum::account_statistics
@@ -7,6 +7,7 @@
 #include <scorum/protocol/operations.hpp>
 
 #include <fc/static_variant.hpp>
+#include <fc/thread/thread.hpp>
 
 #include <boost/lambda/lambda.hpp>
 
@@ -245,25 +246,11 @@ public:
             uint32_t from_block_num = (block_num > limit) ? block_num - limit : 0;
 
             std::vector<block_api_object> result;
-            optional<signed_block> b;
             while (from_block_num != block_num)
             {
-                b = _db->fetch_block_by_number(block_num);
-
-                if (b.valid())
-                {
-                    block_api_object block(static_cast<signed_block_header>(*b));
-                    block.block_num = block_num;
-
-                    auto operations = this->get_ops_in_block(block_num, [&](const operation&) { return true; });
-
-                    for (auto pair : operations)
-                    {
-                        block.operations.push_back(pair.second);
-                    }
-
-                    result.push_back(block);
-                }
+                auto block = get_block_api_object(block_num);
+                if (block.valid())
+                    result.push_back(std::move(*block));
                 --block_num;
             }
 
@@ -271,8 +258,143 @@ public:
         }
         FC_LOG_AND_RETHROW()
     }
+
+    optional<block_api_object> get_block_api_object(uint32_t block_num) const
+    {
+        optional<block_api_object> result;
+
+        auto b = _db->fetch_block_by_number(block_num);
+        if (!b.valid())
+            return result;
+
+        result = block_api_object(static_cast<signed_block_header>(*b));
+        result->block_num = block_num;
+
+        auto operations = this->get_ops_in_block(block_num, [&](const operation&) { return true; });
+        for (auto pair : operations)
+        {
+            result->operations.push_back(pair.second);
+        }
+
+        return result;
+    }
+
+    // Streams
+    void check_batch_size(uint32_t batch_size) const
+    {
+        FC_ASSERT(batch_size <= get_api_config(API_BLOCKCHAIN_HISTORY).max_blockchain_history_depth,
+                  "Batch size of ${l} is greater than maxmimum allowed ${2}",
+                  ("l", batch_size)("2", get_api_config(API_BLOCKCHAIN_HISTORY).max_blockchain_history_depth));
+        FC_ASSERT(batch_size > 0, "Batch size must be greater than zero");
+    }
+
+    blocks_stream_batch get_blocks_batch(uint32_t from, uint32_t to, uint32_t batch_size) const
+    {
+        const uint32_t head_block_num = get_head_block();
+        const uint32_t last_block_num = to ? std::min(to, head_block_num) : head_block_num;
+
+        blocks_stream_batch batch;
+
+        uint32_t block_num = std::max(from, 1u);
+        for (; block_num <= last_block_num && batch.blocks.size() < batch_size; ++block_num)
+        {
+            auto block = get_block_api_object(block_num);
+            if (block.valid())
+                batch.blocks.push_back(std::move(*block));
+        }
+
+        batch.next_block = block_num;
+        batch.is_last = block_num > last_block_num;
+
+        return batch;
+    }
+
+    template <typename IndexType>
+    ops_stream_batch get_ops_batch(uint32_t from_op, uint32_t to_op, uint32_t batch_size) const
+    {
+        const auto& idx = _db->get_index<IndexType, by_id>();
+
+        ops_stream_batch batch;
+        batch.next_op = from_op;
+
+        auto it = idx.lower_bound(from_op);
+        for (; it != idx.end() && batch.ops.size() < batch_size; ++it)
+        {
+            const auto id = it->id._id;
+            FC_ASSERT(id >= 0, "Invalid operation_object id");
+            if ((uint32_t)id > to_op)
+                break;
+
+            batch.ops[(uint32_t)id] = get_operation(*it);
+            batch.next_op = (uint32_t)id + 1;
+        }
+
+        batch.is_last = it == idx.end() || (uint32_t)it->id._id > to_op;
+
+        return batch;
+    }
 };
 
+/// callbacks are sent without waiting for the client, so a stream is cut after this number of batches not to fill
+/// the send queue of the connection, the client resumes it by a new call
+const uint32_t max_stream_batches = 100;
+
+inline uint32_t get_next_cursor(const blocks_stream_batch& batch)
+{
+    return batch.next_block;
+}
+
+inline uint32_t get_next_cursor(const ops_stream_batch& batch)
+{
+    return batch.next_op;
+}
+
+/// pushes batches to 'cb' until the last one or 'max_stream_batches' and then stream_end, or until a failure of 'cb'
+/// (closed connection), other requests are served between batches
+template <typename ReadBatch> void stream_batches(std::function<void(const variant&)> cb, ReadBatch read_batch)
+{
+    fc::async([cb, read_batch]() mutable {
+        try
+        {
+            for (uint32_t n = 1;; ++n)
+            {
+                auto batch = read_batch();
+                cb(fc::variant(batch));
+
+                if (batch.is_last || n == max_stream_batches)
+                {
+                    stream_end end;
+                    end.status = batch.is_last ? stream_status::done : stream_status::truncated;
+                    end.next_cursor = get_next_cursor(batch);
+                    cb(fc::variant(end));
+                    return;
+                }
+
+                fc::yield();
+            }
+        }
+        catch (const fc::exception& e)
+        {
+            wlog("History stream is stopped: ${e}", ("e", e.to_string()));
+        }
+    });
+}
+
+template <typename IndexType>
+void stream_ops_history(std::shared_ptr<blockchain_history_api_impl> impl,
+                        std::function<void(const variant&)> cb,
+                        uint32_t from_op,
+                        uint32_t to_op,
+                        uint32_t batch_size)
+{
+    stream_batches(cb, [impl, from_op, to_op, batch_size]() mutable {
+        auto batch = impl->_db->with_read_lock(
+            [&]() { return impl->get_ops_batch<IndexType>(from_op, to_op, batch_size); });
+        from_op = batch.next_op;
+        return batch;
+    });
+}
+
 } // namespace detail
 
 blockchain_history_api::blockchain_history_api(const scorum::app::api_context& ctx)
@@ -375,5 +497,51 @@ std::vector<block_api_object> blockchain_history_api::get_blocks(uint32_t from,
     return _impl->_db->with_read_lock([&]() { return _impl->get_blocks(from, limit); });
 }
 
+//////////////////////////////////////////////////////////////////////
+// Streams                                                          //
+//////////////////////////////////////////////////////////////////////
+
+void blockchain_history_api::stream_blocks(std::function<void(const variant&)> cb,
+                                           uint32_t from,
+                                           uint32_t to,
+                                           uint32_t batch_size) const
+{
+    _impl->check_batch_size(batch_size);
+    FC_ASSERT(to == 0 || from <= to, "From must not be greater than to");
+
+    auto impl = _impl;
+    detail::stream_batches(cb, [impl, from, to, batch_size]() mutable {
+        auto batch = impl->_db->with_read_lock([&]() { return impl->get_blocks_batch(from, to, batch_size); });
+        from = batch.next_block;
+        return batch;
+    });
+}
+
+void blockchain_history_api::stream_ops_history(std::function<void(const variant&)> cb,
+                                                uint32_t from_op,
+                                                uint32_t to_op,
+                                                applied_operation_type type_of_operation,
+                                                uint32_t batch_size) const
+{
+    _impl->check_batch_size(batch_size);
+    FC_ASSERT(from_op <= to_op, "From must not be greater than to");
+
+    switch (type_of_operation)
+    {
+    case applied_operation_type::not_virt:
+        detail::stream_ops_history<filtered_not_virt_operations_history_index>(_impl, cb, from_op, to_op, batch_size);
+        return;
+    case applied_operation_type::virt:
+        detail::stream_ops_history<filtered_virt_operations_history_index>(_impl, cb, from_op, to_op, batch_size);
+        return;
+    case applied_operation_type::market:
+        detail::stream_ops_history<filtered_market_operations_history_index>(_impl, cb, from_op, to_op, batch_size);
+        return;
+    default:;
+    }
+
+    detail::stream_ops_history<operation_index>(_impl, cb, from_op, to_op, batch_size);
+}
+
 } // namespace blockchain_history
 } // namespace scorum
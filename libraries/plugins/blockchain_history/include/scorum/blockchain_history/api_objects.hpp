@@ -1,5 +1,7 @@
 #pragma once
 
+#include <map>
+
 #include <scorum/protocol/block.hpp>
 
 #include <scorum/blockchain_history/schema/applied_operation.hpp>
@@ -57,6 +59,35 @@ struct block_api_object : public signed_block_header
     uint32_t block_num = 0;
     std::vector<block_api_operation_object> operations;
 };
+
+/// pushed by blockchain_history_api::stream_blocks
+struct blocks_stream_batch
+{
+    std::vector<block_api_object> blocks;
+    uint32_t next_block = 0; ///< cursor to resume the stream from
+    bool is_last = false;
+};
+
+/// pushed by blockchain_history_api::stream_ops_history
+struct ops_stream_batch
+{
+    std::map<uint32_t, applied_operation> ops;
+    uint32_t next_op = 0; ///< cursor to resume the stream from
+    bool is_last = false;
+};
+
+enum class stream_status
+{
+    done, ///< the whole requested range is pushed
+    truncated ///< the stream is cut, a new call resumes it from 'next_cursor'
+};
+
+/// pushed after the last batch of a stream
+struct stream_end
+{
+    stream_status status = stream_status::done;
+    uint32_t next_cursor = 0; ///< 'next_block' or 'next_op' of the last batch
+};
 }
 }
 
@@ -66,6 +97,14 @@ FC_REFLECT_DERIVED(scorum::blockchain_history::block_api_object,
                    (scorum::protocol::signed_block_header),
                    (block_num)(operations))
 
+FC_REFLECT(scorum::blockchain_history::blocks_stream_batch, (blocks)(next_block)(is_last))
+
+FC_REFLECT(scorum::blockchain_history::ops_stream_batch, (ops)(next_op)(is_last))
+
+FC_REFLECT_ENUM(scorum::blockchain_history::stream_status, (done)(truncated))
+
+FC_REFLECT(scorum::blockchain_history::stream_end, (status)(next_cursor))
+
 FC_REFLECT_DERIVED(scorum::blockchain_history::signed_block_api_obj,
                    (scorum::protocol::signed_block),
                    (block_id)(signing_key)(transaction_ids))
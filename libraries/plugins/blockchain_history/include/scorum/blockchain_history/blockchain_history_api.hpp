@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <map>
 #include <fc/api.hpp>
 #include <scorum/blockchain_history/schema/applied_operation.hpp>
@@ -119,10 +120,39 @@ public:
      * @return the list of signed blocks
      */
     std::vector<block_api_object> get_blocks(uint32_t from, uint32_t limit) const;
+
+    /**
+     * @brief Pushes blocks in range [from, to] in ascending order to the callback as blocks_stream_batch
+     *
+     * Every batch is read under its own read lock, no lock is held between batches. The stream ends with stream_end:
+     * 'done' after the batch marked 'is_last', or 'truncated' after 100 batches. The stream is resumed (also after
+     * reconnect) by a new call with 'from' set to 'next_cursor' of stream_end or 'next_block' of the last batch.
+     * @param from Height of the first block
+     * @param to Height of the last block, 0 means the head block
+     * @param batch_size the maximum number of blocks in a batch (0 to 100]
+     */
+    void stream_blocks(std::function<void(const variant&)> cb, uint32_t from, uint32_t to, uint32_t batch_size) const;
+
+    /**
+     * @brief Pushes operations in ids range [from_op, to_op] in ascending order to the callback as ops_stream_batch
+     *
+     * Every batch is read under its own read lock, no lock is held between batches. The stream ends with stream_end:
+     * 'done' after the batch marked 'is_last', or 'truncated' after 100 batches. The stream is resumed (also after
+     * reconnect) by a new call with 'from_op' set to 'next_cursor' of stream_end or 'next_op' of the last batch.
+     * @param from_op the first operation number
+     * @param to_op the last operation number, -1 means the most recent one
+     * @param type_of_operation Operations type (all = 0, not_virt = 1, virt = 2, market = 3)
+     * @param batch_size the maximum number of operations in a batch (0 to 100]
+     */
+    void stream_ops_history(std::function<void(const variant&)> cb,
+                            uint32_t from_op,
+                            uint32_t to_op,
+                            applied_operation_type type_of_operation,
+                            uint32_t batch_size) const;
     /// @}
 
 private:
-    std::unique_ptr<detail::blockchain_history_api_impl> _impl;
+    std::shared_ptr<detail::blockchain_history_api_impl> _impl;
 };
 
 } // namespace blockchain_history
@@ -131,4 +161,6 @@ private:
 FC_API(scorum::blockchain_history::blockchain_history_api,
        (get_ops_history)(get_ops_history_by_time)(get_ops_in_block)
        // Blocks and transactions
-       (get_transaction)(get_block_header)(get_block_headers_history)(get_block)(get_blocks_history)(get_blocks))
+       (get_transaction)(get_block_header)(get_block_headers_history)(get_block)(get_blocks_history)(get_blocks)
+       // Streams
+       (stream_blocks)(stream_ops_history))
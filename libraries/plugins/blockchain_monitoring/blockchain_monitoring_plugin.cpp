@@ -74,13 +74,6 @@ public:
     }
 
 private:
-    virtual void process_bucket_creation(const bucket_object& bucket) override
-    {
-        auto& db = _self.database();
-
-        db.modify<bucket_object>(bucket, [&](bucket_object& bo) { bo.blocks = 1; });
-    }
-
     virtual void process_block(const bucket_object& bucket, const signed_block& b) override;
 
     virtual void process_pre_operation(const bucket_object& bucket, const operation_notification& o) override;
@@ -412,7 +405,10 @@ void blockchain_monitoring_plugin::plugin_set_program_options(boost::program_opt
         "Track blockchain statistics by grouping orders into buckets of equal size measured in seconds specified as a "
         "JSON array of numbers")(
         "chain-stats-history-per-bucket", boost::program_options::value<uint32_t>()->default_value(100),
-        "How far back in time to track history for each bucket size, measured in the number of buckets (default: 100)");
+        "How far back in time to track history for each bucket size, measured in the number of buckets (default: 100)")(
+        "chain-block-profiler", boost::program_options::bool_switch()->default_value(false),
+        "Collect time, call count and shared memory allocation per block task, operation and signal handler "
+        "(available through node_monitoring_api and dumped to the log while replaying)");
     cfg.add(cli);
 }
 
@@ -431,6 +427,12 @@ void blockchain_monitoring_plugin::plugin_initialize(const boost::program_option
         ilog("chain-stats-bucket-size: ${b}", ("b", _my->_tracked_buckets));
         ilog("chain-stats-history-per-bucket: ${h}", ("h", _my->_maximum_history_per_bucket_size));
 
+        if (options.count("chain-block-profiler") && options["chain-block-profiler"].as<bool>())
+        {
+            database().get_block_profiler().enable(true);
+            ilog("chain-block-profiler: enabled");
+        }
+
         _my->initialize();
     }
     FC_CAPTURE_AND_RETHROW()
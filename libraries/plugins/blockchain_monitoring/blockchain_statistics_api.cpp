@@ -13,6 +13,11 @@ public:
         : base_api_impl(app, BLOCKCHAIN_MONITORING_PLUGIN_NAME)
     {
     }
+
+    void add_bucket_statistic(statistics& result, const bucket_object& bucket) const override
+    {
+        result += bucket;
+    }
 };
 } // namespace detail
 
@@ -2,6 +2,8 @@
 
 #include <fc/api.hpp>
 
+#include <scorum/chain/database/block_profiler.hpp>
+
 #ifndef API_NODE_MONITORING
 #define API_NODE_MONITORING "node_monitoring_api"
 #endif
@@ -47,6 +49,13 @@ public:
     uint32_t get_free_shared_memory_mb() const;
     uint32_t get_total_shared_memory_mb() const;
 
+    /**
+    * @brief Returns cumulative cost of block tasks, operations evaluators and signal handlers.
+    *
+    * Profiler is enabled by 'chain-block-profiler' option.
+    */
+    chain::block_profile get_block_profile() const;
+
     /// @}
 
 private:
@@ -56,4 +65,4 @@ private:
 } // namespace scorum
 
 FC_API(scorum::blockchain_monitoring::node_monitoring_api,
-       (get_last_block_duration_microseconds)(get_free_shared_memory_mb)(get_total_shared_memory_mb))
+       (get_last_block_duration_microseconds)(get_free_shared_memory_mb)(get_total_shared_memory_mb)(get_block_profile))
@@ -54,5 +54,11 @@ uint32_t node_monitoring_api::get_total_shared_memory_mb() const
         [&]() { return uint32_t(_my->_app.chain_database()->get_size() / (1024 * 1024)); });
 }
 
+chain::block_profile node_monitoring_api::get_block_profile() const
+{
+    return _my->_app.chain_database()->with_read_lock(
+        [&]() { return _my->_app.chain_database()->get_block_profiler().get_profile(); });
+}
+
 } // namespace blockchain_monitoring
 } // namespace scorum
@@ -21,6 +21,12 @@ public:
         , _plugin_name(name)
     {
     }
+    virtual ~common_statistics_api_impl()
+    {
+    }
+
+    /// adds statistic collected in the bucket to the result
+    virtual void add_bucket_statistic(Statistic& result, const Bucket& bucket) const = 0;
 
     Statistic get_stats_for_time(const fc::time_point_sec& open, uint32_t interval) const
     {
@@ -29,7 +35,7 @@ public:
         auto itr = bucket_idx.lower_bound(boost::make_tuple(interval, open));
 
         if (itr != bucket_idx.end())
-            result += *itr;
+            add_bucket_statistic(result, *itr);
 
         return result;
     }
@@ -53,7 +59,7 @@ public:
             while (itr != bucket_itr.end() && itr->seconds == *size_itr && time + itr->seconds <= end)
             {
                 time += *size_itr;
-                result += *itr;
+                add_bucket_statistic(result, *itr);
                 itr++;
             }
 
@@ -72,7 +78,7 @@ public:
 
         if (itr != bucket_idx.end())
         {
-            result += *itr;
+            add_bucket_statistic(result, *itr);
         }
 
         return result;
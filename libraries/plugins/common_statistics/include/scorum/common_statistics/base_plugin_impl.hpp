@@ -39,6 +39,9 @@ public:
     virtual void process_bucket_creation(const Bucket& bucket)
     {
     }
+    virtual void process_bucket_removal(const Bucket& bucket)
+    {
+    }
     virtual void process_block(const Bucket& bucket, const signed_block& b)
     {
     }
@@ -100,9 +103,12 @@ public:
         {
             auto open = fc::time_point_sec((db.head_block_time().sec_since_epoch() / bucket) * bucket);
 
+            const Bucket* current_bucket = nullptr;
+
             auto itr = bucket_idx.find(boost::make_tuple(bucket, open));
             if (itr != bucket_idx.end())
             {
+                current_bucket = &(*itr);
                 _current_buckets.insert(itr->id);
             }
             else
@@ -114,6 +120,7 @@ public:
 
                 process_bucket_creation(new_bucket_obj);
 
+                current_bucket = &new_bucket_obj;
                 _current_buckets.insert(new_bucket_obj.id);
 
                 // adjust history
@@ -133,10 +140,11 @@ public:
 
                         itr = bucket_idx.lower_bound(boost::make_tuple(bucket, fc::time_point_sec()));
 
-                        while (itr->seconds == bucket && itr->open < cutoff)
+                        while (itr != bucket_idx.end() && itr->seconds == bucket && itr->open < cutoff)
                         {
                             auto old_itr = itr;
                             ++itr;
+                            process_bucket_removal(*old_itr);
                             db.remove(*old_itr);
                         }
                     }
@@ -149,7 +157,7 @@ public:
                 }
             }
 
-            process_block(*itr, block);
+            process_block(*current_bucket, block);
         }
     }
 };
@@ -45,17 +45,22 @@ get_raw_block_result raw_block_api::get_raw_block(get_raw_block_args args)
     get_raw_block_result result;
     std::shared_ptr<scorum::chain::database> db = my->app.chain_database();
 
-    fc::optional<chain::signed_block> block = db->fetch_block_by_number(args.block_num);
-    if (!block.valid())
+    fc::optional<std::vector<char>> serialized_block = db->fetch_packed_block_by_number(args.block_num);
+    if (!serialized_block.valid())
     {
         return result;
     }
-    std::vector<char> serialized_block = fc::raw::pack(*block);
-    result.raw_block
-        = fc::base64_encode(std::string(&serialized_block[0], &serialized_block[0] + serialized_block.size()));
-    result.block_id = block->id();
-    result.previous = block->previous;
-    result.timestamp = block->timestamp;
+    result.raw_block = fc::base64_encode(
+        std::string(serialized_block->data(), serialized_block->data() + serialized_block->size()));
+
+    // the header goes first in the packed block, transactions are not unpacked
+    chain::block_header header;
+    fc::datastream<const char*> ds(serialized_block->data(), serialized_block->size());
+    fc::raw::unpack(ds, header);
+
+    result.block_id = db->find_block_id_for_num(args.block_num);
+    result.previous = header.previous;
+    result.timestamp = header.timestamp;
     return result;
 }
 
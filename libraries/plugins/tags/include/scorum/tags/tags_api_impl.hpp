@@ -20,6 +20,7 @@
 
 #include <scorum/chain/data_service_factory.hpp>
 #include <scorum/chain/services/comment.hpp>
+#include <scorum/chain/services/comment_content.hpp>
 #include <scorum/chain/services/reward_funds.hpp>
 #include <scorum/chain/services/comment_vote.hpp>
 #include <scorum/chain/services/account.hpp>
@@ -77,7 +78,8 @@ public:
 
     discussion create_discussion(const comment_object& comment) const
     {
-        return discussion(comment, _services.comment_statistic_scr_service(), _services.comment_statistic_sp_service());
+        return discussion(comment, _services.comment_content_service(), _services.comment_statistic_scr_service(),
+                          _services.comment_statistic_sp_service());
     }
 
     std::vector<api::tag_api_obj> get_trending_tags(const std::string& after_tag, uint32_t limit) const
@@ -206,11 +208,10 @@ public:
 
     discussion get_content(const std::string& author, const std::string& permlink) const
     {
-        const auto& by_permlink_idx = _db.get_index<comment_index, by_permlink>();
-        auto itr = by_permlink_idx.find(boost::make_tuple(author, permlink));
-        if (itr != by_permlink_idx.end())
+        const comment_object* comment = _services.comment_service().find(author, permlink);
+        if (comment != nullptr)
         {
-            return get_discussion(*itr);
+            return get_discussion(*comment);
         }
         return discussion();
     }
@@ -220,13 +221,12 @@ public:
         FC_ASSERT(queries.size() <= MAX_DISCUSSIONS_LIST_SIZE,
                   "queries vector size cannot be more than " + std::to_string(MAX_DISCUSSIONS_LIST_SIZE));
         std::vector<api::discussion> result;
-        const auto& by_permlink_idx = _db.get_index<comment_index, by_permlink>();
         for (const auto& query : queries)
         {
-            auto itr = by_permlink_idx.find(boost::make_tuple(query.author, query.permlink));
-            if (itr != by_permlink_idx.end())
+            const comment_object* comment = _services.comment_service().find(query.author, query.permlink);
+            if (comment != nullptr)
             {
-                result.emplace_back(get_discussion(*itr, query.truncate_body));
+                result.emplace_back(get_discussion(*comment, query.truncate_body));
             }
         }
         return result;
@@ -294,9 +294,9 @@ private:
 
     void set_url(discussion& d) const
     {
-        const api::comment_api_obj root(_services.comment_service().get(d.root_comment));
-        d.url = "/" + root.category + "/@" + root.author + "/" + root.permlink;
-        d.root_title = root.title;
+        const comment_object& root = _services.comment_service().get(d.root_comment);
+        d.url = "/" + fc::to_string(root.category) + "/@" + root.author + "/" + fc::to_string(root.permlink);
+        d.root_title = fc::to_string(_services.comment_content_service().get(root.id).title);
         if (root.id != d.id)
             d.url += "#@" + d.author + "/" + d.permlink;
     }
@@ -314,17 +314,54 @@ private:
         set_pending_payout(d);
 
         d.active_votes = get_active_votes(d.author, d.permlink);
+        d.active_votes_count = d.active_votes.size();
         d.body_length = d.body.size();
 
-        if (truncate_body)
+        truncate(d, truncate_body);
+
+        return d;
+    }
+
+    /// builds the discussion from the comment summary, neither the full body nor the votes are read
+    discussion get_discussion_summary(const comment_object& comment, uint32_t truncate_body = 0) const
+    {
+        const auto* summary = _db.find<comment_summary_object, tags::by_comment>(comment.id);
+        if (summary == nullptr)
+            return get_discussion(comment, truncate_body);
+
+        discussion d(comment, *summary, _services.comment_content_service(), _services.comment_statistic_scr_service(),
+                     _services.comment_statistic_sp_service());
+
+        set_pending_payout(d);
+
+        for (const auto& v : summary->top_votes)
+        {
+            api::vote_state vstate;
+            vstate.voter = v.voter;
+            vstate.weight = v.weight;
+            vstate.rshares = v.rshares;
+            vstate.percent = v.percent;
+            vstate.time = v.time;
+
+            d.active_votes.push_back(vstate);
+        }
+        d.active_votes_count = summary->votes_count;
+        d.body_length = summary->body_length;
+
+        truncate(d, truncate_body);
+
+        return d;
+    }
+
+    void truncate(discussion& d, uint32_t truncate_body) const
+    {
+        if (truncate_body && d.body.size() > truncate_body)
         {
             d.body = d.body.substr(0, truncate_body);
 
             if (!fc::is_utf8(d.body))
                 d.body = fc::prune_invalid_utf8(d.body);
         }
-
-        return d;
     }
 
     u256 to256(const fc::uint128& t) const
@@ -556,7 +593,12 @@ private:
         {
             try
             {
-                result.push_back(get_discussion(it->get().comment, query.truncate_body));
+                const comment_object& comment = _services.comment_service().get(it->get().comment);
+
+                if (query.summary)
+                    result.push_back(get_discussion_summary(comment, query.truncate_body));
+                else
+                    result.push_back(get_discussion(comment, query.truncate_body));
                 result.back().promoted = asset(it->get().promoted_balance, SCORUM_SYMBOL);
             }
             catch (const fc::exception& e)
@@ -3,6 +3,7 @@
 #include <scorum/protocol/types.hpp>
 #include <scorum/common_api/config_api.hpp>
 
+#include <scorum/chain/services/comment_content.hpp>
 #include <scorum/chain/services/comment_statistic.hpp>
 
 #include <scorum/chain/schema/dynamic_global_property_object.hpp>
@@ -38,9 +39,16 @@ struct comment_api_obj
     {
     }
 
-    comment_api_obj(const scorum::chain::comment_object& o);
+    comment_api_obj(const scorum::chain::comment_object& o, const scorum::chain::comment_content_object& content);
 
     comment_api_obj(const chain::comment_object& o,
+                    const comment_content_service_i&,
+                    const comment_statistic_scr_service_i&,
+                    const comment_statistic_sp_service_i&);
+
+    comment_api_obj(const chain::comment_object& o,
+                    const comment_summary_object& summary,
+                    const comment_content_service_i&,
                     const comment_statistic_scr_service_i&,
                     const comment_statistic_sp_service_i&);
 
@@ -105,6 +113,8 @@ struct comment_api_obj
 
 private:
     void set_comment(const chain::comment_object& o);
+    void set_comment_content(const chain::comment_content_object& content);
+    void set_comment_summary(const chain::comment_content_object& content, const comment_summary_object& summary);
     void set_comment_statistic(const chain::comment_statistic_scr_object& stat);
     void set_comment_statistic(const chain::comment_statistic_sp_object& stat);
     void initialize(const chain::comment_object& o);
@@ -137,9 +147,19 @@ struct tag_api_obj
 struct discussion : public comment_api_obj
 {
     discussion(const chain::comment_object& o,
+               const comment_content_service_i& content,
                const comment_statistic_scr_service_i& stat_scr,
                const comment_statistic_sp_service_i& stat_sp)
-        : comment_api_obj(o, stat_scr, stat_sp)
+        : comment_api_obj(o, content, stat_scr, stat_sp)
+    {
+    }
+
+    discussion(const chain::comment_object& o,
+               const comment_summary_object& summary,
+               const comment_content_service_i& content,
+               const comment_statistic_scr_service_i& stat_scr,
+               const comment_statistic_sp_service_i& stat_sp)
+        : comment_api_obj(o, summary, content, stat_scr, stat_sp)
     {
     }
 
@@ -156,6 +176,7 @@ struct discussion : public comment_api_obj
     asset promoted = asset(0, SCORUM_SYMBOL);
 
     std::vector<vote_state> active_votes;
+    uint32_t active_votes_count = 0;
     std::vector<std::string> replies; ///< author/slug mapping
 
     uint32_t body_length = 0;
@@ -182,6 +203,10 @@ struct discussion_query
 
     /// tags to exclude from selection
     std::set<std::string> exclude_tags;
+
+    /// return the post summaries: the body is cut to TAGS_SUMMARY_BODY_LENGTH bytes and only
+    /// TAGS_SUMMARY_TOP_VOTES votes with the greatest rshares are returned
+    bool summary = false;
 };
 
 struct content_query
@@ -259,6 +284,7 @@ FC_REFLECT_DERIVED(scorum::tags::api::discussion, (scorum::tags::api::comment_ap
                   (pending_payout_scr)
                   (pending_payout_sp)
                   (active_votes)
+                  (active_votes_count)
                   (replies)
                   (promoted)
                   (body_length))
@@ -270,7 +296,8 @@ FC_REFLECT(scorum::tags::api::discussion_query,
           (limit)
           (tags_logical_and)
           (tags)
-          (exclude_tags))
+          (exclude_tags)
+          (summary))
 
 FC_REFLECT(scorum::tags::api::content_query,
           (truncate_body)
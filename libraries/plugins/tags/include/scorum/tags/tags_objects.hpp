@@ -37,6 +37,9 @@ using chainbase::oid;
 #define TAGS_PLUGIN_NAME "tags"
 #define TAG_LENGTH_MAX 24
 
+#define TAGS_SUMMARY_BODY_LENGTH 1024
+#define TAGS_SUMMARY_TOP_VOTES 10
+
 #define TAGS_API_NAME "tags_api"
 
 typedef fc::fixed_utf8_string_24 tag_name_type;
@@ -51,7 +54,8 @@ enum
     tag_stats_object_type,
     peer_stats_object_type,
     author_tag_stats_object_type,
-    category_stats_object_type
+    category_stats_object_type,
+    comment_summary_object_type
 };
 
 /**
@@ -339,6 +343,54 @@ typedef shared_multi_index_container<
     category_stats_index;
 // clanf-format on
 
+struct comment_summary_vote
+{
+    account_name_type voter;
+    uint64_t weight = 0;
+    int64_t rshares = 0;
+    vote_weight_type percent = 0;
+    time_point_sec time;
+};
+
+/**
+ * @brief The comment_summary_object class
+ * Keeps the part of a comment which is too heavy to read for discussion listings: the head of the body and the top
+ * voters. It's maintained on comment and vote operations, so the listings read neither the comment content nor
+ * the vote index.
+ */
+class comment_summary_object : public object<comment_summary_object_type, comment_summary_object>
+{
+public:
+    /// \cond DO_NOT_DOCUMENT
+    CHAINBASE_DEFAULT_DYNAMIC_CONSTRUCTOR(comment_summary_object, (body)(top_votes))
+
+    id_type id;
+    comment_id_type comment;
+
+    /// the first TAGS_SUMMARY_BODY_LENGTH bytes of the body
+    fc::shared_string body;
+    uint32_t body_length = 0;
+
+    uint32_t votes_count = 0;
+
+    /// TAGS_SUMMARY_TOP_VOTES votes with the greatest rshares, sorted by rshares
+    fc::shared_vector<comment_summary_vote> top_votes;
+};
+
+typedef oid<comment_summary_object> comment_summary_id_type;
+
+// clang-format off
+typedef shared_multi_index_container<
+    comment_summary_object,
+    indexed_by<
+        ordered_unique<tag<by_id>,
+                       member<comment_summary_object, comment_summary_id_type, &comment_summary_object::id>>,
+        ordered_unique<tag<by_comment>,
+                       member<comment_summary_object, comment_id_type, &comment_summary_object::comment>>>
+    >
+    comment_summary_index;
+// clang-format on
+
 /**
  * Used to parse the metadata from the comment json_meta field.
  */
@@ -460,4 +512,21 @@ FC_REFLECT(scorum::tags::category_stats_object,
 
 CHAINBASE_SET_INDEX_TYPE(scorum::tags::category_stats_object, scorum::tags::category_stats_index)
 
+FC_REFLECT(scorum::tags::comment_summary_vote,
+           (voter)
+           (weight)
+           (rshares)
+           (percent)
+           (time))
+
+FC_REFLECT(scorum::tags::comment_summary_object,
+           (id)
+           (comment)
+           (body)
+           (body_length)
+           (votes_count)
+           (top_votes))
+
+CHAINBASE_SET_INDEX_TYPE(scorum::tags::comment_summary_object, scorum::tags::comment_summary_index)
+
 // clang-format on
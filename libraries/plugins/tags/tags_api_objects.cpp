@@ -6,17 +6,33 @@ namespace scorum {
 namespace tags {
 namespace api {
 
-comment_api_obj::comment_api_obj(const chain::comment_object& o)
+comment_api_obj::comment_api_obj(const chain::comment_object& o, const chain::comment_content_object& content)
 {
     set_comment(o);
+    set_comment_content(content);
     initialize(o);
 }
 
 comment_api_obj::comment_api_obj(const chain::comment_object& o,
+                                 const comment_content_service_i& content_service,
                                  const comment_statistic_scr_service_i& statistic_scr_service,
                                  const comment_statistic_sp_service_i& statistic_sp_service)
 {
     set_comment(o);
+    set_comment_content(content_service.get(o.id));
+    set_comment_statistic(statistic_scr_service.get(o.id));
+    set_comment_statistic(statistic_sp_service.get(o.id));
+    initialize(o);
+}
+
+comment_api_obj::comment_api_obj(const chain::comment_object& o,
+                                 const comment_summary_object& summary,
+                                 const comment_content_service_i& content_service,
+                                 const comment_statistic_scr_service_i& statistic_scr_service,
+                                 const comment_statistic_sp_service_i& statistic_sp_service)
+{
+    set_comment(o);
+    set_comment_summary(content_service.get(o.id), summary);
     set_comment_statistic(statistic_scr_service.get(o.id));
     set_comment_statistic(statistic_sp_service.get(o.id));
     initialize(o);
@@ -30,9 +46,6 @@ void comment_api_obj::set_comment(const chain::comment_object& o)
     parent_permlink = fc::to_string(o.parent_permlink);
     author = o.author;
     permlink = fc::to_string(o.permlink);
-    title = fc::to_string(o.title);
-    body = fc::to_string(o.body);
-    json_metadata = fc::to_string(o.json_metadata);
     last_update = o.last_update;
     created = o.created;
     active = o.active;
@@ -53,6 +66,21 @@ void comment_api_obj::set_comment(const chain::comment_object& o)
     allow_curation_rewards = o.allow_curation_rewards;
 }
 
+void comment_api_obj::set_comment_content(const chain::comment_content_object& content)
+{
+    title = fc::to_string(content.title);
+    body = fc::to_string(content.body);
+    json_metadata = fc::to_string(content.json_metadata);
+}
+
+void comment_api_obj::set_comment_summary(const chain::comment_content_object& content,
+                                          const comment_summary_object& summary)
+{
+    title = fc::to_string(content.title);
+    body = fc::to_string(summary.body);
+    json_metadata = fc::to_string(content.json_metadata);
+}
+
 void comment_api_obj::set_comment_statistic(const chain::comment_statistic_scr_object& stat)
 {
     total_payout_scr_value = stat.total_payout_value;
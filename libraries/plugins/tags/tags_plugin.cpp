@@ -12,12 +12,15 @@
 #include <scorum/chain/schema/comment_objects.hpp>
 #include <scorum/chain/services/account.hpp>
 #include <scorum/chain/services/comment.hpp>
+#include <scorum/chain/services/comment_content.hpp>
+#include <scorum/chain/services/comment_vote.hpp>
 #include <scorum/utils/string_algorithm.hpp>
 
 #include <fc/smart_ref_impl.hpp>
 #include <fc/thread/thread.hpp>
 #include <fc/io/json.hpp>
 #include <fc/string.hpp>
+#include <fc/utf8.hpp>
 
 #include <boost/range/iterator_range.hpp>
 #include <boost/range/adaptor/filtered.hpp>
@@ -134,6 +137,116 @@ public:
     }
 };
 
+class comment_summary_service : public scorum::chain::dbs_base
+{
+    friend class chain::dbservice_dbs_factory;
+
+public:
+    explicit comment_summary_service(database& db)
+        : _base_type(db)
+    {
+    }
+
+    void update_content(const comment_object& comment, const comment_content_object& content)
+    {
+        const auto body_length = std::min<size_t>(content.body.size(), TAGS_SUMMARY_BODY_LENGTH);
+
+        std::string body(content.body.data(), body_length);
+        if (!fc::is_utf8(body))
+            body = fc::prune_invalid_utf8(body);
+
+        db_impl().modify(obtain(comment), [&](comment_summary_object& s) {
+            fc::from_string(s.body, body);
+            s.body_length = content.body.size();
+        });
+    }
+
+    void update_vote(const comment_object& comment, const comment_vote_object& vote, const account_name_type& voter)
+    {
+        comment_summary_vote summary_vote;
+        summary_vote.voter = voter;
+        summary_vote.weight = vote.weight;
+        summary_vote.rshares = vote.rshares.value;
+        summary_vote.percent = vote.vote_percent;
+        summary_vote.time = vote.last_update;
+
+        const auto& summary = obtain(comment);
+
+        std::vector<comment_summary_vote> top_votes(summary.top_votes.begin(), summary.top_votes.end());
+
+        auto it = std::find_if(top_votes.begin(), top_votes.end(),
+                               [&](const comment_summary_vote& v) { return v.voter == voter; });
+
+        // a changed vote can leave the top, the next one is known from the vote index only
+        if (it != top_votes.end() && top_votes.size() == TAGS_SUMMARY_TOP_VOTES && it->rshares > summary_vote.rshares)
+        {
+            top_votes = get_top_votes(comment);
+        }
+        else
+        {
+            if (it != top_votes.end())
+                top_votes.erase(it);
+
+            top_votes.insert(std::upper_bound(top_votes.begin(), top_votes.end(), summary_vote, greater_rshares),
+                             summary_vote);
+            if (top_votes.size() > TAGS_SUMMARY_TOP_VOTES)
+                top_votes.pop_back();
+        }
+
+        db_impl().modify(summary, [&](comment_summary_object& s) {
+            // the first vote of the voter, changed votes have num_changes > 0
+            if (vote.num_changes == 0)
+                ++s.votes_count;
+            s.top_votes.assign(top_votes.begin(), top_votes.end());
+        });
+    }
+
+    void remove(const comment_object& comment)
+    {
+        const auto* summary = db_impl().find<comment_summary_object, by_comment>(comment.id);
+        if (summary != nullptr)
+            db_impl().remove(*summary);
+    }
+
+private:
+    static bool greater_rshares(const comment_summary_vote& lhs, const comment_summary_vote& rhs)
+    {
+        return lhs.rshares > rhs.rshares;
+    }
+
+    const comment_summary_object& obtain(const comment_object& comment)
+    {
+        const auto* summary = db_impl().find<comment_summary_object, by_comment>(comment.id);
+        if (summary != nullptr)
+            return *summary;
+
+        return db_impl().create<comment_summary_object>([&](comment_summary_object& s) { s.comment = comment.id; });
+    }
+
+    std::vector<comment_summary_vote> get_top_votes(const comment_object& comment)
+    {
+        std::vector<comment_summary_vote> votes;
+
+        const auto& idx = db_impl().get_index<comment_vote_index, by_comment_voter>();
+        for (auto it = idx.lower_bound(comment.id); it != idx.end() && it->comment == comment.id; ++it)
+        {
+            comment_summary_vote v;
+            v.voter = db_impl().get<account_object>(it->voter).name;
+            v.weight = it->weight;
+            v.rshares = it->rshares.value;
+            v.percent = it->vote_percent;
+            v.time = it->last_update;
+            votes.push_back(v);
+        }
+
+        const auto top_size = std::min<size_t>(votes.size(), TAGS_SUMMARY_TOP_VOTES);
+        std::partial_sort(votes.begin(), votes.begin() + top_size, votes.end(), greater_rshares);
+        votes.resize(top_size);
+
+        return votes;
+    }
+};
+
 struct category_stats_pre_operation_visitor
 {
     database& _db;
@@ -147,18 +260,21 @@ struct category_stats_pre_operation_visitor
 
     void operator()(const comment_operation& op) const
     {
-        const comment_object* c
-            = _db.obtain_service<dbs_comment>().find_by<by_permlink>(std::make_tuple(op.author, op.permlink));
+        const comment_object* c = _db.obtain_service<dbs_comment>().find(op.author, op.permlink);
 
         if (c != nullptr)
-            _category_stats_service.exclude_from_category_stats(comment_metadata::parse(c->json_metadata));
+        {
+            const auto& content = _db.obtain_service<dbs_comment_content>().get(c->id);
+            _category_stats_service.exclude_from_category_stats(comment_metadata::parse(content.json_metadata));
+        }
     }
 
     void operator()(const delete_comment_operation& op) const
     {
         const comment_object& c = _db.obtain_service<dbs_comment>().get(op.author, op.permlink);
+        const auto& content = _db.obtain_service<dbs_comment_content>().get(c.id);
 
-        _category_stats_service.exclude_from_category_stats(comment_metadata::parse(c.json_metadata));
+        _category_stats_service.exclude_from_category_stats(comment_metadata::parse(content.json_metadata));
     }
 
     template <typename Op> void operator()(Op&&) const
@@ -180,8 +296,66 @@ struct category_stats_post_operation_visitor
     void operator()(const comment_operation& op) const
     {
         const comment_object& c = _db.obtain_service<dbs_comment>().get(op.author, op.permlink);
+        const auto& content = _db.obtain_service<dbs_comment_content>().get(c.id);
+
+        _category_stats_service.include_into_category_stats(comment_metadata::parse(content.json_metadata));
+    }
+
+    template <typename Op> void operator()(Op&&) const
+    {
+    } /// ignore all other ops
+};
+
+struct comment_summary_pre_operation_visitor
+{
+    database& _db;
+    comment_summary_service& _comment_summary_service;
+
+    comment_summary_pre_operation_visitor(database& db)
+        : _db(db)
+        , _comment_summary_service(_db.obtain_service<comment_summary_service>())
+    {
+    }
+
+    void operator()(const delete_comment_operation& op) const
+    {
+        const comment_object* c = _db.obtain_service<dbs_comment>().find(op.author, op.permlink);
+
+        if (c != nullptr)
+            _comment_summary_service.remove(*c);
+    }
+
+    template <typename Op> void operator()(Op&&) const
+    {
+    } /// ignore all other ops
+};
+
+struct comment_summary_post_operation_visitor
+{
+    database& _db;
+    comment_summary_service& _comment_summary_service;
+
+    comment_summary_post_operation_visitor(database& db)
+        : _db(db)
+        , _comment_summary_service(_db.obtain_service<comment_summary_service>())
+    {
+    }
+
+    void operator()(const comment_operation& op) const
+    {
+        const comment_object& c = _db.obtain_service<dbs_comment>().get(op.author, op.permlink);
+        const auto& content = _db.obtain_service<dbs_comment_content>().get(c.id);
+
+        _comment_summary_service.update_content(c, content);
+    }
+
+    void operator()(const vote_operation& op) const
+    {
+        const comment_object& c = _db.obtain_service<dbs_comment>().get(op.author, op.permlink);
+        const auto& voter = _db.account_service().get_account(op.voter);
+        const auto& vote = _db.obtain_service<dbs_comment_vote>().get(c.id, voter.id);
 
-        _category_stats_service.include_into_category_stats(comment_metadata::parse(c.json_metadata));
+        _comment_summary_service.update_vote(c, vote, voter.name);
     }
 
     template <typename Op> void operator()(Op&&) const
@@ -362,7 +536,8 @@ struct post_operation_visitor
 
             if (parse_tags)
             {
-                auto tags = collect_tags(comment_metadata::parse(c.json_metadata));
+                const auto& content = _db.obtain_service<dbs_comment_content>().get(c.id);
+                auto tags = collect_tags(comment_metadata::parse(content.json_metadata));
                 auto citr = comment_idx.lower_bound(c.id);
 
                 std::map<std::string, const tag_object*> existing_tags;
@@ -511,7 +686,8 @@ struct post_operation_visitor
 
         update_tags(comment);
 
-        auto tags = collect_tags(comment_metadata::parse(comment.json_metadata));
+        const auto& content = _db.obtain_service<dbs_comment_content>().get(comment.id);
+        auto tags = collect_tags(comment_metadata::parse(content.json_metadata));
 
         for (const std::string& tag : tags)
         {
@@ -547,6 +723,7 @@ void tags_plugin_impl::pre_operation(const operation_notification& note)
     {
         /// plugins shouldn't ever throw
         note.op.visit(category_stats_pre_operation_visitor(database()));
+        note.op.visit(comment_summary_pre_operation_visitor(database()));
     }
     catch (const fc::exception& e)
     {
@@ -565,6 +742,7 @@ void tags_plugin_impl::post_operation(const operation_notification& note)
         /// plugins shouldn't ever throw
         note.op.visit(post_operation_visitor(database()));
         note.op.visit(category_stats_post_operation_visitor(database()));
+        note.op.visit(comment_summary_post_operation_visitor(database()));
     }
     catch (const fc::exception& e)
     {
@@ -614,6 +792,7 @@ void tags_plugin::plugin_initialize(const boost::program_options::variables_map&
         db.add_plugin_index<peer_stats_index>();
         db.add_plugin_index<author_tag_stats_index>();
         db.add_plugin_index<category_stats_index>();
+        db.add_plugin_index<comment_summary_index>();
 
         get_api_config(TAGS_API_NAME).set_options(options);
     }
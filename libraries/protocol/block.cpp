@@ -70,7 +70,10 @@ checksum_type signed_block::calculate_merkle_root() const
 }
 }
 
-block_info::block_info(uint32_t block_num, std::string block_id, fc::time_point_sec when, std::string block_witness)
+block_info::block_info(uint32_t block_num,
+                       const scorum::protocol::block_id_type& block_id,
+                       fc::time_point_sec when,
+                       const std::string& block_witness)
     : _block_num(block_num)
     , _block_id(block_id)
     , _when(when)
@@ -79,8 +82,13 @@ block_info::block_info(uint32_t block_num, std::string block_id, fc::time_point_
 }
 
 block_info::block_info(const scorum::protocol::signed_block& block)
-    : _block_num(block.block_num())
-    , _block_id(block.id().str())
+    : block_info(block, block.id())
+{
+}
+
+block_info::block_info(const scorum::protocol::signed_block& block, const scorum::protocol::block_id_type& block_id)
+    : _block_num(scorum::protocol::block_header::num_from_id(block_id))
+    , _block_id(block_id)
     , _when(block.timestamp)
     , _block_witness(block.witness)
 {
@@ -95,7 +103,7 @@ block_info::block_info(const fc::time_point_sec& when, const std::string& witnes
 block_info::operator std::string() const
 {
     std::stringstream store;
-    store << _block_num << ":" << _block_id << "|";
+    store << _block_num << ":" << _block_id.str() << "|";
     store << _when.to_iso_string() << "~" << _block_witness;
     return store.str();
 }
@@ -14,22 +14,32 @@ struct signed_block : public signed_block_header
 };
 }
 
-// use for context in logs
+// use for context in logs, it is formatted to string only when a record is actually written
 class block_info
 {
 public:
-    block_info(uint32_t block_num, std::string block_id, fc::time_point_sec when, std::string block_witness);
+    block_info(uint32_t block_num,
+               const scorum::protocol::block_id_type& block_id,
+               fc::time_point_sec when,
+               const std::string& block_witness);
     block_info(const scorum::protocol::signed_block&);
+    /// doesn't hash the block header again when the id is already known
+    block_info(const scorum::protocol::signed_block&, const scorum::protocol::block_id_type&);
     block_info(const fc::time_point_sec& when, const std::string& witness_owner);
     block_info()
     {
     }
 
+    uint32_t block_num() const
+    {
+        return _block_num;
+    }
+
     operator std::string() const;
 
 private:
     uint32_t _block_num = 0;
-    std::string _block_id = scorum::protocol::digest_type().str();
+    scorum::protocol::block_id_type _block_id;
     fc::time_point_sec _when;
     std::string _block_witness = "?";
 };
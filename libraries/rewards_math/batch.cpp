@@ -0,0 +1,149 @@
+#include <scorum/rewards_math/batch.hpp>
+#include <scorum/rewards_math/curve.hpp>
+
+#include <limits>
+
+namespace scorum {
+namespace rewards_math {
+
+using scorum::protocol::share_value_type;
+
+namespace {
+
+const uint64_t max_share_value = uint64_t(std::numeric_limits<share_value_type>::max());
+
+inline u256 to256(const uint128_t& t)
+{
+    u256 v(t.hi);
+    v <<= 64;
+    v += t.lo;
+    return v;
+}
+
+template <typename Curve> claims_vector_type evaluate_claims(const shares_vector_type& vrshares, Curve&& curve)
+{
+    claims_vector_type claims;
+    claims.reserve(vrshares.size());
+
+    for (const share_type& rshares : vrshares)
+        claims.push_back(curve(uint128_t(rshares.value)));
+
+    return claims;
+}
+
+/// a * b / c, the u256 arithmetic is used only if the product doesn't fit into 128 bits
+share_value_type mul_div(uint64_t a, const uint128_t& b, const uint128_t& c, const u256& c256)
+{
+    if (b.hi == 0)
+    {
+        uint128_t result;
+        if (c.hi == 0 && (a == 0 || b.lo <= std::numeric_limits<uint64_t>::max() / a))
+            result = a * b.lo / c.lo;
+        else
+            result = uint128_t(a) * b.lo / c;
+
+        FC_ASSERT(result.hi == 0 && result.lo <= max_share_value);
+        return static_cast<share_value_type>(result.lo);
+    }
+
+    u256 result = u256(a) * to256(b) / c256;
+    FC_ASSERT(result <= u256(max_share_value));
+    return static_cast<share_value_type>(result);
+}
+}
+
+claims_vector_type evaluate_reward_curve(const shares_vector_type& vrshares, const curve_id author_reward_curve)
+{
+    switch (author_reward_curve)
+    {
+    case curve_id::quadratic:
+        return evaluate_claims(vrshares, [](const uint128_t& r) { return r * r; });
+    case curve_id::linear:
+        return evaluate_claims(vrshares, [](const uint128_t& r) { return r; });
+    case curve_id::square_root:
+        return evaluate_claims(vrshares, [](const uint128_t& r) { return uint128_t(approx_sqrt(r)); });
+    case curve_id::power1dot5:
+        return evaluate_claims(vrshares, [](const uint128_t& r) { return uint128_t(approx_sqrt(r * r * r)); });
+    }
+
+    return claims_vector_type(vrshares.size(), uint128_t(0));
+}
+
+uint128_t calculate_total_claims(const uint128_t& recent_claims, const claims_vector_type& claims)
+{
+    uint128_t total_claims = recent_claims;
+
+    for (const uint128_t& claim : claims)
+        total_claims += claim;
+
+    return total_claims;
+}
+
+shares_vector_type calculate_payouts(const shares_vector_type& vrshares,
+                                     const claims_vector_type& claims,
+                                     const uint128_t& total_claims,
+                                     const share_type& reward_fund,
+                                     const shares_vector_type& max_shares,
+                                     const share_type& min_comment_payout_share)
+{
+    try
+    {
+        FC_ASSERT(claims.size() == vrshares.size(), "claims count and rshares count should be equal");
+        FC_ASSERT(claims.size() == max_shares.size(), "claims count and max shares count should be equal");
+        FC_ASSERT(total_claims > 0);
+        FC_ASSERT(reward_fund >= 0);
+
+        const u256 total_claims_256 = to256(total_claims);
+
+        shares_vector_type payouts;
+        payouts.reserve(claims.size());
+
+        for (size_t i = 0; i < claims.size(); ++i)
+        {
+            // the precondition of the scalar formula, the claim can't be checked instead as the curve can give zero
+            // for positive rshares
+            FC_ASSERT(vrshares[i] > 0);
+
+            share_value_type payout = mul_div(reward_fund.value, claims[i], total_claims, total_claims_256);
+            if (payout < min_comment_payout_share.value)
+                payout = 0;
+
+            payouts.push_back(std::min(payout, max_shares[i].value));
+        }
+
+        return payouts;
+    }
+    FC_CAPTURE_AND_RETHROW((total_claims)(reward_fund)(min_comment_payout_share))
+}
+
+shares_vector_type calculate_curation_payouts(const share_type& curations_payout,
+                                              const uint64_t total_weight,
+                                              const weights_vector_type& weights)
+{
+    try
+    {
+        FC_ASSERT(total_weight > 0u);
+        FC_ASSERT(curations_payout >= 0);
+
+        // the weights are not greater than the total weight, so the product fits into 64 bits for the most of votes
+        const uint64_t payout = static_cast<uint64_t>(curations_payout.value);
+        const uint64_t max_weight = payout ? std::numeric_limits<uint64_t>::max() / payout
+                                           : std::numeric_limits<uint64_t>::max();
+
+        shares_vector_type payouts;
+        payouts.reserve(weights.size());
+
+        for (const uint64_t weight : weights)
+        {
+            if (weight <= max_weight)
+                payouts.push_back(static_cast<share_value_type>(payout * weight / total_weight));
+            else
+                payouts.push_back(static_cast<share_value_type>((uint128_t(weight) * payout / total_weight).to_uint64()));
+        }
+
+        return payouts;
+    }
+    FC_CAPTURE_AND_RETHROW((curations_payout)(total_weight))
+}
+}
+}
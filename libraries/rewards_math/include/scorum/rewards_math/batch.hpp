@@ -0,0 +1,44 @@
+#pragma once
+
+#include <scorum/rewards_math/formulas.hpp>
+
+#include <fc/uint128.hpp>
+
+#include <vector>
+
+namespace scorum {
+namespace rewards_math {
+
+using fc::uint128_t;
+
+using claims_vector_type = std::vector<uint128_t>;
+using weights_vector_type = std::vector<uint64_t>;
+
+/**
+ * Batch versions of the cashout formulas.
+ *
+ * They give the same results and reject the same arguments as the scalar formulas applied to every element, but
+ * dispatch the reward curve once per batch, evaluate every claim once and keep the intermediate values in 64 or 128
+ * bits when they fit.
+ */
+
+/// reward curve values of every rshares, the same as evaluate_reward_curve per element
+claims_vector_type evaluate_reward_curve(const shares_vector_type& vrshares, const curve_id author_reward_curve);
+
+/// the same as calculate_total_claims over the rshares the claims were evaluated from
+uint128_t calculate_total_claims(const uint128_t& recent_claims, const claims_vector_type& claims);
+
+/// the same as calculate_payout per comment, 'claims' are the reward curve values of 'vrshares'
+shares_vector_type calculate_payouts(const shares_vector_type& vrshares,
+                                     const claims_vector_type& claims,
+                                     const uint128_t& total_claims,
+                                     const share_type& reward_fund,
+                                     const shares_vector_type& max_shares,
+                                     const share_type& min_comment_payout_share);
+
+/// the same as calculate_curation_payout per vote weight
+shares_vector_type calculate_curation_payouts(const share_type& curations_payout,
+                                              const uint64_t total_weight,
+                                              const weights_vector_type& weights);
+}
+}
@@ -10,6 +10,8 @@ namespace rewards_math {
 using scorum::protocol::curve_id;
 using fc::uint128_t;
 
+uint64_t approx_sqrt(const uint128_t& x);
+
 uint128_t evaluate_reward_curve(const uint128_t& rshares, const curve_id& curve);
 
 } // namespace rewards_math
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <fc/crypto/city.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace scorum {
+namespace utils {
+
+/**
+ * @brief Probabilistic set membership test
+ *
+ * 'may_contain' never gives false negatives, so it is used in front of index lookups to skip them for items that
+ * were never inserted. Items cannot be removed, the filter should be cleared and filled again instead.
+ */
+class bloom_filter
+{
+public:
+    /// ~1% false positives for 'expected_items' with default 'bits_per_item'
+    explicit bloom_filter(size_t expected_items, uint32_t bits_per_item = 10)
+        : _bits(std::max<size_t>(expected_items * bits_per_item / 64, 1u))
+        , _hashes_count(std::max<uint32_t>(bits_per_item * 69 / 100, 1u)) // bits_per_item * ln(2)
+        , _capacity(expected_items)
+    {
+    }
+
+    void insert(const char* data, size_t size)
+    {
+        for_each_bit(data, size, [this](size_t bit) {
+            _bits[bit / 64] |= uint64_t(1) << (bit % 64);
+            return true;
+        });
+        ++_size;
+    }
+
+    bool may_contain(const char* data, size_t size) const
+    {
+        return for_each_bit(data, size,
+                            [this](size_t bit) { return (_bits[bit / 64] & (uint64_t(1) << (bit % 64))) != 0; });
+    }
+
+    /// for trivially copyable types without padding only
+    template <typename T> void insert(const T& item)
+    {
+        insert((const char*)&item, sizeof(item));
+    }
+
+    template <typename T> bool may_contain(const T& item) const
+    {
+        return may_contain((const char*)&item, sizeof(item));
+    }
+
+    void clear()
+    {
+        std::fill(_bits.begin(), _bits.end(), 0u);
+        _size = 0;
+    }
+
+    /// number of inserts, duplicates are counted too
+    size_t size() const
+    {
+        return _size;
+    }
+
+    size_t capacity() const
+    {
+        return _capacity;
+    }
+
+private:
+    // double hashing: i-th hash is h1 + i * h2
+    template <typename Fn> bool for_each_bit(const char* data, size_t size, Fn&& fn) const
+    {
+        const uint64_t h1 = fc::city_hash64(data, size);
+        const uint64_t h2 = ((h1 >> 32) | (h1 << 32)) | 1u;
+        const size_t bits_count = _bits.size() * 64;
+
+        for (uint32_t i = 0; i < _hashes_count; ++i)
+        {
+            if (!fn((h1 + i * h2) % bits_count))
+                return false;
+        }
+
+        return true;
+    }
+
+    std::vector<uint64_t> _bits;
+    uint32_t _hashes_count;
+    size_t _capacity;
+    size_t _size = 0;
+};
+}
+}
@@ -0,0 +1,68 @@
+#include <scorum/chain/block_log.hpp>
+
+#include <fc/exception/exception.hpp>
+
+#include <boost/lexical_cast.hpp>
+
+#include <iostream>
+#include <string>
+
+// copies a block log converting it to the compressed format or back to the raw one
+int main(int argc, char** argv, char** envp)
+{
+    const std::string mode = argc > 1 ? argv[1] : "";
+    if (!((mode == "compress" && (argc == 4 || argc == 5)) || (mode == "decompress" && argc == 4)))
+    {
+        std::cerr << "Usage: " << argv[0] << " compress <block_log> <new_block_log> [blocks_per_chunk]\n"
+                  << "       " << argv[0] << " decompress <block_log> <new_block_log>" << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        using scorum::chain::block_log;
+
+        const fc::path input_file(argv[2]);
+        const fc::path output_file(argv[3]);
+
+        FC_ASSERT(fc::exists(input_file), "Block log ${f} doesn't exist", ("f", input_file));
+        FC_ASSERT(!fc::exists(output_file), "Block log ${f} already exists", ("f", output_file));
+
+        block_log input;
+        input.open(input_file);
+        FC_ASSERT(input.head().valid(), "Block log ${f} is empty", ("f", input_file));
+        // a compressed log can't be pruned, so it has to start from the first block
+        FC_ASSERT(input.first_block_num() == 1, "Block log ${f} is pruned before block ${n}, it can't be converted",
+                  ("f", input_file)("n", input.first_block_num()));
+
+        if (mode == "compress")
+        {
+            block_log::create_compressed(output_file, argc == 5 ? boost::lexical_cast<uint32_t>(argv[4])
+                                                                : block_log::default_blocks_per_chunk);
+        }
+
+        block_log output;
+        output.open(output_file);
+
+        const uint32_t head_num = input.head()->block_num();
+        uint64_t pos = input.get_block_pos(1);
+        for (uint32_t num = 1; num <= head_num; ++num)
+        {
+            auto block = input.read_block(pos);
+            output.append(block.first);
+            pos = block.second;
+
+            if (num % 100000 == 0 || num == head_num)
+                std::cout << num << " of " << head_num << " blocks" << std::endl;
+        }
+
+        output.flush();
+    }
+    catch (const fc::exception& e)
+    {
+        std::cerr << e.to_detail_string() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,27 @@
+#include <scorum/chain/database/debug_trace.hpp>
+
+#include <fc/exception/exception.hpp>
+
+#include <iostream>
+
+// prints the binary debug trace of a node (see 'debug-trace-size' option), the oldest record first
+int main(int argc, char** argv, char** envp)
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <data_dir/blockchain/debug_trace>" << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        scorum::chain::debug_trace::dump(fc::path(argv[1]), std::cout);
+    }
+    catch (const fc::exception& e)
+    {
+        std::cerr << e.to_detail_string() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include <boost/test/unit_test.hpp>
+
+#include <scorum/app/block_ids.hpp>
+
+#include <graphene/net/exceptions.hpp>
+
+#include "database_trx_integration.hpp"
+
+namespace block_ids_tests {
+
+using namespace scorum;
+using namespace scorum::chain;
+using namespace scorum::protocol;
+
+struct pruned_block_log_fixture : public database_fixture::database_trx_integration_fixture
+{
+    pruned_block_log_fixture()
+    {
+        db.set_block_log_prune_blocks(5);
+
+        open_database();
+
+        for (uint32_t num = 1; num <= db.head_block_num(); ++num)
+            ids.push_back(db.get_block_id_for_num(num));
+
+        // the log is pruned in background, the cut is applied by one of the next appends
+        for (int i = 0; i < 100 && db.first_available_block_num() < 3; ++i)
+        {
+            generate_block();
+            ids.push_back(db.head_block_id());
+            fc::usleep(fc::milliseconds(1));
+        }
+
+        BOOST_REQUIRE_GT(db.first_available_block_num(), 2u);
+    }
+
+    std::vector<block_id_type> get_block_ids(const std::vector<block_id_type>& synopsis)
+    {
+        uint32_t remaining_item_count = 0;
+        return app::get_block_ids(db, synopsis, remaining_item_count, 1000);
+    }
+
+    /// ids of generated blocks, ids[n - 1] is the id of the block n
+    std::vector<block_id_type> ids;
+};
+}
+
+BOOST_FIXTURE_TEST_SUITE(block_ids_tests, block_ids_tests::pruned_block_log_fixture)
+
+SCORUM_TEST_CASE(empty_synopsis_is_refused_by_pruned_node)
+{
+    SCORUM_REQUIRE_THROW(get_block_ids({}), graphene::net::peer_is_on_an_unreachable_fork);
+    SCORUM_REQUIRE_THROW(get_block_ids({ block_id_type() }), graphene::net::peer_is_on_an_unreachable_fork);
+}
+
+SCORUM_TEST_CASE(synopsis_of_pruned_blocks_is_refused)
+{
+    const std::vector<block_id_type> synopsis{ ids[0], ids[1] };
+
+    SCORUM_REQUIRE_THROW(get_block_ids(synopsis), graphene::net::peer_is_on_an_unreachable_fork);
+}
+
+SCORUM_TEST_CASE(ids_start_from_last_available_block_of_synopsis)
+{
+    const uint32_t first_num = db.first_available_block_num();
+    const std::vector<block_id_type> synopsis{ ids[0], ids[first_num - 1] };
+
+    const auto result = get_block_ids(synopsis);
+
+    BOOST_REQUIRE_EQUAL(result.size(), db.head_block_num() - first_num + 1);
+    for (uint32_t i = 0; i < result.size(); ++i)
+        BOOST_CHECK(result[i] == ids[first_num - 1 + i]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -396,6 +396,140 @@ BOOST_AUTO_TEST_CASE(duplicate_transactions)
     }
 }
 
+BOOST_AUTO_TEST_CASE(pending_transactions_revalidated_in_batches)
+{
+    try
+    {
+        fc::temp_directory dir1(graphene::utilities::temp_directory_path());
+        fc::temp_directory dir2(graphene::utilities::temp_directory_path());
+
+        database db1(database::opt_default);
+        db_setup_and_open(db1, dir1.path());
+        database db2(database::opt_default);
+        db_setup_and_open(db2, dir2.path());
+
+        db1.set_pending_revalidation_batch(1);
+
+        auto init_account_priv_key = fc::ecc::private_key::regenerate(fc::sha256::hash(std::string(TEST_INIT_KEY)));
+        public_key_type init_account_pub_key = init_account_priv_key.get_public_key();
+
+        std::vector<signed_transaction> trxs;
+        for (const auto& name : { "alice", "bob", "sam" })
+        {
+            signed_transaction trx;
+            account_create_operation cop;
+            cop.new_account_name = name;
+            cop.creator = TEST_INIT_DELEGATE_NAME;
+            cop.owner = authority(1, init_account_pub_key, 1);
+            cop.active = cop.owner;
+            cop.fee = SUFFICIENT_FEE;
+            trx.operations.push_back(cop);
+            trx.set_expiration(db1.head_block_time() + SCORUM_MAX_TIME_UNTIL_EXPIRATION);
+            trx.sign(init_account_priv_key, db1.get_chain_id());
+            PUSH_TX(db1, trx);
+            trxs.push_back(trx);
+        }
+
+        BOOST_REQUIRE_EQUAL(db1.pending_transactions().size(), 3u);
+        BOOST_REQUIRE_EQUAL(db1.pending_transactions().applied_count(), 3u);
+
+        // the block includes 'alice' only
+        PUSH_TX(db2, trxs[0]);
+        auto b = db2.generate_block(db2.get_slot_time(1), db2.get_scheduled_witness(1), init_account_priv_key,
+                                    database::skip_nothing);
+        db1.push_block(b);
+
+        // 'alice' is dropped as included, 'bob' is revalidated with the block, 'sam' waits
+        BOOST_CHECK_EQUAL(db1.pending_transactions().size(), 2u);
+        BOOST_CHECK_EQUAL(db1.pending_transactions().applied_count(), 1u);
+        BOOST_CHECK(db1.account_service().is_exists("bob"));
+        BOOST_CHECK(!db1.account_service().is_exists("sam"));
+
+        BOOST_CHECK(!db1.revalidate_pending_transactions(0));
+        BOOST_CHECK_EQUAL(db1.pending_transactions().applied_count(), 2u);
+        BOOST_CHECK(db1.account_service().is_exists("sam"));
+
+        b = db1.generate_block(db1.get_slot_time(1), db1.get_scheduled_witness(1), init_account_priv_key,
+                               database::skip_nothing);
+        BOOST_CHECK_EQUAL(b.transactions.size(), 2u);
+    }
+    catch (fc::exception& e)
+    {
+        edump((e.to_detail_string()));
+        throw;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(new_transaction_is_applied_after_pending_ones)
+{
+    try
+    {
+        fc::temp_directory dir1(graphene::utilities::temp_directory_path());
+        fc::temp_directory dir2(graphene::utilities::temp_directory_path());
+
+        database db1(database::opt_default);
+        db_setup_and_open(db1, dir1.path());
+        database db2(database::opt_default);
+        db_setup_and_open(db2, dir2.path());
+
+        db1.set_pending_revalidation_batch(1);
+
+        auto init_account_priv_key = fc::ecc::private_key::regenerate(fc::sha256::hash(std::string(TEST_INIT_KEY)));
+        public_key_type init_account_pub_key = init_account_priv_key.get_public_key();
+
+        std::vector<signed_transaction> trxs;
+        for (const auto& name : { "alice", "bob", "sam", "dave" })
+        {
+            signed_transaction trx;
+            account_create_operation cop;
+            cop.new_account_name = name;
+            cop.creator = TEST_INIT_DELEGATE_NAME;
+            cop.owner = authority(1, init_account_pub_key, 1);
+            cop.active = cop.owner;
+            cop.fee = SUFFICIENT_FEE;
+            trx.operations.push_back(cop);
+            trx.set_expiration(db1.head_block_time() + SCORUM_MAX_TIME_UNTIL_EXPIRATION);
+            trx.sign(init_account_priv_key, db1.get_chain_id());
+            trxs.push_back(trx);
+        }
+
+        for (size_t i = 0; i < 3; ++i)
+            PUSH_TX(db1, trxs[i]);
+
+        // the block includes 'alice' only, 'bob' is revalidated with it and 'sam' waits
+        PUSH_TX(db2, trxs[0]);
+        auto b = db2.generate_block(db2.get_slot_time(1), db2.get_scheduled_witness(1), init_account_priv_key,
+                                    database::skip_nothing);
+        db1.push_block(b);
+
+        BOOST_REQUIRE_EQUAL(db1.pending_transactions().applied_count(), 1u);
+        BOOST_REQUIRE(!db1.pending_transactions().contains(trxs[0].id()));
+
+        // 'sam' is applied before 'dave'
+        PUSH_TX(db1, trxs[3]);
+
+        BOOST_CHECK_EQUAL(db1.pending_transactions().applied_count(), 3u);
+
+        std::vector<transaction_id_type> ids;
+        for (const auto& pending : db1.pending_transactions())
+            ids.push_back(pending.id);
+
+        const std::vector<transaction_id_type> expected = { trxs[1].id(), trxs[2].id(), trxs[3].id() };
+        BOOST_CHECK(ids == expected);
+
+        b = db1.generate_block(db1.get_slot_time(1), db1.get_scheduled_witness(1), init_account_priv_key,
+                               database::skip_nothing);
+        BOOST_REQUIRE_EQUAL(b.transactions.size(), 3u);
+        for (size_t i = 0; i < 3; ++i)
+            BOOST_CHECK(b.transactions[i].id() == expected[i]);
+    }
+    catch (fc::exception& e)
+    {
+        edump((e.to_detail_string()));
+        throw;
+    }
+}
+
 BOOST_AUTO_TEST_CASE(tapos)
 {
     try
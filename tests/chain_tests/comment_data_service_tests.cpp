@@ -0,0 +1,86 @@
+#include <boost/test/unit_test.hpp>
+
+#include <scorum/chain/schema/comment_objects.hpp>
+#include <scorum/chain/services/comment.hpp>
+
+#include "database_default_integration.hpp"
+
+#include <boost/iterator/indirect_iterator.hpp>
+
+namespace database_fixture {
+
+class comment_data_service_fixture : public database_default_integration_fixture
+{
+public:
+    comment_data_service_fixture()
+        : comment_svc(db.comment_service())
+    {
+    }
+
+    const comment_object& create_comment(const account_name_type& author, const std::string& permlink)
+    {
+        return db.create<comment_object>([&](comment_object& c) {
+            c.author = author;
+            fc::from_string(c.permlink, permlink);
+        });
+    }
+
+    comment_service_i& comment_svc;
+};
+
+} // database_fixture
+
+using namespace scorum::chain;
+using namespace scorum::protocol;
+
+BOOST_FIXTURE_TEST_SUITE(comment_data_service, database_fixture::comment_data_service_fixture)
+
+SCORUM_TEST_CASE(find_by_author_and_permlink)
+{
+    const auto& comment = create_comment("alice", "post");
+
+    BOOST_CHECK(comment_svc.find("alice", "post") == &comment);
+    BOOST_CHECK(&comment_svc.get("alice", std::string("post")) == &comment);
+    BOOST_CHECK(comment_svc.is_exists("alice", std::string("post")));
+
+    BOOST_CHECK(comment_svc.find("alice", "pos") == nullptr);
+    BOOST_CHECK(comment_svc.find("bob", "post") == nullptr);
+    BOOST_CHECK(!comment_svc.is_exists("bob", std::string("post")));
+    SCORUM_REQUIRE_THROW(comment_svc.get("bob", std::string("post")), fc::exception);
+}
+
+SCORUM_TEST_CASE(find_by_same_author_or_permlink)
+{
+    const auto& alice_post = create_comment("alice", "post");
+    const auto& alice_reply = create_comment("alice", "reply");
+    const auto& bob_post = create_comment("bob", "post");
+
+    BOOST_CHECK(comment_svc.find("alice", "post") == &alice_post);
+    BOOST_CHECK(comment_svc.find("alice", "reply") == &alice_reply);
+    BOOST_CHECK(comment_svc.find("bob", "post") == &bob_post);
+    BOOST_CHECK(comment_svc.find("bob", "reply") == nullptr);
+}
+
+SCORUM_TEST_CASE(permlink_hash_separates_author_and_permlink)
+{
+    BOOST_CHECK_NE(comment_permlink_hash("alice", "post"), comment_permlink_hash("alic", "epost"));
+    BOOST_CHECK_EQUAL(comment_permlink_hash("alice", "post"), comment_permlink_hash("alice", std::string("post")));
+}
+
+SCORUM_TEST_CASE(colliding_hashes_are_resolved_by_author_and_permlink)
+{
+    const auto& alice_post = create_comment("alice", "post");
+    const auto& bob_reply = create_comment("bob", "reply");
+
+    // comments found by dbs_comment::find for a hash, as if the hashes of both comments collided
+    const std::vector<const comment_object*> same_hash{ &alice_post, &bob_reply };
+    const auto first = boost::make_indirect_iterator(same_hash.begin());
+    const auto last = boost::make_indirect_iterator(same_hash.end());
+
+    BOOST_CHECK(find_comment_by_permlink(first, last, "alice", "post") == &alice_post);
+    BOOST_CHECK(find_comment_by_permlink(first, last, "bob", "reply") == &bob_reply);
+    BOOST_CHECK(find_comment_by_permlink(first, last, "alice", "reply") == nullptr);
+    BOOST_CHECK(find_comment_by_permlink(first, last, "bob", "post") == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
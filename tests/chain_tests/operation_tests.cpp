@@ -18,6 +18,7 @@
 #include <scorum/chain/services/witness.hpp>
 #include <scorum/chain/services/escrow.hpp>
 #include <scorum/chain/services/comment.hpp>
+#include <scorum/chain/services/comment_content.hpp>
 #include <scorum/chain/services/dynamic_global_property.hpp>
 
 #include <scorum/rewards_math/formulas.hpp>
@@ -465,15 +466,18 @@ BOOST_AUTO_TEST_CASE(comment_apply)
         BOOST_REQUIRE(alice_comment.abs_rshares.value == 0);
         BOOST_REQUIRE(alice_comment.cashout_time
                       == fc::time_point_sec(db.head_block_time() + fc::seconds(SCORUM_CASHOUT_WINDOW_SECONDS)));
+        BOOST_REQUIRE(alice_comment.parent_id == alice_comment.id);
+
+        const comment_content_object& alice_content = db.obtain_service<dbs_comment_content>().get(alice_comment.id);
 
 #ifndef IS_LOW_MEM
-        BOOST_REQUIRE(fc::to_string(alice_comment.title) == op.title);
-        BOOST_REQUIRE(fc::to_string(alice_comment.body) == op.body);
-// BOOST_REQUIRE( alice_comment.json_metadata == op.json_metadata );
+        BOOST_REQUIRE(fc::to_string(alice_content.title) == op.title);
+        BOOST_REQUIRE(fc::to_string(alice_content.body) == op.body);
+// BOOST_REQUIRE( alice_content.json_metadata == op.json_metadata );
 #else
-        BOOST_REQUIRE(fc::to_string(alice_comment.title) == "");
-        BOOST_REQUIRE(fc::to_string(alice_comment.body) == "");
-// BOOST_REQUIRE( alice_comment.json_metadata == "" );
+        BOOST_REQUIRE(fc::to_string(alice_content.title) == "");
+        BOOST_REQUIRE(fc::to_string(alice_content.body) == "");
+// BOOST_REQUIRE( alice_content.json_metadata == "" );
 #endif
 
         validate_database();
@@ -511,6 +515,7 @@ BOOST_AUTO_TEST_CASE(comment_apply)
         BOOST_REQUIRE(bob_comment.abs_rshares.value == 0);
         BOOST_REQUIRE(bob_comment.cashout_time == bob_comment.created + SCORUM_CASHOUT_WINDOW_SECONDS);
         BOOST_REQUIRE(bob_comment.root_comment == alice_comment.id);
+        BOOST_REQUIRE(bob_comment.parent_id == alice_comment.id);
         validate_database();
 
         BOOST_TEST_MESSAGE("--- Test Sam posting a comment on Bob's comment");
@@ -538,6 +543,7 @@ BOOST_AUTO_TEST_CASE(comment_apply)
         BOOST_REQUIRE(sam_comment.abs_rshares.value == 0);
         BOOST_REQUIRE(sam_comment.cashout_time == sam_comment.created + SCORUM_CASHOUT_WINDOW_SECONDS);
         BOOST_REQUIRE(sam_comment.root_comment == alice_comment.id);
+        BOOST_REQUIRE(sam_comment.parent_id == bob_comment.id);
         validate_database();
 
         generate_blocks(60 * 5 / SCORUM_BLOCK_INTERVAL + 1);
@@ -570,6 +576,14 @@ BOOST_AUTO_TEST_CASE(comment_apply)
         BOOST_REQUIRE(mod_sam_comment.last_update == db.head_block_time());
         BOOST_REQUIRE(mod_sam_comment.created == created);
         BOOST_REQUIRE(mod_sam_comment.cashout_time == mod_sam_comment.created + SCORUM_CASHOUT_WINDOW_SECONDS);
+
+#ifndef IS_LOW_MEM
+        const comment_content_object& mod_sam_content
+            = db.obtain_service<dbs_comment_content>().get(mod_sam_comment.id);
+        BOOST_REQUIRE(fc::to_string(mod_sam_content.title) == op.title);
+        BOOST_REQUIRE(fc::to_string(mod_sam_content.body) == op.body);
+        BOOST_REQUIRE(fc::to_string(mod_sam_content.json_metadata) == op.json_metadata);
+#endif
         validate_database();
 
         BOOST_TEST_MESSAGE("--- Test failure posting withing 1 minute");
@@ -668,6 +682,8 @@ BOOST_AUTO_TEST_CASE(comment_delete_apply)
 
         BOOST_TEST_MESSAGE("--- Test success deleting a comment with negative rshares");
 
+        const comment_id_type test_comment_id = db.obtain_service<dbs_comment>().get("alice", std::string("test1")).id;
+
         generate_block();
         vote.weight = -1 * SCORUM_PERCENT(100);
         tx.clear();
@@ -678,6 +694,7 @@ BOOST_AUTO_TEST_CASE(comment_delete_apply)
 
         auto test_comment = db.find<comment_object, by_permlink>(boost::make_tuple("alice", std::string("test1")));
         BOOST_REQUIRE(test_comment == nullptr);
+        BOOST_REQUIRE(db.find<comment_content_object, by_comment_id>(test_comment_id) == nullptr);
 
         BOOST_TEST_MESSAGE("--- Test failure deleting a comment past cashout");
         generate_blocks(SCORUM_MIN_ROOT_COMMENT_INTERVAL.to_seconds() / SCORUM_BLOCK_INTERVAL);
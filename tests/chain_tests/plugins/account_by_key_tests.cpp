@@ -0,0 +1,111 @@
+#include <boost/test/unit_test.hpp>
+
+#include <scorum/account_by_key/account_by_key_api.hpp>
+#include <scorum/account_by_key/account_by_key_plugin.hpp>
+
+#include "database_trx_integration.hpp"
+
+using namespace scorum;
+using namespace scorum::chain;
+using namespace scorum::protocol;
+using namespace scorum::app;
+
+namespace account_by_key_tests {
+
+using key_references_type = std::vector<std::vector<account_name_type>>;
+
+struct account_by_key_fixture : public database_fixture::database_trx_integration_fixture
+{
+    account_by_key_fixture()
+        : alice("alice")
+        , bob("bob")
+        , new_key(generate_private_key("new_key"))
+    {
+        boost::program_options::variables_map options;
+
+        plugin = app.register_plugin<scorum::account_by_key::account_by_key_plugin>();
+        app.enable_plugin(plugin->plugin_name());
+        plugin->plugin_initialize(options);
+
+        open_database();
+
+        plugin->plugin_startup();
+
+        api = std::make_unique<scorum::account_by_key::account_by_key_api>(
+            api_context(app, "account_by_key_api", std::make_shared<api_session_data>()));
+
+        actor(initdelegate).create_account(alice);
+        actor(initdelegate).create_account(bob);
+        generate_block();
+    }
+
+    void update_owner_and_active_keys(const Actor& a, const public_key_type& key)
+    {
+        account_update_operation op;
+        op.account = a.name;
+        op.owner = authority(1, key, 1);
+        op.active = authority(1, key, 1);
+        op.memo_key = key;
+
+        push_operation(op, a.private_key);
+    }
+
+    Actor alice;
+    Actor bob;
+
+    private_key_type new_key;
+
+    std::shared_ptr<scorum::account_by_key::account_by_key_plugin> plugin;
+    std::unique_ptr<scorum::account_by_key::account_by_key_api> api;
+};
+}
+
+BOOST_FIXTURE_TEST_SUITE(account_by_key_tests, account_by_key_tests::account_by_key_fixture)
+
+SCORUM_TEST_CASE(batch_lookup_of_known_and_unknown_keys)
+{
+    const auto unknown_key = generate_private_key("unknown").get_public_key();
+
+    BOOST_CHECK(!plugin->may_have_key_references(unknown_key));
+
+    const auto result = api->get_key_references(
+        { bob.public_key, unknown_key, alice.public_key, bob.public_key, alice.post_key.get_public_key() });
+
+    BOOST_REQUIRE_EQUAL(result.size(), 5u);
+    BOOST_CHECK(result[0] == std::vector<account_name_type>{ bob.name });
+    BOOST_CHECK(result[1].empty());
+    BOOST_CHECK(result[2] == std::vector<account_name_type>{ alice.name });
+    BOOST_CHECK(result[3] == std::vector<account_name_type>{ bob.name });
+    BOOST_CHECK(result[4] == std::vector<account_name_type>{ alice.name });
+}
+
+SCORUM_TEST_CASE(batch_lookup_of_key_shared_by_accounts)
+{
+    update_owner_and_active_keys(alice, new_key.get_public_key());
+    update_owner_and_active_keys(bob, new_key.get_public_key());
+
+    const auto result = api->get_key_references({ new_key.get_public_key(), alice.public_key });
+
+    BOOST_REQUIRE_EQUAL(result.size(), 2u);
+    BOOST_CHECK(result[0] == (std::vector<account_name_type>{ alice.name, bob.name }));
+    BOOST_CHECK(result[1].empty());
+}
+
+SCORUM_TEST_CASE(removed_key_is_found_after_pop_block)
+{
+    update_owner_and_active_keys(alice, new_key.get_public_key());
+
+    BOOST_CHECK(api->get_key_references({ alice.public_key }) == key_references_type{ {} });
+
+    // the old key is not in the index now, but the pop can restore it
+    plugin->rebuild_key_filter();
+
+    db.pop_block();
+
+    BOOST_CHECK(plugin->may_have_key_references(alice.public_key));
+    BOOST_CHECK(api->get_key_references({ alice.public_key })
+                == key_references_type{ std::vector<account_name_type>{ alice.name } });
+    BOOST_CHECK(api->get_key_references({ new_key.get_public_key() }) == key_references_type{ {} });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
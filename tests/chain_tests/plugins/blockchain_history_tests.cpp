@@ -99,6 +99,31 @@ struct history_database_fixture : public database_fixture::database_trx_integrat
     blockchain_history::account_history_api _api;
 };
 
+/// collects batches of a history stream until its stream_end
+template <typename Batch> struct stream_receiver
+{
+    std::function<void(const fc::variant&)> callback()
+    {
+        return [this](const fc::variant& v) {
+            if (v.get_object().contains("status"))
+                end = v.as<blockchain_history::stream_end>();
+            else
+                batches.push_back(v.as<Batch>());
+        };
+    }
+
+    void wait()
+    {
+        for (int i = 0; i < 1000 && !end.valid(); ++i)
+            fc::usleep(fc::milliseconds(1));
+
+        BOOST_REQUIRE(end.valid());
+    }
+
+    std::vector<Batch> batches;
+    fc::optional<blockchain_history::stream_end> end;
+};
+
 BOOST_FIXTURE_TEST_SUITE(account_history_tests, blockchain_history_tests::history_database_fixture)
 
 SCORUM_TEST_CASE(check_account_nontransfer_operation_only_in_full_history_test)
@@ -911,6 +936,104 @@ SCORUM_TEST_CASE(check_get_ops_in_block)
     BOOST_REQUIRE_EQUAL(ret.size(), 3u);
 }
 
+SCORUM_TEST_CASE(stream_blocks_pushes_all_blocks_in_batches)
+{
+    generate_blocks(4);
+
+    const uint32_t head_block_num = db.head_block_num();
+
+    stream_receiver<blockchain_history::blocks_stream_batch> receiver;
+    blockchain_history_api_call.stream_blocks(receiver.callback(), 1, 0, 2);
+    receiver.wait();
+
+    const auto& batches = receiver.batches;
+
+    BOOST_REQUIRE(!batches.empty() && batches.back().is_last);
+    BOOST_CHECK_EQUAL(batches.back().next_block, head_block_num + 1);
+    BOOST_CHECK(receiver.end->status == blockchain_history::stream_status::done);
+    BOOST_CHECK_EQUAL(receiver.end->next_cursor, head_block_num + 1);
+
+    uint32_t block_num = 1;
+    for (const auto& batch : batches)
+    {
+        BOOST_CHECK_LE(batch.blocks.size(), 2u);
+        for (const auto& block : batch.blocks)
+            BOOST_CHECK_EQUAL(block.block_num, block_num++);
+    }
+
+    BOOST_CHECK_EQUAL(block_num, head_block_num + 1);
+}
+
+SCORUM_TEST_CASE(stream_blocks_resumes_after_truncated_end)
+{
+    generate_blocks(110);
+
+    const uint32_t head_block_num = db.head_block_num();
+
+    stream_receiver<blockchain_history::blocks_stream_batch> first;
+    blockchain_history_api_call.stream_blocks(first.callback(), 1, 0, 1);
+    first.wait();
+
+    BOOST_REQUIRE_EQUAL(first.batches.size(), 100u);
+    BOOST_CHECK(!first.batches.back().is_last);
+    BOOST_CHECK(first.end->status == blockchain_history::stream_status::truncated);
+    BOOST_REQUIRE_EQUAL(first.end->next_cursor, 101u);
+
+    stream_receiver<blockchain_history::blocks_stream_batch> second;
+    blockchain_history_api_call.stream_blocks(second.callback(), first.end->next_cursor, 0, 1);
+    second.wait();
+
+    BOOST_REQUIRE(!second.batches.empty() && second.batches.back().is_last);
+    BOOST_CHECK(second.end->status == blockchain_history::stream_status::done);
+    BOOST_CHECK_EQUAL(second.end->next_cursor, head_block_num + 1);
+
+    uint32_t block_num = 1;
+    for (const auto& receiver : { first, second })
+        for (const auto& batch : receiver.batches)
+            for (const auto& block : batch.blocks)
+                BOOST_CHECK_EQUAL(block.block_num, block_num++);
+
+    BOOST_CHECK_EQUAL(block_num, head_block_num + 1);
+}
+
+SCORUM_TEST_CASE(stream_ops_history_resumes_from_cursor)
+{
+    generate_block();
+
+    const auto all_ops = blockchain_history_api_call.get_ops_history(
+        -1, MAX_BLOCKCHAIN_HISTORY_DEPTH, blockchain_history::applied_operation_type::all);
+    BOOST_REQUIRE_GT(all_ops.size(), 2u);
+
+    auto stream = [&](uint32_t from_op, uint32_t to_op) {
+        stream_receiver<blockchain_history::ops_stream_batch> receiver;
+        blockchain_history_api_call.stream_ops_history(receiver.callback(), from_op, to_op,
+                                                       blockchain_history::applied_operation_type::all, 1);
+        receiver.wait();
+
+        BOOST_REQUIRE(!receiver.batches.empty() && receiver.batches.back().is_last);
+        BOOST_REQUIRE(receiver.end->status == blockchain_history::stream_status::done);
+        BOOST_REQUIRE_EQUAL(receiver.end->next_cursor, receiver.batches.back().next_op);
+        return receiver.batches;
+    };
+
+    const uint32_t first_op = all_ops.begin()->first;
+    const uint32_t last_op = all_ops.rbegin()->first;
+
+    // the first op only, as if the connection was lost after it
+    auto batches = stream(first_op, first_op);
+    BOOST_REQUIRE_EQUAL(batches.size(), 1u);
+    BOOST_REQUIRE_EQUAL(batches[0].ops.size(), 1u);
+
+    std::map<uint32_t, blockchain_history::applied_operation> streamed = batches[0].ops;
+
+    for (const auto& batch : stream(batches[0].next_op, last_op))
+        streamed.insert(batch.ops.begin(), batch.ops.end());
+
+    BOOST_REQUIRE_EQUAL(streamed.size(), all_ops.size());
+    for (const auto& op : all_ops)
+        BOOST_CHECK(streamed.at(op.first).op == op.second.op);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_FIXTURE_TEST_SUITE(blockchain_history_by_time_tests, blokchain_history_fixture)
@@ -31,6 +31,13 @@ struct stat_database_fixture : public database_trx_integration_fixture
         FC_ASSERT(itr != bucket_idx.end());
         return *itr;
     }
+
+    const account_statistic* find_lifetime_statistic(const account_name_type& account) const
+    {
+        const auto& statistic_idx = db.get_index<account_bucket_statistic_index, by_bucket_account>();
+        auto itr = statistic_idx.find(boost::make_tuple(get_lifetime_bucket().id, account));
+        return itr != statistic_idx.end() ? &itr->statistic : nullptr;
+    }
 };
 } // namespace account_stat
 
@@ -41,21 +48,25 @@ SCORUM_TEST_CASE(account_transfers_stat_test)
     const char* buratino = "buratino";
     const char* maugli = "maugli";
 
-    const auto& stat_map = get_lifetime_bucket().account_statistic;
-
     account_create(buratino, initdelegate.public_key);
     account_create(maugli, initdelegate.public_key);
+    generate_block();
 
-    BOOST_REQUIRE(stat_map.find(buratino) == stat_map.end());
-    BOOST_REQUIRE(stat_map.find(maugli) == stat_map.end());
+    BOOST_REQUIRE(find_lifetime_statistic(buratino) == nullptr);
+    BOOST_REQUIRE(find_lifetime_statistic(maugli) == nullptr);
 
     fund(buratino, SCORUM_MIN_PRODUCER_REWARD);
 
-    BOOST_REQUIRE(stat_map.find(buratino) != stat_map.end());
-    BOOST_REQUIRE(stat_map.find(maugli) == stat_map.end());
+    // statistic is collected per block
+    BOOST_REQUIRE(find_lifetime_statistic(buratino) == nullptr);
+
+    generate_block();
+
+    BOOST_REQUIRE(find_lifetime_statistic(buratino) != nullptr);
+    BOOST_REQUIRE(find_lifetime_statistic(maugli) == nullptr);
 
     {
-        const auto& buratino_stat = stat_map.find(buratino)->second;
+        const auto& buratino_stat = *find_lifetime_statistic(buratino);
 
         BOOST_REQUIRE_EQUAL(buratino_stat.transfers_to, 1u);
         BOOST_REQUIRE_EQUAL(buratino_stat.scorum_received, SCORUM_MIN_PRODUCER_REWARD);
@@ -68,18 +79,18 @@ SCORUM_TEST_CASE(account_transfers_stat_test)
 
     push_operation(op);
 
-    BOOST_REQUIRE(stat_map.find(maugli) != stat_map.end());
+    BOOST_REQUIRE(find_lifetime_statistic(maugli) != nullptr);
 
     {
         const auto& buratino_acc = db.account_service().get_account(buratino);
-        const auto& buratino_stat = stat_map.find(buratino)->second;
+        const auto& buratino_stat = *find_lifetime_statistic(buratino);
 
         BOOST_REQUIRE_EQUAL(buratino_stat.transfers_from, 1u);
         BOOST_REQUIRE_EQUAL(buratino_stat.scorum_sent, SCORUM_MIN_PRODUCER_REWARD / 2);
         BOOST_REQUIRE_EQUAL(buratino_stat.scorum_received - buratino_stat.scorum_sent, buratino_acc.balance);
 
         const auto& maugli_acc = db.account_service().get_account(maugli);
-        const auto& maugli_stat = stat_map.find(maugli)->second;
+        const auto& maugli_stat = *find_lifetime_statistic(maugli);
 
         BOOST_REQUIRE_EQUAL(maugli_stat.transfers_to, 1u);
         BOOST_REQUIRE_EQUAL(maugli_stat.scorum_received, SCORUM_MIN_PRODUCER_REWARD / 2);
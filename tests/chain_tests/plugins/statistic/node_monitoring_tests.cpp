@@ -7,6 +7,7 @@
 
 #include <scorum/protocol/block.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
@@ -33,6 +34,14 @@ struct monitoring_database_fixture : public database_fixture::database_integrati
     }
 };
 
+const chain::block_profile_entry* find_entry(const std::vector<chain::block_profile_entry>& entries,
+                                             const std::string& name)
+{
+    auto it = std::find_if(entries.begin(), entries.end(),
+                           [&](const chain::block_profile_entry& entry) { return entry.name == name; });
+    return it != entries.end() ? &(*it) : nullptr;
+}
+
 } // namespace blockchain_monitoring_tests
 
 BOOST_FIXTURE_TEST_SUITE(node_monitoring_tests, blockchain_monitoring_tests::monitoring_database_fixture)
@@ -84,4 +93,56 @@ SCORUM_TEST_CASE(check_free_shared_memory)
     BOOST_REQUIRE_GT(_api_call.get_free_shared_memory_mb(), 0u);
 }
 
+SCORUM_TEST_CASE(check_block_profiler_is_disabled_by_default)
+{
+    generate_block();
+
+    auto profile = _api_call.get_block_profile();
+
+    BOOST_CHECK_EQUAL(profile.blocks, 0u);
+    BOOST_CHECK(profile.block_tasks.empty());
+    BOOST_CHECK(profile.operations.empty());
+    BOOST_CHECK(profile.signal_handlers.empty());
+}
+
+SCORUM_TEST_CASE(check_block_profiler_collects_block_tasks_and_signal_handlers)
+{
+    using blockchain_monitoring_tests::find_entry;
+
+    db.get_block_profiler().enable(true);
+
+    generate_block();
+    generate_block();
+
+    auto profile = _api_call.get_block_profile();
+
+    BOOST_CHECK_EQUAL(profile.blocks, 2u);
+
+    auto process_funds = find_entry(profile.block_tasks, "process_funds");
+    BOOST_REQUIRE(process_funds != nullptr);
+    BOOST_CHECK_EQUAL(process_funds->calls, 2u);
+
+    auto cashout = find_entry(profile.block_tasks, "process_comments_cashout");
+    BOOST_REQUIRE(cashout != nullptr);
+    BOOST_CHECK_EQUAL(cashout->calls, 2u);
+
+    auto applied_block = find_entry(profile.signal_handlers, "applied_block");
+    BOOST_REQUIRE(applied_block != nullptr);
+    BOOST_CHECK_EQUAL(applied_block->calls, 2u);
+}
+
+SCORUM_TEST_CASE(check_block_profiler_reset)
+{
+    db.get_block_profiler().enable(true);
+
+    generate_block();
+
+    db.get_block_profiler().reset();
+
+    auto profile = _api_call.get_block_profile();
+
+    BOOST_CHECK_EQUAL(profile.blocks, 0u);
+    BOOST_CHECK(profile.block_tasks.empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
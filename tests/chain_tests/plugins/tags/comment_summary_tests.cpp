@@ -0,0 +1,162 @@
+#ifndef IS_LOW_MEM
+
+#include "tags_common.hpp"
+#include <scorum/tags/tags_api_objects.hpp>
+#include <scorum/tags/tags_api.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace scorum;
+using namespace scorum::tags::api;
+using namespace scorum::app;
+using namespace scorum::tags;
+
+namespace database_fixture {
+
+struct comment_summary_fixture : public tags_fixture
+{
+    using discussion = scorum::tags::api::discussion;
+
+    comment_summary_fixture()
+    {
+        for (int i = 0; i < 12; ++i)
+        {
+            voters.emplace_back("voter" + std::to_string(i));
+
+            actor(initdelegate).create_account(voters.back());
+            actor(initdelegate).give_sp(voters.back(), 1e8);
+        }
+    }
+
+    std::vector<discussion> get_created(bool summary)
+    {
+        discussion_query q;
+        q.limit = 100;
+        q.summary = summary;
+
+        return _api.get_discussions_by_created(q);
+    }
+
+    const comment_summary_object* find_summary(const comment_op& post)
+    {
+        const auto& comment = db.comment_service().get(post.author(), post.permlink());
+
+        return db.find<comment_summary_object, tags::by_comment>(comment.id);
+    }
+
+    std::vector<Actor> voters;
+};
+}
+
+BOOST_FIXTURE_TEST_SUITE(comment_summary_tests, database_fixture::comment_summary_fixture)
+
+SCORUM_TEST_CASE(summary_body_is_cut_and_keeps_full_length)
+{
+    const std::string body(TAGS_SUMMARY_BODY_LENGTH * 2, 'a');
+
+    create_post(alice).set_body(body).in_block();
+
+    auto summaries = get_created(true);
+    auto discussions = get_created(false);
+
+    BOOST_REQUIRE_EQUAL(summaries.size(), 1u);
+    BOOST_REQUIRE_EQUAL(discussions.size(), 1u);
+
+    BOOST_CHECK_EQUAL(summaries[0].body, body.substr(0, TAGS_SUMMARY_BODY_LENGTH));
+    BOOST_CHECK_EQUAL(summaries[0].body_length, body.size());
+
+    BOOST_CHECK_EQUAL(discussions[0].body, body);
+    BOOST_CHECK_EQUAL(discussions[0].body_length, body.size());
+
+    BOOST_CHECK_EQUAL(summaries[0].title, discussions[0].title);
+    BOOST_CHECK_EQUAL(summaries[0].json_metadata, discussions[0].json_metadata);
+    BOOST_CHECK_EQUAL(summaries[0].url, discussions[0].url);
+}
+
+SCORUM_TEST_CASE(summary_is_updated_by_comment_edit)
+{
+    auto post = create_post(alice).set_body("first").in_block();
+
+    post.set_body("second").in_block();
+
+    auto summaries = get_created(true);
+
+    BOOST_REQUIRE_EQUAL(summaries.size(), 1u);
+    BOOST_CHECK_EQUAL(summaries[0].body, "second");
+    BOOST_CHECK_EQUAL(summaries[0].body_length, 6u);
+}
+
+SCORUM_TEST_CASE(summary_keeps_top_votes_by_rshares)
+{
+    auto post = create_post(alice).in_block();
+
+    for (size_t i = 0; i < voters.size(); ++i)
+        post.vote(voters[i], SCORUM_PERCENT(5 * (i + 1))).in_block();
+
+    auto summaries = get_created(true);
+    auto discussions = get_created(false);
+
+    BOOST_REQUIRE_EQUAL(summaries.size(), 1u);
+    BOOST_REQUIRE_EQUAL(discussions.size(), 1u);
+
+    BOOST_CHECK_EQUAL(summaries[0].active_votes_count, voters.size());
+    BOOST_CHECK_EQUAL(discussions[0].active_votes_count, voters.size());
+
+    auto& expected = discussions[0].active_votes;
+    std::sort(expected.begin(), expected.end(),
+              [](const vote_state& lhs, const vote_state& rhs) { return lhs.rshares > rhs.rshares; });
+    expected.resize(TAGS_SUMMARY_TOP_VOTES);
+
+    const auto& votes = summaries[0].active_votes;
+
+    BOOST_REQUIRE_EQUAL(votes.size(), expected.size());
+    for (size_t i = 0; i < votes.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(votes[i].voter, expected[i].voter);
+        BOOST_CHECK_EQUAL(votes[i].rshares, expected[i].rshares);
+        BOOST_CHECK_EQUAL(votes[i].percent, expected[i].percent);
+    }
+}
+
+SCORUM_TEST_CASE(changed_vote_leaving_top_is_replaced)
+{
+    auto post = create_post(alice).in_block();
+
+    for (size_t i = 0; i < voters.size(); ++i)
+        post.vote(voters[i], SCORUM_PERCENT(5 * (i + 1))).in_block();
+
+    // the strongest voter drops below everyone, the best of the rest takes the place
+    post.vote(voters.back(), SCORUM_PERCENT(1)).in_block();
+
+    auto summaries = get_created(true);
+
+    BOOST_REQUIRE_EQUAL(summaries.size(), 1u);
+    BOOST_CHECK_EQUAL(summaries[0].active_votes_count, voters.size());
+
+    const auto& votes = summaries[0].active_votes;
+
+    BOOST_REQUIRE_EQUAL(votes.size(), (size_t)TAGS_SUMMARY_TOP_VOTES);
+    BOOST_CHECK_EQUAL(votes.front().voter, voters[voters.size() - 2].name);
+    BOOST_CHECK(std::none_of(votes.begin(), votes.end(),
+                             [&](const vote_state& v) { return v.voter == voters.back().name; }));
+    BOOST_CHECK(std::is_sorted(votes.begin(), votes.end(), [](const vote_state& lhs, const vote_state& rhs) {
+        return lhs.rshares > rhs.rshares;
+    }));
+}
+
+SCORUM_TEST_CASE(summary_is_removed_with_comment)
+{
+    auto post = create_post(alice).in_block();
+
+    BOOST_REQUIRE(find_summary(post) != nullptr);
+
+    const auto comment_id = db.comment_service().get(post.author(), post.permlink()).id;
+
+    post.remove();
+    generate_block();
+
+    BOOST_CHECK(db.find<comment_summary_object, tags::by_comment>(comment_id) == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
@@ -138,4 +138,118 @@ SCORUM_TEST_CASE(check_signing_key_reset)
     FC_LOG_AND_RETHROW()
 }
 
+SCORUM_TEST_CASE(deferred_votes_are_equal_to_eager_ones)
+{
+    try
+    {
+        Actor deferred_user("deferreduser");
+
+        create_account();
+        actor(initdelegate).create_account(deferred_user);
+
+        const auto& eager = witness_svc.create_witness(user.name, "", public_key_type(), chain_properties());
+        const auto& deferred
+            = witness_svc.create_witness(deferred_user.name, "", public_key_type(), chain_properties());
+
+        witness_svc.adjust_witness_vote(eager, 100);
+        witness_svc.adjust_witness_vote(eager, -30);
+
+        witness_svc.defer_witness_votes(true);
+        witness_svc.adjust_witness_vote(deferred, 100);
+        witness_svc.adjust_witness_vote(deferred, -30);
+
+        BOOST_CHECK_EQUAL(deferred.votes.value, 0);
+
+        witness_svc.flush_witness_votes();
+        witness_svc.defer_witness_votes(false);
+
+        BOOST_CHECK_EQUAL(deferred.votes.value, 70);
+        BOOST_CHECK_EQUAL(deferred.votes.value, eager.votes.value);
+        BOOST_CHECK(deferred.virtual_position == eager.virtual_position);
+        BOOST_CHECK(deferred.virtual_last_update == eager.virtual_last_update);
+        BOOST_CHECK(deferred.virtual_scheduled_time == eager.virtual_scheduled_time);
+    }
+    FC_LOG_AND_RETHROW()
+}
+
+SCORUM_TEST_CASE(vote_order_is_updated_for_next_transaction_in_block)
+{
+    try
+    {
+        Actor zoe("zoe");
+        Actor sam("sam");
+
+        actor(initdelegate).create_account(zoe);
+        actor(initdelegate).create_account(sam);
+        actor(initdelegate).give_sp(sam, 1000);
+        witness_create(zoe.name, zoe.private_key, "", zoe.public_key, 0);
+        generate_block();
+
+        BOOST_REQUIRE(witness_svc.get_top_witness().owner != zoe.name);
+
+        account_witness_vote_operation vote;
+        vote.account = sam.name;
+        vote.witness = zoe.name;
+        vote.approve = true;
+        push_operation_only(vote, sam.private_key);
+
+        // an account without recovery partner (created by genesis) is recovered by the top witness
+        request_account_recovery_operation request;
+        request.recovery_account = zoe.name;
+        request.account_to_recover = initdelegate.name;
+        request.new_owner_authority = authority(1, zoe.public_key, 1);
+        push_operation_only(request, zoe.private_key);
+
+        // both transactions are applied in the block the same way as they were while pending
+        generate_block();
+
+        BOOST_CHECK(witness_svc.get_top_witness().owner == zoe.name);
+
+        const auto& requests = db.get_index<account_recovery_request_index>().indices().get<by_account>();
+        BOOST_CHECK(requests.find(account_name_type(initdelegate.name)) != requests.end());
+    }
+    FC_LOG_AND_RETHROW()
+}
+
+SCORUM_TEST_CASE(dropped_deferred_votes_are_not_applied)
+{
+    try
+    {
+        create_account();
+
+        const auto& witness = witness_svc.create_witness(user.name, "", public_key_type(), chain_properties());
+
+        witness_svc.defer_witness_votes(true);
+        witness_svc.adjust_witness_vote(witness, 100);
+        witness_svc.drop_witness_votes();
+        witness_svc.defer_witness_votes(false);
+
+        witness_svc.flush_witness_votes();
+
+        BOOST_CHECK_EQUAL(witness.votes.value, 0);
+    }
+    FC_LOG_AND_RETHROW()
+}
+
+SCORUM_TEST_CASE(not_flushed_deferred_votes_are_not_silently_dropped)
+{
+    try
+    {
+        create_account();
+
+        const auto& witness = witness_svc.create_witness(user.name, "", public_key_type(), chain_properties());
+
+        witness_svc.defer_witness_votes(true);
+        witness_svc.adjust_witness_vote(witness, 100);
+
+        SCORUM_REQUIRE_THROW(witness_svc.defer_witness_votes(false), fc::exception);
+
+        witness_svc.flush_witness_votes();
+        witness_svc.defer_witness_votes(false);
+
+        BOOST_CHECK_EQUAL(witness.votes.value, 100);
+    }
+    FC_LOG_AND_RETHROW()
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,277 @@
+#include <boost/test/unit_test.hpp>
+
+#include <scorum/chain/services/account.hpp>
+#include <scorum/protocol/betting/market.hpp>
+
+#include <scorum/tags/tags_plugin.hpp>
+#include <scorum/blockchain_history/blockchain_history_plugin.hpp>
+#include <scorum/account_statistics/account_statistics_plugin.hpp>
+#include <scorum/blockchain_monitoring/blockchain_monitoring_plugin.hpp>
+
+#include <fc/filesystem.hpp>
+#include <fc/io/json.hpp>
+
+#include <graphene/utilities/tempdir.hpp>
+
+#include <boost/algorithm/string.hpp>
+
+#include <cstdlib>
+#include <iostream>
+
+#include "database_betting_integration.hpp"
+#include "detail.hpp"
+
+#include "block_apply_stats.hpp"
+
+using namespace scorum::chain;
+using namespace scorum::protocol;
+
+using namespace database_fixture;
+
+using performance_common::block_apply_stats;
+
+namespace {
+
+std::string get_env(const char* name, const std::string& default_value = std::string())
+{
+    const char* value = std::getenv(name);
+    return value ? std::string(value) : default_value;
+}
+
+uint32_t get_env(const char* name, uint32_t default_value)
+{
+    const char* value = std::getenv(name);
+    return value ? boost::lexical_cast<uint32_t>(value) : default_value;
+}
+}
+
+/**
+ * Environment:
+ *   SCORUM_BENCH_PLUGINS   comma separated plugins applying blocks with the chain (all API plugins by default)
+ *   SCORUM_BENCH_ACCOUNTS  accounts of the synthetic workload (120 by default)
+ *   SCORUM_BENCH_BLOCKS    measured blocks of the synthetic workload (100 by default)
+ *   SCORUM_BENCH_BLOCK_LOG directory with 'block_log' to replay, the log must be produced under the test config
+ *   SCORUM_BENCH_GENESIS   genesis json of the replayed log
+ *   SCORUM_BENCH_REPORT    file to save the results to
+ *   SCORUM_BENCH_BASELINE  results of another build to compare with
+ */
+struct block_apply_benchmark_fixture : public database_betting_integration_fixture
+{
+    block_apply_benchmark_fixture()
+    {
+        std::vector<std::string> plugins;
+        boost::split(plugins,
+                     get_env("SCORUM_BENCH_PLUGINS",
+                             "tags,blockchain_history,account_statistics,blockchain_monitoring"),
+                     boost::is_any_of(","));
+
+        for (const auto& name : plugins)
+        {
+            if (name == "tags")
+                init_plugin<scorum::tags::tags_plugin>();
+            else if (name == "blockchain_history")
+                init_plugin<scorum::blockchain_history::blockchain_history_plugin>();
+            else if (name == "account_statistics")
+                init_plugin<scorum::account_statistics::account_statistics_plugin>();
+            else if (name == "blockchain_monitoring")
+                init_plugin<scorum::blockchain_monitoring::blockchain_monitoring_plugin>();
+            else
+                BOOST_REQUIRE_MESSAGE(name.empty(), "Unknown plugin " << name);
+        }
+    }
+
+    virtual void open_database_impl(const genesis_state_type& genesis) override
+    {
+        if (!data_dir)
+        {
+            auto shared_file_size_1gb = 1024 * 1024 * 1024ul;
+
+            data_dir = fc::temp_directory(graphene::utilities::temp_directory_path());
+            db.open(data_dir->path(), data_dir->path(), shared_file_size_1gb, chainbase::database::read_write, genesis);
+            genesis_state = genesis;
+        }
+    }
+
+    void create_workload_accounts(uint32_t accounts_count)
+    {
+        const auto per_account
+            = db.account_service().get_account(initdelegate.name).balance.amount / (accounts_count + 1) / 2;
+
+        for (uint32_t i = 0; i < accounts_count; ++i)
+        {
+            accounts.emplace_back("bench" + std::to_string(i));
+
+            actor(initdelegate).create_account(accounts.back());
+            actor(initdelegate).give_scr(accounts.back(), per_account.value);
+            actor(initdelegate).give_sp(accounts.back(), per_account.value);
+
+            comment_operation op;
+            op.author = accounts.back().name;
+            op.permlink = "post";
+            op.parent_permlink = "benchmark";
+            op.title = "post";
+            op.body = "Lorem ipsum dolor sit amet, consectetur adipiscing elit.";
+            op.json_metadata = "{\"tags\":[\"benchmark\",\"football\"]}";
+
+            push_operation(op, accounts.back().private_key);
+        }
+
+        actor(initdelegate).create_account(moderator);
+        actor(initdelegate).give_scr(moderator, per_account.value);
+        actor(initdelegate).give_sp(moderator, per_account.value);
+
+        empower_moderator(moderator);
+
+        create_game(moderator, { result_home{} }, SCORUM_BLOCK_INTERVAL * 60 * 60);
+        generate_block();
+    }
+
+    /// every block transfers, replies, votes, bets and creates a budget
+    void generate_workload_block(uint32_t b)
+    {
+        const uint32_t n = accounts.size();
+
+        for (uint32_t i = 0; i < 10; ++i)
+        {
+            transfer_operation op;
+            op.from = accounts[(b * 10 + i) % n].name;
+            op.to = accounts[(b * 10 + i + 1) % n].name;
+            op.amount = ASSET_SCR(1000);
+
+            push_operation_only(op, accounts[(b * 10 + i) % n].private_key);
+        }
+
+        for (uint32_t i = 0; i < 2; ++i)
+        {
+            transfer_to_scorumpower_operation op;
+            op.from = accounts[(b * 2 + i) % n].name;
+            op.to = op.from;
+            op.amount = ASSET_SCR(1000);
+
+            push_operation_only(op, accounts[(b * 2 + i) % n].private_key);
+        }
+
+        for (uint32_t i = 0; i < 5; ++i)
+        {
+            comment_operation op;
+            op.author = accounts[(b * 5 + i) % n].name;
+            op.permlink = "reply-" + std::to_string(b) + "-" + std::to_string(i);
+            op.parent_author = accounts[(b * 5 + i + 1) % n].name;
+            op.parent_permlink = "post";
+            op.body = "Ut enim ad minim veniam, quis nostrud exercitation.";
+            op.json_metadata = "{}";
+
+            push_operation_only(op, accounts[(b * 5 + i) % n].private_key);
+        }
+
+        // a voter never votes twice for the same post while blocks count is less than accounts count
+        for (uint32_t i = 0; i < 10; ++i)
+        {
+            const uint32_t voter = (b * 10 + i) % n;
+
+            vote_operation op;
+            op.voter = accounts[voter].name;
+            op.author = accounts[(voter + 1 + b) % n].name;
+            op.permlink = "post";
+            op.weight = 50 * SCORUM_1_PERCENT;
+
+            push_operation_only(op, accounts[voter].private_key);
+        }
+
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            const auto& better = accounts[(b * 4 + i) % n];
+            const auto uuid = gen_uuid("bet-" + std::to_string(b) + "-" + std::to_string(i));
+
+            if (i % 2)
+                create_bet(uuid, better, result_home::no{}, { 10, 8 }, SCORUM_MIN_BET_STAKE);
+            else
+                create_bet(uuid, better, result_home::yes{}, { 10, 2 }, SCORUM_MIN_BET_STAKE);
+        }
+
+        {
+            create_budget_operation op;
+            op.uuid = gen_uuid("budget-" + std::to_string(b));
+            op.owner = accounts[b % n].name;
+            op.json_metadata = "{}";
+            op.balance = ASSET_SCR(1e+6);
+            op.start = db.head_block_time() + SCORUM_BLOCK_INTERVAL;
+            op.deadline = db.head_block_time() + SCORUM_BLOCK_INTERVAL * 30;
+
+            push_operation_only(op, accounts[b % n].private_key);
+        }
+
+        generate_block();
+    }
+
+    void report(const block_apply_stats& stats)
+    {
+        stats.print(std::cout);
+
+        const auto report_file = get_env("SCORUM_BENCH_REPORT");
+        if (!report_file.empty())
+            fc::json::save_to_file(stats.to_variant(), fc::path(report_file));
+
+        const auto baseline_file = get_env("SCORUM_BENCH_BASELINE");
+        if (!baseline_file.empty())
+            stats.print_comparison(fc::json::from_file(fc::path(baseline_file)).get_object(), std::cout);
+    }
+
+    std::vector<Actor> accounts;
+    Actor moderator = "benchmod";
+};
+
+BOOST_FIXTURE_TEST_SUITE(block_apply_benchmark_tests, block_apply_benchmark_fixture)
+
+SCORUM_TEST_CASE(synthetic_workload_block_apply)
+{
+    const uint32_t blocks_count = get_env("SCORUM_BENCH_BLOCKS", 100u);
+    const uint32_t accounts_count = get_env("SCORUM_BENCH_ACCOUNTS", 120u);
+
+    BOOST_REQUIRE_MESSAGE(accounts_count > blocks_count, "SCORUM_BENCH_ACCOUNTS must exceed SCORUM_BENCH_BLOCKS");
+
+    open_database();
+    create_workload_accounts(accounts_count);
+
+    block_apply_stats stats(db);
+
+    for (uint32_t b = 0; b < blocks_count; ++b)
+        generate_workload_block(b);
+
+    BOOST_REQUIRE_EQUAL(stats.blocks_count(), blocks_count);
+
+    report(stats);
+}
+
+SCORUM_TEST_CASE(recorded_block_log_replay)
+{
+    const auto block_log_dir = get_env("SCORUM_BENCH_BLOCK_LOG");
+    if (block_log_dir.empty())
+    {
+        BOOST_TEST_MESSAGE("SCORUM_BENCH_BLOCK_LOG is not set, nothing to replay");
+        return;
+    }
+
+    const auto genesis_file = get_env("SCORUM_BENCH_GENESIS");
+    if (!genesis_file.empty())
+        genesis_state = fc::json::from_file(fc::path(genesis_file)).as<genesis_state_type>();
+
+    // the replay rewrites the state next to the log, the recorded one must stay untouched
+    data_dir = fc::temp_directory(graphene::utilities::temp_directory_path());
+    for (const auto& name : { "block_log", "block_log.index" })
+    {
+        if (fc::exists(fc::path(block_log_dir) / name))
+            fc::copy(fc::path(block_log_dir) / name, data_dir->path() / name);
+    }
+
+    block_apply_stats stats(db);
+
+    db.reindex(data_dir->path(), data_dir->path(), 1024 * 1024 * 1024 * 4ul, db.get_reindex_skip_flags(),
+               genesis_state);
+
+    BOOST_REQUIRE_GT(stats.blocks_count(), 0u);
+
+    report(stats);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
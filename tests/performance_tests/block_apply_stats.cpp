@@ -0,0 +1,165 @@
+#include "block_apply_stats.hpp"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace performance_common {
+
+namespace {
+struct operation_name_visitor
+{
+    using result_type = std::string;
+
+    template <typename Operation> std::string operator()(const Operation&) const
+    {
+        const std::string name = fc::get_typename<Operation>::name();
+        return name.substr(name.rfind(':') + 1);
+    }
+};
+
+double change_percent(double baseline, double current)
+{
+    return baseline != 0 ? (current - baseline) * 100 / baseline : 0;
+}
+}
+
+block_apply_stats::block_apply_stats(scorum::chain::database& db)
+    : _db(db)
+{
+    _pre_applied_block_conn = _db.pre_applied_block.connect([this](const auto&) { on_pre_applied_block(); });
+    _applied_block_conn = _db.applied_block.connect([this](const auto&) { on_applied_block(); });
+    _pre_apply_operation_conn
+        = _db.pre_apply_operation.connect([this](const auto& note) { on_pre_apply_operation(note); });
+    _post_apply_operation_conn
+        = _db.post_apply_operation.connect([this](const auto& note) { on_post_apply_operation(note); });
+}
+
+double block_apply_stats::blocks_per_sec() const
+{
+    uint64_t total_us = 0;
+    for (auto us : _blocks_us)
+        total_us += us;
+
+    return total_us ? _blocks_us.size() * 1e6 / total_us : 0;
+}
+
+uint64_t block_apply_stats::block_percentile_us(double percentile) const
+{
+    if (_blocks_us.empty())
+        return 0;
+
+    std::vector<uint64_t> sorted(_blocks_us);
+    auto nth = sorted.begin() + std::min<size_t>(sorted.size() * percentile / 100, sorted.size() - 1);
+    std::nth_element(sorted.begin(), nth, sorted.end());
+
+    return *nth;
+}
+
+int64_t block_apply_stats::shared_memory_growth() const
+{
+    return (int64_t)_used_memory - (int64_t)_used_memory_at_start;
+}
+
+void block_apply_stats::print(std::ostream& out) const
+{
+    out << "blocks: " << blocks_count() << ", blocks/sec: " << std::fixed << std::setprecision(1) << blocks_per_sec()
+        << ", p50: " << block_percentile_us(50) << " us, p99: " << block_percentile_us(99)
+        << " us, shared memory growth: " << shared_memory_growth() / 1024 << " KiB\n";
+
+    out << std::left << std::setw(48) << "operation" << std::right << std::setw(10) << "count" << std::setw(12)
+        << "total ms" << std::setw(10) << "avg us"
+        << "\n";
+
+    for (const auto& op : _operations)
+    {
+        out << std::left << std::setw(48) << op.first << std::right << std::setw(10) << op.second.count
+            << std::setw(12) << op.second.total_us / 1000 << std::setw(10) << op.second.total_us / op.second.count
+            << "\n";
+    }
+}
+
+fc::variant_object block_apply_stats::to_variant() const
+{
+    fc::mutable_variant_object operations;
+    for (const auto& op : _operations)
+    {
+        operations(op.first, fc::mutable_variant_object("count", op.second.count)("total_us", op.second.total_us));
+    }
+
+    return fc::mutable_variant_object("blocks", blocks_count())("blocks_per_sec", blocks_per_sec())(
+        "p50_us", block_percentile_us(50))("p99_us", block_percentile_us(99))(
+        "shared_memory_growth", shared_memory_growth())("operations", operations);
+}
+
+void block_apply_stats::print_comparison(const fc::variant_object& baseline, std::ostream& out) const
+{
+    auto print_change = [&](const std::string& name, double base, double current) {
+        out << std::left << std::setw(48) << name << std::right << std::setw(14) << std::fixed << std::setprecision(1)
+            << base << std::setw(14) << current << std::setw(9) << std::showpos << change_percent(base, current)
+            << std::noshowpos << "%\n";
+    };
+
+    out << std::left << std::setw(48) << "metric" << std::right << std::setw(14) << "baseline" << std::setw(14)
+        << "current" << std::setw(10) << "change"
+        << "\n";
+
+    print_change("blocks/sec", baseline["blocks_per_sec"].as_double(), blocks_per_sec());
+    print_change("p50 us", baseline["p50_us"].as_double(), block_percentile_us(50));
+    print_change("p99 us", baseline["p99_us"].as_double(), block_percentile_us(99));
+    print_change("shared memory growth", baseline["shared_memory_growth"].as_double(), shared_memory_growth());
+
+    const auto& baseline_operations = baseline["operations"].get_object();
+    for (const auto& op : _operations)
+    {
+        if (!baseline_operations.contains(op.first.c_str()))
+            continue;
+
+        const auto& base = baseline_operations[op.first].get_object();
+        print_change(op.first + " avg us", base["total_us"].as_double() / base["count"].as_double(),
+                     (double)op.second.total_us / op.second.count);
+    }
+}
+
+void block_apply_stats::on_pre_applied_block()
+{
+    if (_blocks_us.empty())
+        _used_memory_at_start = used_memory();
+
+    _in_block = true;
+    _operations_start.clear();
+    _block_start = fc::time_point::now();
+}
+
+void block_apply_stats::on_applied_block()
+{
+    if (!_in_block)
+        return;
+
+    _blocks_us.push_back((fc::time_point::now() - _block_start).count());
+    _used_memory = used_memory();
+    _in_block = false;
+}
+
+void block_apply_stats::on_pre_apply_operation(const scorum::chain::operation_notification&)
+{
+    if (_in_block)
+        _operations_start.push_back(fc::time_point::now());
+}
+
+void block_apply_stats::on_post_apply_operation(const scorum::chain::operation_notification& note)
+{
+    if (!_in_block || _operations_start.empty())
+        return;
+
+    auto& cost = _operations[note.op.visit(operation_name_visitor())];
+    ++cost.count;
+    cost.total_us += (fc::time_point::now() - _operations_start.back()).count();
+
+    _operations_start.pop_back();
+}
+
+size_t block_apply_stats::used_memory() const
+{
+    return _db.get_size() - _db.get_free_memory();
+}
+}
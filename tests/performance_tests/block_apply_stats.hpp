@@ -0,0 +1,85 @@
+#pragma once
+
+#include <scorum/chain/database/database.hpp>
+#include <scorum/chain/operation_notification.hpp>
+
+#include <fc/variant_object.hpp>
+
+#include <boost/signals2/connection.hpp>
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace performance_common {
+
+/**
+ * @brief Collects block apply costs from the database signals
+ *
+ * A block is measured from pre_applied_block to applied_block, an operation from pre_apply_operation to
+ * post_apply_operation. Operations applied outside of blocks (pending transactions) are not counted, virtual
+ * operations are counted on their own and inside the operations that caused them.
+ */
+class block_apply_stats
+{
+public:
+    struct operation_cost
+    {
+        uint64_t count = 0;
+        uint64_t total_us = 0;
+    };
+
+    explicit block_apply_stats(scorum::chain::database& db);
+
+    size_t blocks_count() const
+    {
+        return _blocks_us.size();
+    }
+
+    /// by the time spent in the block apply only
+    double blocks_per_sec() const;
+
+    uint64_t block_percentile_us(double percentile) const;
+
+    /// bytes allocated in shared memory since the first measured block
+    int64_t shared_memory_growth() const;
+
+    const std::map<std::string, operation_cost>& operations() const
+    {
+        return _operations;
+    }
+
+    void print(std::ostream& out) const;
+
+    fc::variant_object to_variant() const;
+
+    /// prints relative differences with 'baseline' made by 'to_variant' of another build
+    void print_comparison(const fc::variant_object& baseline, std::ostream& out) const;
+
+private:
+    void on_pre_applied_block();
+    void on_applied_block();
+    void on_pre_apply_operation(const scorum::chain::operation_notification& note);
+    void on_post_apply_operation(const scorum::chain::operation_notification& note);
+
+    size_t used_memory() const;
+
+    scorum::chain::database& _db;
+
+    boost::signals2::scoped_connection _pre_applied_block_conn;
+    boost::signals2::scoped_connection _applied_block_conn;
+    boost::signals2::scoped_connection _pre_apply_operation_conn;
+    boost::signals2::scoped_connection _post_apply_operation_conn;
+
+    bool _in_block = false;
+    fc::time_point _block_start;
+    std::vector<fc::time_point> _operations_start;
+
+    std::vector<uint64_t> _blocks_us;
+    std::map<std::string, operation_cost> _operations;
+
+    size_t _used_memory_at_start = 0;
+    size_t _used_memory = 0;
+};
+}
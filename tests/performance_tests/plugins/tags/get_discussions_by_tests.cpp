@@ -70,6 +70,7 @@ struct tag_perf_fixture : public database_fixture::database_trx_integration_fixt
                 c.author = acc_name;
                 fc::from_string(c.permlink, boost::lexical_cast<std::string>(i));
             });
+            db.create<comment_content_object>([&](comment_content_object& o) { o.comment = comment.id; });
             db.create<comment_statistic_scr_object>([&](comment_statistic_scr_object& o) { o.comment = comment.id; });
             db.create<comment_statistic_sp_object>([&](comment_statistic_sp_object& o) { o.comment = comment.id; });
 
@@ -0,0 +1,125 @@
+#include <boost/test/unit_test.hpp>
+
+#include "defines.hpp"
+
+#include <scorum/rewards_math/batch.hpp>
+#include <scorum/rewards_math/curve.hpp>
+
+#include <boost/range/numeric.hpp>
+
+#include "performance_common.hpp"
+
+namespace rewards_math_batch_tests {
+
+using namespace scorum::rewards_math;
+using performance_common::cpu_profiler;
+
+struct rewards_math_batch_fixture
+{
+    rewards_math_batch_fixture()
+    {
+        for (size_t ci = 0; ci < comments_count; ++ci)
+        {
+            // wide rshares range to use all of the 64, 128 and 256 bits arithmetic
+            rshares.push_back(share_type(1000 + (ci * ci * 7919) % (int64_t(1) << 56)));
+            max_payouts.push_back(share_type(std::numeric_limits<int64_t>::max()));
+            weights.push_back(1000 + ci * 104729);
+        }
+
+        total_weight = boost::accumulate(weights, uint64_t(0));
+    }
+
+    const size_t cycles = 100;
+    const size_t comments_count = 1'000;
+
+    const curve_id curve = curve_id::quadratic;
+    const share_type reward_fund = 1000000000000;
+    const share_type curations_payout = 1000000000;
+
+    shares_vector_type rshares;
+    shares_vector_type max_payouts;
+    weights_vector_type weights;
+    uint64_t total_weight = 0;
+};
+
+BOOST_FIXTURE_TEST_SUITE(rewards_math_batch_tests, rewards_math_batch_fixture)
+
+SCORUM_TEST_CASE(comments_payout_scalar_vs_batch)
+{
+    shares_vector_type scalar_payouts;
+    size_t scalar_ms = 0u;
+    {
+        cpu_profiler prof;
+
+        for (size_t ci = 0; ci < cycles; ++ci)
+        {
+            scalar_payouts.clear();
+
+            const auto total_claims = calculate_total_claims(uint128_t(0), curve, rshares);
+            for (size_t i = 0; i < rshares.size(); ++i)
+                scalar_payouts.push_back(calculate_payout(rshares[i], total_claims, reward_fund, curve, max_payouts[i],
+                                                          SCORUM_MIN_COMMENT_PAYOUT_SHARE));
+        }
+
+        scalar_ms = prof.elapsed();
+        BOOST_TEST_MESSAGE("scalar comments payout use: " << scalar_ms << "ms");
+    }
+
+    shares_vector_type batch_payouts;
+    size_t batch_ms = 0u;
+    {
+        cpu_profiler prof;
+
+        for (size_t ci = 0; ci < cycles; ++ci)
+        {
+            const auto claims = evaluate_reward_curve(rshares, curve);
+            const auto total_claims = calculate_total_claims(uint128_t(0), claims);
+            batch_payouts = calculate_payouts(rshares, claims, total_claims, reward_fund, max_payouts,
+                                              SCORUM_MIN_COMMENT_PAYOUT_SHARE);
+        }
+
+        batch_ms = prof.elapsed();
+        BOOST_TEST_MESSAGE("batch comments payout use: " << batch_ms << "ms");
+    }
+
+    BOOST_REQUIRE(scalar_payouts == batch_payouts);
+    BOOST_CHECK_LE(batch_ms, scalar_ms);
+}
+
+SCORUM_TEST_CASE(curation_payouts_scalar_vs_batch)
+{
+    shares_vector_type scalar_payouts;
+    size_t scalar_ms = 0u;
+    {
+        cpu_profiler prof;
+
+        for (size_t ci = 0; ci < cycles; ++ci)
+        {
+            scalar_payouts.clear();
+
+            for (const uint64_t weight : weights)
+                scalar_payouts.push_back(calculate_curation_payout(curations_payout, total_weight, weight));
+        }
+
+        scalar_ms = prof.elapsed();
+        BOOST_TEST_MESSAGE("scalar curation payouts use: " << scalar_ms << "ms");
+    }
+
+    shares_vector_type batch_payouts;
+    size_t batch_ms = 0u;
+    {
+        cpu_profiler prof;
+
+        for (size_t ci = 0; ci < cycles; ++ci)
+            batch_payouts = calculate_curation_payouts(curations_payout, total_weight, weights);
+
+        batch_ms = prof.elapsed();
+        BOOST_TEST_MESSAGE("batch curation payouts use: " << batch_ms << "ms");
+    }
+
+    BOOST_REQUIRE(scalar_payouts == batch_payouts);
+    BOOST_CHECK_LE(batch_ms, scalar_ms);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}
@@ -0,0 +1,122 @@
+#include <boost/test/unit_test.hpp>
+
+#include <scorum/app/api_response_cache.hpp>
+
+#include <fc/variant_object.hpp>
+
+using namespace scorum::app;
+
+namespace {
+const std::string dgp_key
+    = api_response_cache::make_key("database_api", "get_dynamic_global_properties", fc::variants());
+
+std::string block_key(uint32_t block_num)
+{
+    return api_response_cache::make_key("blockchain_history_api", "get_block", fc::variants{ fc::variant(block_num) });
+}
+}
+
+BOOST_AUTO_TEST_SUITE(api_response_cache_tests)
+
+BOOST_AUTO_TEST_CASE(only_known_calls_are_cacheable)
+{
+    BOOST_CHECK(api_response_cache::is_cacheable("database_api", "get_dynamic_global_properties"));
+    BOOST_CHECK(api_response_cache::is_cacheable("blockchain_history_api", "get_transaction"));
+    BOOST_CHECK(!api_response_cache::is_cacheable("database_api", "get_accounts"));
+    BOOST_CHECK(!api_response_cache::is_cacheable("network_broadcast_api", "broadcast_transaction"));
+}
+
+BOOST_AUTO_TEST_CASE(per_block_results_are_dropped_on_applied_block)
+{
+    api_response_cache cache(1024);
+
+    cache.insert(dgp_key, "{}", api_result_lifetime::block, cache.generation());
+    BOOST_REQUIRE(cache.find(dgp_key).valid());
+    BOOST_CHECK_EQUAL(*cache.find(dgp_key), "{}");
+
+    cache.on_applied_block(0);
+
+    BOOST_CHECK(!cache.find(dgp_key).valid());
+    BOOST_CHECK_EQUAL(cache.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(irreversible_results_survive_applied_block)
+{
+    api_response_cache cache(1024);
+
+    cache.insert(block_key(1), "{}", api_result_lifetime::irreversible, cache.generation());
+    cache.on_applied_block(1);
+
+    BOOST_CHECK(cache.find(block_key(1)).valid());
+}
+
+BOOST_AUTO_TEST_CASE(only_per_block_results_are_dropped)
+{
+    api_response_cache cache(1024);
+
+    // the result of block 2 is per block, then it is irreversible and cached again
+    cache.insert(dgp_key, "{}", api_result_lifetime::block, cache.generation());
+    cache.insert(block_key(1), "{}", api_result_lifetime::irreversible, cache.generation());
+    cache.insert(block_key(2), "{}", api_result_lifetime::block, cache.generation());
+    cache.insert(block_key(2), "[]", api_result_lifetime::irreversible, cache.generation());
+
+    cache.on_applied_block(2);
+
+    BOOST_CHECK(!cache.find(dgp_key).valid());
+    BOOST_CHECK(cache.find(block_key(1)).valid());
+    BOOST_REQUIRE(cache.find(block_key(2)).valid());
+    BOOST_CHECK_EQUAL(*cache.find(block_key(2)), "[]");
+    BOOST_CHECK_EQUAL(cache.size(), 2 * (2 * block_key(1).size() + 2));
+}
+
+BOOST_AUTO_TEST_CASE(results_computed_before_applied_block_are_not_cached)
+{
+    api_response_cache cache(1024);
+
+    const auto generation = cache.generation();
+    cache.on_applied_block(0);
+    cache.insert(dgp_key, "{}", api_result_lifetime::block, generation);
+
+    BOOST_CHECK(!cache.find(dgp_key).valid());
+}
+
+BOOST_AUTO_TEST_CASE(lifetime_depends_on_irreversible_block)
+{
+    api_response_cache cache(1024);
+    cache.on_applied_block(10);
+
+    const fc::variants irreversible_block{ fc::variant(10u) };
+    const fc::variants reversible_block{ fc::variant(11u) };
+
+    BOOST_CHECK(cache.get_lifetime("blockchain_history_api", "get_block", irreversible_block, fc::variant())
+                == api_result_lifetime::irreversible);
+    BOOST_CHECK(cache.get_lifetime("blockchain_history_api", "get_block", reversible_block, fc::variant())
+                == api_result_lifetime::block);
+    BOOST_CHECK(cache.get_lifetime("blockchain_history_api", "get_transaction", fc::variants(),
+                                   fc::mutable_variant_object("block_num", 5))
+                == api_result_lifetime::irreversible);
+    BOOST_CHECK(cache.get_lifetime("database_api", "get_dynamic_global_properties", fc::variants(), fc::variant())
+                == api_result_lifetime::block);
+}
+
+BOOST_AUTO_TEST_CASE(least_recently_used_results_are_evicted)
+{
+    const std::string result(100, 'x');
+    const size_t entry_size = 2 * block_key(1).size() + result.size();
+
+    api_response_cache cache(entry_size * 2);
+
+    cache.insert(block_key(1), result, api_result_lifetime::irreversible, cache.generation());
+    cache.insert(block_key(2), result, api_result_lifetime::irreversible, cache.generation());
+
+    BOOST_REQUIRE(cache.find(block_key(1)).valid()); // 2 is the least recently used now
+
+    cache.insert(block_key(3), result, api_result_lifetime::irreversible, cache.generation());
+
+    BOOST_CHECK(cache.find(block_key(1)).valid());
+    BOOST_CHECK(!cache.find(block_key(2)).valid());
+    BOOST_CHECK(cache.find(block_key(3)).valid());
+    BOOST_CHECK_LE(cache.size(), entry_size * 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
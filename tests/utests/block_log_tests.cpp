@@ -0,0 +1,236 @@
+#include <boost/test/unit_test.hpp>
+
+#include <scorum/chain/block_log.hpp>
+
+#include <fc/filesystem.hpp>
+#include <fc/io/raw.hpp>
+
+#include "defines.hpp"
+
+using namespace scorum::chain;
+using namespace scorum::protocol;
+
+namespace {
+
+struct block_log_fixture
+{
+    block_log_fixture()
+    {
+        log.open(log_file);
+    }
+
+    /// appends 'count' blocks and returns their ids
+    std::vector<block_id_type> append_blocks(uint32_t count)
+    {
+        std::vector<block_id_type> ids;
+
+        block_id_type previous = log.head() ? log.head()->id() : block_id_type();
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            signed_block b;
+            b.previous = previous;
+            b.witness = "alice";
+            b.timestamp = fc::time_point_sec(SCORUM_BLOCK_INTERVAL * (block_header::num_from_id(previous) + 1));
+
+            previous = b.id();
+            log.append(b, previous);
+            ids.push_back(previous);
+        }
+
+        log.flush();
+        return ids;
+    }
+
+    fc::temp_directory temp_dir;
+    fc::path log_file = temp_dir.path() / "block_log";
+    block_log log;
+};
+}
+
+BOOST_FIXTURE_TEST_SUITE(block_log_tests, block_log_fixture)
+
+SCORUM_TEST_CASE(read_block_id_by_num_returns_appended_ids)
+{
+    auto ids = append_blocks(5);
+
+    for (uint32_t num = 1; num <= ids.size(); ++num)
+    {
+        auto id = log.read_block_id_by_num(num);
+
+        BOOST_REQUIRE(id.valid());
+        BOOST_CHECK(*id == ids[num - 1]);
+        BOOST_CHECK(*id == log.read_block_by_num(num)->id());
+    }
+}
+
+SCORUM_TEST_CASE(read_block_id_by_num_out_of_log_is_empty)
+{
+    BOOST_CHECK(!log.read_block_id_by_num(1).valid());
+
+    append_blocks(2);
+
+    BOOST_CHECK(!log.read_block_id_by_num(0).valid());
+    BOOST_CHECK(!log.read_block_id_by_num(3).valid());
+}
+
+SCORUM_TEST_CASE(ids_file_is_rebuilt_on_open)
+{
+    auto ids = append_blocks(4);
+    log.close();
+
+    fc::remove_all(block_log::block_log_ids_path(log_file));
+
+    log.open(log_file);
+
+    for (uint32_t num = 1; num <= ids.size(); ++num)
+    {
+        BOOST_CHECK(*log.read_block_id_by_num(num) == ids[num - 1]);
+    }
+
+    BOOST_CHECK_EQUAL(fc::file_size(block_log::block_log_ids_path(log_file)), sizeof(block_id_type) * ids.size());
+}
+
+SCORUM_TEST_CASE(append_after_rebuild_continues_ids)
+{
+    auto ids = append_blocks(3);
+    log.close();
+
+    fc::remove_all(block_log::block_log_ids_path(log_file));
+
+    log.open(log_file);
+
+    auto more_ids = append_blocks(2);
+    ids.insert(ids.end(), more_ids.begin(), more_ids.end());
+
+    for (uint32_t num = 1; num <= ids.size(); ++num)
+    {
+        BOOST_CHECK(*log.read_block_id_by_num(num) == ids[num - 1]);
+    }
+}
+
+SCORUM_TEST_CASE(read_packed_returns_stored_bytes)
+{
+    append_blocks(3);
+
+    for (uint32_t num = 1; num <= 3; ++num)
+    {
+        auto packed = log.read_packed(num);
+
+        BOOST_REQUIRE(packed.valid());
+        BOOST_CHECK(*packed == fc::raw::pack(*log.read_block_by_num(num)));
+    }
+
+    BOOST_CHECK(!log.read_packed(4).valid());
+}
+
+SCORUM_TEST_CASE(compressed_log_reads_blocks_of_chunks_and_tail)
+{
+    auto ids = append_blocks(5);
+
+    const auto compressed_file = temp_dir.path() / "compressed_block_log";
+    block_log::create_compressed(compressed_file, 2);
+
+    block_log compressed;
+    compressed.open(compressed_file);
+    BOOST_REQUIRE(compressed.is_compressed());
+
+    for (uint32_t num = 1; num <= ids.size(); ++num)
+        compressed.append(*log.read_block_by_num(num));
+    compressed.flush();
+
+    for (uint32_t num = 1; num <= ids.size(); ++num)
+    {
+        BOOST_CHECK(compressed.read_block_by_num(num)->id() == ids[num - 1]);
+        BOOST_CHECK(*compressed.read_packed(num) == *log.read_packed(num));
+        BOOST_CHECK_EQUAL(compressed.get_block_pos(num), log.get_block_pos(num));
+    }
+
+    BOOST_CHECK(compressed.read_head().id() == ids.back());
+}
+
+SCORUM_TEST_CASE(compressed_log_is_reopened_and_continued)
+{
+    auto ids = append_blocks(6);
+
+    const auto compressed_file = temp_dir.path() / "compressed_block_log";
+    block_log::create_compressed(compressed_file, 4);
+
+    {
+        block_log compressed;
+        compressed.open(compressed_file);
+        for (uint32_t num = 1; num <= 3; ++num)
+            compressed.append(*log.read_block_by_num(num));
+    }
+
+    fc::remove_all(block_log::block_log_index_path(compressed_file));
+
+    block_log compressed;
+    compressed.open(compressed_file);
+    BOOST_REQUIRE(compressed.is_compressed());
+    BOOST_REQUIRE_EQUAL(compressed.head()->block_num(), 3u);
+
+    for (uint32_t num = 4; num <= ids.size(); ++num)
+        compressed.append(*log.read_block_by_num(num));
+
+    uint64_t pos = 0;
+    for (uint32_t num = 1; num <= ids.size(); ++num)
+    {
+        auto block = compressed.read_block(pos);
+        BOOST_CHECK(block.first.id() == ids[num - 1]);
+        pos = block.second;
+    }
+}
+
+SCORUM_TEST_CASE(pruned_log_drops_old_blocks_and_ids)
+{
+    log.set_prune_blocks(3);
+
+    auto ids = append_blocks(7);
+    log.finish_pruning();
+
+    // the log is cut when it holds twice the kept blocks
+    BOOST_REQUIRE_EQUAL(log.first_block_num(), 4u);
+
+    for (uint32_t num = 1; num < log.first_block_num(); ++num)
+    {
+        BOOST_CHECK(!log.read_block_by_num(num).valid());
+        BOOST_CHECK(!log.read_packed(num).valid());
+        BOOST_CHECK(!log.read_block_id_by_num(num).valid());
+    }
+
+    for (uint32_t num = log.first_block_num(); num <= ids.size(); ++num)
+    {
+        BOOST_CHECK(log.read_block_by_num(num)->id() == ids[num - 1]);
+        BOOST_CHECK(*log.read_block_id_by_num(num) == ids[num - 1]);
+    }
+
+    BOOST_CHECK_EQUAL(fc::file_size(block_log::block_log_index_path(log_file)), 4 * sizeof(uint64_t));
+    BOOST_CHECK_EQUAL(fc::file_size(block_log::block_log_ids_path(log_file)), 4 * sizeof(block_id_type));
+}
+
+SCORUM_TEST_CASE(pruned_log_is_reopened_and_continued)
+{
+    log.set_prune_blocks(2);
+
+    auto ids = append_blocks(4);
+    log.finish_pruning();
+    BOOST_REQUIRE_EQUAL(log.first_block_num(), 3u);
+    log.close();
+
+    fc::remove_all(block_log::block_log_index_path(log_file));
+
+    log.open(log_file);
+    BOOST_REQUIRE_EQUAL(log.first_block_num(), 3u);
+    BOOST_REQUIRE_EQUAL(log.head()->block_num(), 4u);
+
+    auto more_ids = append_blocks(1);
+    ids.insert(ids.end(), more_ids.begin(), more_ids.end());
+
+    BOOST_CHECK(!log.read_block_by_num(2).valid());
+    for (uint32_t num = 3; num <= ids.size(); ++num)
+    {
+        BOOST_CHECK(log.read_block_by_num(num)->id() == ids[num - 1]);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
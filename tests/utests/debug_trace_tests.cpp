@@ -0,0 +1,85 @@
+#include <boost/test/unit_test.hpp>
+
+#include <scorum/chain/database/debug_log.hpp>
+
+#include <fc/filesystem.hpp>
+
+#include <sstream>
+
+#include "defines.hpp"
+
+using namespace scorum::chain;
+using scorum::protocol::block_id_type;
+
+namespace {
+
+struct debug_trace_fixture
+{
+    ~debug_trace_fixture()
+    {
+        debug_trace::close();
+    }
+
+    std::vector<std::string> dump()
+    {
+        std::stringstream out;
+        debug_trace::dump(trace_file, out);
+
+        std::vector<std::string> lines;
+        for (std::string line; std::getline(out, line);)
+            lines.push_back(line);
+        return lines;
+    }
+
+    fc::temp_directory temp_dir;
+    fc::path trace_file = temp_dir.path() / "debug_trace";
+};
+}
+
+BOOST_FIXTURE_TEST_SUITE(debug_trace_tests, debug_trace_fixture)
+
+SCORUM_TEST_CASE(disabled_trace_does_not_evaluate_arguments)
+{
+    BOOST_REQUIRE(!debug_trace::is_enabled());
+
+    int evaluated = 0;
+    debug_log((++evaluated, block_info()), "n=${n}", ("n", ++evaluated));
+
+    BOOST_CHECK_EQUAL(evaluated, 0);
+}
+
+SCORUM_TEST_CASE(ring_buffer_keeps_last_records)
+{
+    debug_trace::open(trace_file, 3);
+    BOOST_REQUIRE(debug_trace::is_enabled());
+
+    for (uint32_t i = 1; i <= 5; ++i)
+    {
+        debug_log(block_info(i, block_id_type(), fc::time_point_sec(), "alice"), "record=${i}", ("i", i));
+    }
+
+    auto lines = dump();
+
+    BOOST_REQUIRE_EQUAL(lines.size(), 3u);
+    BOOST_CHECK(lines[0].find("record=3") != std::string::npos);
+    BOOST_CHECK(lines[1].find("record=4") != std::string::npos);
+    BOOST_CHECK(lines[2].find("record=5") != std::string::npos);
+    BOOST_CHECK(lines[2].find(" 5 5:") != std::string::npos);
+
+    debug_trace::close();
+    BOOST_CHECK(!debug_trace::is_enabled());
+}
+
+SCORUM_TEST_CASE(trace_of_previous_run_is_kept)
+{
+    debug_trace::open(trace_file, 10);
+    debug_log(block_info(), "before_crash");
+    debug_trace::close();
+
+    debug_trace::open(trace_file, 10);
+
+    BOOST_CHECK(dump().empty());
+    BOOST_CHECK(fc::exists(trace_file.generic_string() + ".old"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
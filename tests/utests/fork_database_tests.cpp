@@ -0,0 +1,145 @@
+#include <boost/test/unit_test.hpp>
+
+#include <scorum/chain/database/fork_database.hpp>
+#include <scorum/chain/database_exceptions.hpp>
+
+#include "defines.hpp"
+
+using namespace scorum::chain;
+using namespace scorum::protocol;
+
+namespace {
+
+struct fork_database_fixture
+{
+    signed_block make_block(const block_id_type& previous, const std::string& witness = "alice")
+    {
+        signed_block b;
+        b.previous = previous;
+        b.witness = witness;
+        b.timestamp = fc::time_point_sec(SCORUM_BLOCK_INTERVAL * (block_header::num_from_id(previous) + 1));
+        return b;
+    }
+
+    /// pushes 'count' blocks on top of 'previous' and returns id of the last one
+    block_id_type push_blocks(const block_id_type& previous, uint32_t count, const std::string& witness = "alice")
+    {
+        block_id_type id = previous;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            auto b = make_block(id, witness);
+            id = b.id();
+            fork_db.push_block(b);
+        }
+        return id;
+    }
+
+    fork_database fork_db;
+};
+}
+
+BOOST_FIXTURE_TEST_SUITE(fork_database_tests, fork_database_fixture)
+
+SCORUM_TEST_CASE(push_linked_blocks_moves_head)
+{
+    auto head_id = push_blocks(block_id_type(), 5);
+
+    BOOST_REQUIRE(fork_db.head());
+    BOOST_CHECK_EQUAL(fork_db.head()->num, 5u);
+    BOOST_CHECK(fork_db.head()->id == head_id);
+    BOOST_CHECK(fork_db.is_known_block(head_id));
+    BOOST_CHECK(fork_db.fetch_block(head_id) == fork_db.head());
+}
+
+SCORUM_TEST_CASE(push_block_with_precomputed_id)
+{
+    auto common_id = push_blocks(block_id_type(), 2);
+    auto b = make_block(common_id);
+    const auto id = b.id();
+
+    auto head = fork_db.push_block(b, id);
+
+    BOOST_CHECK(head->id == id);
+    BOOST_CHECK_EQUAL(head->num, b.block_num());
+    BOOST_CHECK(fork_db.fetch_block(id) == head);
+}
+
+SCORUM_TEST_CASE(push_unlinkable_block_throws)
+{
+    push_blocks(block_id_type(), 2);
+
+    // the parent of this block was never pushed
+    auto orphan = make_block(make_block(block_id_type(), "bob").id(), "bob");
+
+    BOOST_CHECK_THROW(fork_db.push_block(orphan), unlinkable_block_exception);
+    BOOST_CHECK(!fork_db.is_known_block(orphan.id()));
+}
+
+SCORUM_TEST_CASE(fetch_block_by_number_returns_all_forks)
+{
+    auto common_id = push_blocks(block_id_type(), 2);
+    push_blocks(common_id, 2, "alice");
+    push_blocks(common_id, 2, "bob");
+
+    BOOST_CHECK_EQUAL(fork_db.fetch_block_by_number(2).size(), 1u);
+    BOOST_CHECK_EQUAL(fork_db.fetch_block_by_number(3).size(), 2u);
+    BOOST_CHECK_EQUAL(fork_db.fetch_block_by_number(4).size(), 2u);
+    BOOST_CHECK(fork_db.fetch_block_by_number(5).empty());
+}
+
+SCORUM_TEST_CASE(fetch_branch_from_ends_with_common_ancestor)
+{
+    auto common_id = push_blocks(block_id_type(), 2);
+    auto alice_id = push_blocks(common_id, 3, "alice");
+    auto bob_id = push_blocks(common_id, 1, "bob");
+
+    auto branches = fork_db.fetch_branch_from(alice_id, bob_id);
+
+    BOOST_REQUIRE_EQUAL(branches.first.size(), 3u);
+    BOOST_REQUIRE_EQUAL(branches.second.size(), 1u);
+    BOOST_CHECK(branches.first.front()->id == alice_id);
+    BOOST_CHECK(branches.second.front()->id == bob_id);
+    BOOST_CHECK(branches.first.back()->previous_id() == common_id);
+    BOOST_CHECK(branches.second.back()->previous_id() == common_id);
+}
+
+SCORUM_TEST_CASE(set_max_size_removes_old_blocks)
+{
+    auto head_id = push_blocks(block_id_type(), 10);
+
+    fork_db.set_max_size(3);
+
+    BOOST_CHECK(fork_db.fetch_block_by_number(6).empty());
+    BOOST_CHECK_EQUAL(fork_db.fetch_block_by_number(7).size(), 1u);
+    BOOST_CHECK_EQUAL(fork_db.fetch_block_by_number(10).size(), 1u);
+    BOOST_CHECK(fork_db.is_known_block(head_id));
+}
+
+SCORUM_TEST_CASE(removed_block_is_unknown)
+{
+    auto head_id = push_blocks(block_id_type(), 3);
+
+    fork_db.remove(head_id);
+
+    BOOST_CHECK(!fork_db.is_known_block(head_id));
+    BOOST_CHECK(!fork_db.fetch_block(head_id));
+}
+
+SCORUM_TEST_CASE(validation_values_are_computed_once)
+{
+    auto b = make_block(block_id_type());
+    const auto key = fc::ecc::private_key::regenerate(fc::sha256::hash(std::string("alice")));
+    b.sign(key);
+
+    auto item = fork_db.push_block(b);
+
+    const auto& signee = item->validation.signee(item->data);
+    const auto& merkle_root = item->validation.merkle_root(item->data);
+    BOOST_CHECK(signee == key.get_public_key());
+    BOOST_CHECK(merkle_root == b.calculate_merkle_root());
+
+    BOOST_CHECK_EQUAL(&item->validation.signee(item->data), &signee);
+    BOOST_CHECK_EQUAL(&item->validation.merkle_root(item->data), &merkle_root);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,167 @@
+#include <boost/test/unit_test.hpp>
+
+#include <graphene/net/peer_database.hpp>
+
+#include <fc/filesystem.hpp>
+#include <fc/io/json.hpp>
+
+#include "defines.hpp"
+
+using namespace graphene::net;
+
+namespace {
+
+struct peer_database_fixture
+{
+    peer_database_fixture()
+        : file(dir.path() / "peers.dat")
+    {
+    }
+
+    fc::ip::endpoint make_endpoint(uint16_t port)
+    {
+        return fc::ip::endpoint(fc::ip::address("127.0.0.1"), port);
+    }
+
+    potential_peer_record make_record(uint16_t port,
+                                      uint32_t last_seen,
+                                      potential_peer_last_connection_disposition disposition
+                                      = never_attempted_to_connect)
+    {
+        return potential_peer_record(make_endpoint(port), fc::time_point_sec(last_seen), disposition);
+    }
+
+    std::vector<uint16_t> candidate_ports(const peer_database& db, size_t max_count, uint32_t now)
+    {
+        std::vector<uint16_t> result;
+        for (const auto& record : db.get_connection_candidates(max_count, fc::time_point_sec(now), 10,
+                                                               [](const fc::ip::endpoint&) { return false; }))
+            result.push_back(record.endpoint.port());
+        return result;
+    }
+
+    fc::temp_directory dir;
+    fc::path file;
+};
+}
+
+BOOST_FIXTURE_TEST_SUITE(peer_database_tests, peer_database_fixture)
+
+SCORUM_TEST_CASE(updates_are_persisted_before_close)
+{
+    peer_database db;
+    db.open(file);
+
+    db.update_entry(make_record(1, 100));
+    db.update_entry(make_record(2, 200));
+    db.update_entry(make_record(1, 300, last_connection_succeeded));
+    db.erase(make_endpoint(2));
+
+    peer_database copy;
+    copy.open(file);
+
+    BOOST_REQUIRE_EQUAL(copy.size(), 1u);
+    auto record = copy.lookup_entry_for_endpoint(make_endpoint(1));
+    BOOST_REQUIRE(record.valid());
+    BOOST_CHECK(record->last_seen_time == fc::time_point_sec(300));
+    BOOST_CHECK(record->last_connection_disposition == last_connection_succeeded);
+    BOOST_CHECK(!copy.lookup_entry_for_endpoint(make_endpoint(2)).valid());
+}
+
+SCORUM_TEST_CASE(reopened_after_close)
+{
+    {
+        peer_database db;
+        db.open(file);
+        for (uint16_t port = 1; port <= 10; ++port)
+            db.update_entry(make_record(port, port));
+        db.close();
+    }
+
+    peer_database db;
+    db.open(file);
+
+    BOOST_REQUIRE_EQUAL(db.size(), 10u);
+
+    uint32_t last_seen = 0;
+    for (auto itr = db.begin(); itr != db.end(); ++itr)
+    {
+        BOOST_CHECK_LT(last_seen, itr->last_seen_time.sec_since_epoch());
+        last_seen = itr->last_seen_time.sec_since_epoch();
+    }
+}
+
+SCORUM_TEST_CASE(broken_last_record_is_dropped)
+{
+    {
+        peer_database db;
+        db.open(file);
+        db.update_entry(make_record(1, 100));
+        db.update_entry(make_record(2, 200));
+    }
+
+    fc::resize_file(file, fc::file_size(file) - 1);
+
+    peer_database db;
+    db.open(file);
+
+    BOOST_CHECK_EQUAL(db.size(), 1u);
+    BOOST_CHECK(db.lookup_entry_for_endpoint(make_endpoint(1)).valid());
+}
+
+SCORUM_TEST_CASE(json_database_is_converted)
+{
+    std::vector<potential_peer_record> records = { make_record(1, 100), make_record(2, 200) };
+    fc::json::save_to_file(records, file);
+
+    {
+        peer_database db;
+        db.open(file);
+        BOOST_CHECK_EQUAL(db.size(), 2u);
+    }
+
+    peer_database db;
+    db.open(file);
+    BOOST_CHECK_EQUAL(db.size(), 2u);
+}
+
+SCORUM_TEST_CASE(candidates_are_prioritized)
+{
+    peer_database db;
+
+    db.update_entry(make_record(1, 100, never_attempted_to_connect));
+    db.update_entry(make_record(2, 200, never_attempted_to_connect));
+    db.update_entry(make_record(3, 100, last_connection_succeeded));
+
+    auto failed = make_record(4, 300, last_connection_failed);
+    failed.number_of_failed_connection_attempts = 1;
+    db.update_entry(failed);
+
+    auto rejected = make_record(5, 300, last_connection_rejected);
+    db.update_entry(rejected);
+
+    // failed peers wait for (failures + 1) * timeout since the last attempt
+    BOOST_CHECK((candidate_ports(db, 10, 15) == std::vector<uint16_t>{ 3, 2, 1, 5 }));
+    BOOST_CHECK((candidate_ports(db, 10, 25) == std::vector<uint16_t>{ 3, 2, 1, 5, 4 }));
+
+    BOOST_CHECK((candidate_ports(db, 2, 25) == std::vector<uint16_t>{ 3, 2 }));
+}
+
+SCORUM_TEST_CASE(skipped_candidates_are_not_counted)
+{
+    peer_database db;
+
+    db.update_entry(make_record(1, 100));
+    db.update_entry(make_record(2, 200));
+    db.update_entry(make_record(3, 300));
+
+    const auto skip_endpoint = make_endpoint(3);
+    auto candidates = db.get_connection_candidates(
+        2, fc::time_point_sec(0), 10, [&](const fc::ip::endpoint& endpoint) { return endpoint == skip_endpoint; });
+
+    BOOST_REQUIRE_EQUAL(candidates.size(), 2u);
+    BOOST_CHECK_EQUAL(candidates[0].endpoint.port(), 2u);
+    BOOST_CHECK_EQUAL(candidates[1].endpoint.port(), 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,188 @@
+#include <boost/test/unit_test.hpp>
+
+#include <scorum/chain/database/pending_transactions_pool.hpp>
+#include <scorum/chain/database_exceptions.hpp>
+
+#include <fc/io/raw.hpp>
+
+#include "defines.hpp"
+
+using namespace scorum::chain;
+using namespace scorum::protocol;
+
+namespace {
+
+struct pending_transactions_pool_fixture
+{
+    /// transactions differ by expiration, so each one has its own id
+    signed_transaction make_trx(uint32_t expiration)
+    {
+        signed_transaction trx;
+        trx.set_expiration(fc::time_point_sec(expiration));
+        return trx;
+    }
+
+    std::vector<transaction_id_type> ids() const
+    {
+        std::vector<transaction_id_type> result;
+        for (auto it = pool.begin(); it != pool.end(); ++it)
+            result.push_back(it->id);
+        return result;
+    }
+
+    pending_transactions_pool pool;
+};
+}
+
+BOOST_FIXTURE_TEST_SUITE(pending_transactions_pool_tests, pending_transactions_pool_fixture)
+
+SCORUM_TEST_CASE(applied_transactions_go_before_unapplied)
+{
+    auto t1 = make_trx(10);
+    auto t2 = make_trx(20);
+    auto t3 = make_trx(30);
+
+    pool.push_unapplied(t1);
+    pool.push_applied(t2);
+    pool.push_unapplied(t3);
+
+    BOOST_REQUIRE_EQUAL(pool.size(), 3u);
+    BOOST_CHECK_EQUAL(pool.applied_count(), 1u);
+
+    std::vector<transaction_id_type> expected = { t2.id(), t1.id(), t3.id() };
+    BOOST_CHECK(ids() == expected);
+
+    BOOST_REQUIRE(pool.first_unapplied() != pool.end());
+    BOOST_CHECK(pool.first_unapplied()->id == t1.id());
+    BOOST_CHECK(!pool.first_unapplied()->applied);
+}
+
+SCORUM_TEST_CASE(set_applied_moves_first_unapplied)
+{
+    auto t1 = make_trx(10);
+    auto t2 = make_trx(20);
+
+    pool.push_unapplied(t1);
+    pool.push_unapplied(t2);
+
+    pool.set_applied(pool.first_unapplied());
+    BOOST_CHECK(pool.first_unapplied()->id == t2.id());
+
+    SCORUM_REQUIRE_THROW(pool.set_applied(pool.begin()), fc::exception);
+
+    pool.set_applied(pool.first_unapplied());
+    BOOST_CHECK(pool.first_unapplied() == pool.end());
+    BOOST_CHECK_EQUAL(pool.applied_count(), 2u);
+}
+
+SCORUM_TEST_CASE(duplicates_are_not_added)
+{
+    auto t1 = make_trx(10);
+
+    pool.push_applied(t1);
+    pool.push_unapplied(t1);
+
+    BOOST_CHECK_EQUAL(pool.size(), 1u);
+    BOOST_CHECK(pool.contains(t1.id()));
+
+    SCORUM_REQUIRE_THROW(pool.push_applied(t1), fc::exception);
+    BOOST_CHECK_EQUAL(pool.applied_count(), 1u);
+}
+
+SCORUM_TEST_CASE(remove_expired_keeps_order)
+{
+    auto t1 = make_trx(30);
+    auto t2 = make_trx(10);
+    auto t3 = make_trx(20);
+    auto t4 = make_trx(40);
+
+    pool.push_applied(t1);
+    pool.push_applied(t2);
+    pool.push_unapplied(t3);
+    pool.push_unapplied(t4);
+
+    BOOST_CHECK_EQUAL(pool.remove_expired(fc::time_point_sec(20)), 2u);
+
+    std::vector<transaction_id_type> expected = { t1.id(), t4.id() };
+    BOOST_CHECK(ids() == expected);
+
+    BOOST_CHECK_EQUAL(pool.applied_count(), 1u);
+    BOOST_CHECK(pool.first_unapplied()->id == t4.id());
+    BOOST_CHECK(!pool.contains(t2.id()));
+    BOOST_CHECK(!pool.contains(t3.id()));
+}
+
+SCORUM_TEST_CASE(remove_by_id_keeps_order)
+{
+    auto t1 = make_trx(10);
+    auto t2 = make_trx(20);
+    auto t3 = make_trx(30);
+
+    pool.push_applied(t1);
+    pool.push_unapplied(t2);
+    pool.push_unapplied(t3);
+
+    BOOST_CHECK(pool.remove(t2.id()));
+    BOOST_CHECK(!pool.remove(t2.id()));
+
+    std::vector<transaction_id_type> expected = { t1.id(), t3.id() };
+    BOOST_CHECK(ids() == expected);
+
+    BOOST_CHECK_EQUAL(pool.applied_count(), 1u);
+    BOOST_CHECK(pool.first_unapplied()->id == t3.id());
+}
+
+SCORUM_TEST_CASE(reset_applied_makes_all_unapplied)
+{
+    auto t1 = make_trx(10);
+    auto t2 = make_trx(20);
+
+    pool.push_applied(t1);
+    pool.push_applied(t2);
+
+    pool.reset_applied();
+
+    BOOST_CHECK_EQUAL(pool.applied_count(), 0u);
+    BOOST_CHECK(pool.first_unapplied() == pool.begin());
+    BOOST_CHECK(pool.first_unapplied()->id == t1.id());
+}
+
+SCORUM_TEST_CASE(packed_size_is_accounted)
+{
+    auto t1 = make_trx(10);
+    auto t2 = make_trx(20);
+
+    const uint64_t size = fc::raw::pack_size(t1);
+
+    pool.push_applied(t1);
+    pool.push_unapplied(t2);
+    BOOST_CHECK_EQUAL(pool.packed_size(), size * 2);
+
+    pool.remove(pool.begin());
+    BOOST_CHECK_EQUAL(pool.packed_size(), size);
+    BOOST_CHECK_EQUAL(pool.applied_count(), 0u);
+
+    pool.clear();
+    BOOST_CHECK_EQUAL(pool.packed_size(), 0u);
+    BOOST_CHECK(pool.first_unapplied() == pool.end());
+}
+
+SCORUM_TEST_CASE(limits_reject_new_transactions)
+{
+    auto t1 = make_trx(10);
+    auto t2 = make_trx(20);
+
+    pool.set_limits(1, 0);
+    BOOST_CHECK_NO_THROW(pool.check_limits(t1));
+
+    pool.push_applied(t1);
+    SCORUM_REQUIRE_THROW(pool.check_limits(t2), pending_transactions_overflow_exception);
+
+    pool.set_limits(0, fc::raw::pack_size(t1) * 2 - 1);
+    SCORUM_REQUIRE_THROW(pool.check_limits(t2), pending_transactions_overflow_exception);
+
+    pool.set_limits(0, 0);
+    BOOST_CHECK_NO_THROW(pool.check_limits(t2));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -63,6 +63,8 @@ struct pay_for_comments_fixture : public shared_memory_fixture
         mocks.OnCall(services, data_service_factory_i::comment_vote_service).ReturnByRef(*comment_vote_service);
         mocks.OnCall(services, data_service_factory_i::hardfork_property_service).ReturnByRef(*hardfork_service);
         mocks.OnCall(virt_op_emitter, database_virtual_operations_emmiter_i::push_virtual_operation);
+        mocks.OnCall(virt_op_emitter, database_virtual_operations_emmiter_i::is_virtual_operation_observed)
+            .Return(true);
 
         block_info empty_info;
         ctx = std::make_shared<block_task_context>(*services, *virt_op_emitter, 1u, empty_info);
@@ -83,6 +85,7 @@ struct pay_for_comments_fixture : public shared_memory_fixture
             c.parent_author = SCORUM_ROOT_POST_PARENT_ACCOUNT;
             c.parent_permlink = "category";
             c.id = 0;
+            c.parent_id = 0;
             c.depth = 0;
             c.allow_curation_rewards = true;
             c.total_vote_weight = 0;
@@ -94,6 +97,7 @@ struct pay_for_comments_fixture : public shared_memory_fixture
             c.parent_author = "alice";
             c.parent_permlink = "p";
             c.id = 1;
+            c.parent_id = 0;
             c.depth = 1;
             c.allow_curation_rewards = true;
             c.total_vote_weight = 0;
@@ -105,6 +109,7 @@ struct pay_for_comments_fixture : public shared_memory_fixture
             c.parent_author = "bob";
             c.parent_permlink = "c1";
             c.id = 2;
+            c.parent_id = 1;
             c.depth = 2;
             c.allow_curation_rewards = true;
             c.total_vote_weight = 0;
@@ -116,6 +121,7 @@ struct pay_for_comments_fixture : public shared_memory_fixture
             c.parent_author = "alice";
             c.parent_permlink = "c2";
             c.id = 3;
+            c.parent_id = 2;
             c.depth = 3;
             c.allow_curation_rewards = true;
             c.total_vote_weight = 0;
@@ -146,13 +152,12 @@ struct pay_for_comments_fixture : public shared_memory_fixture
                       const std::vector<asset>& rewards)
     {
         using get_ptr = const account_object& (account_service_i::*)(const account_id_type&)const;
-        using get_acc_ptr
-            = const comment_object& (comment_service_i::*)(const account_name_type&, const std::string&)const;
+        using get_by_id_ptr = const comment_object& (comment_service_i::*)(const comment_id_type&)const;
         using inc_acc_balance_ptr = void (account_service_i::*)(const account_object&, const asset&);
 
         mock_do_nothing();
         // 'comments' already contains all required posts/comments so we don't care which comment we should return here
-        mocks.OnCallOverload(comment_service, (get_acc_ptr)&comment_service_i::get).ReturnByRef(comment_refs[0].get());
+        mocks.OnCallOverload(comment_service, (get_by_id_ptr)&comment_service_i::get).ReturnByRef(comment_refs[0].get());
         mocks.OnCall(comment_service, comment_service_i::set_rewarded_flag);
         mocks.OnCall(acc_service, account_service_i::get_account).With("alice").ReturnByRef(alice_acc);
         mocks.OnCall(acc_service, account_service_i::get_account).With("bob").ReturnByRef(bob_acc);
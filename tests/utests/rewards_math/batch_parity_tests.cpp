@@ -0,0 +1,173 @@
+#include <boost/test/unit_test.hpp>
+
+#include "defines.hpp"
+
+#include <scorum/protocol/asset.hpp>
+#include <scorum/rewards_math/batch.hpp>
+#include <scorum/rewards_math/curve.hpp>
+#include <scorum/utils/fraction.hpp>
+
+#include <boost/range/numeric.hpp>
+
+#include <random>
+
+using namespace scorum::rewards_math;
+using namespace scorum::protocol;
+
+using scorum::protocol::curve_id;
+using fc::uint128_t;
+
+namespace database_fixture {
+struct rewards_math_batch_parity_fixture
+{
+    std::mt19937_64 rand{ 20181019 };
+
+    const std::vector<curve_id> curves
+        = { curve_id::quadratic, curve_id::linear, curve_id::square_root, curve_id::power1dot5 };
+
+    // the greatest rshares whose claims sum doesn't overflow 128 bits
+    int64_t max_rshares(curve_id curve) const
+    {
+        switch (curve)
+        {
+        case curve_id::quadratic:
+            return int64_t(1) << 58;
+        case curve_id::power1dot5:
+            return int64_t(1) << 40;
+        default:
+            return std::numeric_limits<int64_t>::max() / 1024;
+        }
+    }
+
+    /// small, medium and big rshares, so every arithmetic path of the batch is used
+    shares_vector_type generate_rshares(curve_id curve, size_t count)
+    {
+        shares_vector_type result;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const int64_t limit = i % 3 == 0 ? 1000 : i % 3 == 1 ? 1000000000 : max_rshares(curve);
+            result.push_back(std::uniform_int_distribution<int64_t>(1, limit)(rand));
+        }
+        return result;
+    }
+
+    shares_vector_type generate_max_payouts(size_t count)
+    {
+        shares_vector_type result;
+        for (size_t i = 0; i < count; ++i)
+            result.push_back(i % 4 ? std::numeric_limits<int64_t>::max()
+                                   : std::uniform_int_distribution<int64_t>(0, 1000000)(rand));
+        return result;
+    }
+};
+}
+
+using namespace database_fixture;
+
+BOOST_FIXTURE_TEST_SUITE(rewards_math_batch_parity_tests, rewards_math_batch_parity_fixture)
+
+SCORUM_TEST_CASE(claims_are_equal_to_scalar_curve)
+{
+    for (const auto curve : curves)
+    {
+        const auto rshares = generate_rshares(curve, 300);
+        const auto claims = evaluate_reward_curve(rshares, curve);
+
+        BOOST_REQUIRE_EQUAL(claims.size(), rshares.size());
+        for (size_t i = 0; i < rshares.size(); ++i)
+            BOOST_REQUIRE(claims[i] == evaluate_reward_curve(rshares[i].value, curve));
+
+        const uint128_t recent_claims = std::uniform_int_distribution<uint64_t>()(rand);
+
+        BOOST_REQUIRE(calculate_total_claims(recent_claims, claims)
+                      == calculate_total_claims(recent_claims, curve, rshares));
+    }
+}
+
+SCORUM_TEST_CASE(payouts_are_equal_to_scalar_payout)
+{
+    const std::vector<share_type> funds = { 0, SCORUM_MIN_COMMENT_PAYOUT_SHARE, 1000000000, 1000000000000000000 };
+
+    for (const auto curve : curves)
+    {
+        const auto rshares = generate_rshares(curve, 300);
+        const auto max_payouts = generate_max_payouts(rshares.size());
+
+        const auto claims = evaluate_reward_curve(rshares, curve);
+        const auto total_claims = calculate_total_claims(uint128_t(0), claims);
+
+        for (const auto& fund : funds)
+        {
+            const auto payouts = calculate_payouts(rshares, claims, total_claims, fund, max_payouts,
+                                                   SCORUM_MIN_COMMENT_PAYOUT_SHARE);
+
+            BOOST_REQUIRE_EQUAL(payouts.size(), rshares.size());
+            for (size_t i = 0; i < rshares.size(); ++i)
+            {
+                BOOST_REQUIRE_EQUAL(payouts[i], calculate_payout(rshares[i], total_claims, fund, curve, max_payouts[i],
+                                                                 SCORUM_MIN_COMMENT_PAYOUT_SHARE));
+            }
+        }
+    }
+}
+
+SCORUM_TEST_CASE(curation_payouts_are_equal_to_scalar_payout)
+{
+    const std::vector<share_type> curations_payouts = { 0, 1, 1000000000, std::numeric_limits<int64_t>::max() };
+
+    weights_vector_type weights;
+    for (size_t i = 0; i < 300; ++i)
+        weights.push_back(std::uniform_int_distribution<uint64_t>(0, i % 2 ? 1000000 : (uint64_t(1) << 55))(rand));
+
+    const uint64_t total_weight = boost::accumulate(weights, uint64_t(0));
+
+    for (const auto& curations_payout : curations_payouts)
+    {
+        const auto payouts = calculate_curation_payouts(curations_payout, total_weight, weights);
+
+        BOOST_REQUIRE_EQUAL(payouts.size(), weights.size());
+        for (size_t i = 0; i < weights.size(); ++i)
+        {
+            BOOST_REQUIRE_EQUAL(payouts[i], calculate_curation_payout(curations_payout, total_weight, weights[i]));
+
+            const auto claim = asset(curations_payout, SCORUM_SYMBOL)
+                * scorum::utils::make_fraction(weights[i], total_weight);
+            BOOST_REQUIRE_EQUAL(payouts[i], claim.amount);
+        }
+    }
+}
+
+SCORUM_TEST_CASE(zero_claim_of_positive_rshares_is_paid_as_in_scalar)
+{
+    // the cube of 2^43 wraps to zero in 128 bits, so the claim is zero for positive rshares
+    const shares_vector_type rshares = { int64_t(1) << 43, 1000 };
+    const auto claims = evaluate_reward_curve(rshares, curve_id::power1dot5);
+    const auto total_claims = calculate_total_claims(uint128_t(0), claims);
+
+    const auto payouts = calculate_payouts(rshares, claims, total_claims, 1000, { 1000, 1000 }, 0);
+
+    for (size_t i = 0; i < rshares.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL(payouts[i],
+                          calculate_payout(rshares[i], total_claims, 1000, curve_id::power1dot5, 1000, 0));
+    }
+}
+
+SCORUM_TEST_CASE(invalid_params_are_rejected_as_in_scalar)
+{
+    const shares_vector_type rshares = { 100, 0 };
+    const auto claims = evaluate_reward_curve(rshares, curve_id::linear);
+
+    SCORUM_REQUIRE_THROW(calculate_payout(rshares[1], uint128_t(100), 1000, curve_id::linear, 1000, 0), fc::exception);
+    SCORUM_REQUIRE_THROW(calculate_payouts(rshares, claims, uint128_t(100), 1000, { 1000, 1000 }, 0), fc::exception);
+
+    SCORUM_REQUIRE_THROW(calculate_payouts({ rshares[0] }, { claims[0] }, uint128_t(0), 1000, { 1000 }, 0),
+                         fc::exception);
+    SCORUM_REQUIRE_THROW(calculate_payouts({ rshares[0] }, { claims[0] }, uint128_t(100), 1000, {}, 0), fc::exception);
+    SCORUM_REQUIRE_THROW(calculate_payouts(rshares, { claims[0] }, uint128_t(100), 1000, { 1000, 1000 }, 0),
+                         fc::exception);
+
+    SCORUM_REQUIRE_THROW(calculate_curation_payouts(1000, 0, { 1 }), fc::exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,55 @@
+#include <boost/test/unit_test.hpp>
+
+#include <scorum/app/rpc_worker_pool.hpp>
+
+#include <atomic>
+#include <set>
+#include <thread>
+
+using namespace scorum::app;
+
+BOOST_AUTO_TEST_SUITE(rpc_worker_pool_tests)
+
+BOOST_AUTO_TEST_CASE(throw_if_no_threads)
+{
+    BOOST_REQUIRE_THROW(rpc_worker_pool(0), fc::assert_exception);
+}
+
+BOOST_AUTO_TEST_CASE(all_tasks_are_run)
+{
+    rpc_worker_pool pool(4);
+
+    std::atomic<int> counter{ 0 };
+
+    std::vector<fc::future<void>> tasks;
+    for (int i = 0; i < 100; ++i)
+        tasks.push_back(pool.async([&]() { ++counter; }));
+
+    for (auto& f : tasks)
+        f.wait();
+
+    BOOST_CHECK_EQUAL(counter.load(), 100);
+}
+
+BOOST_AUTO_TEST_CASE(busy_worker_does_not_delay_others)
+{
+    rpc_worker_pool pool(2);
+
+    std::atomic<bool> released{ false };
+
+    auto busy = pool.async([&]() {
+        while (!released)
+            std::this_thread::yield();
+    });
+
+    std::set<std::thread::id> threads;
+    for (int i = 0; i < 10; ++i)
+        pool.async([&]() { threads.insert(std::this_thread::get_id()); }).wait();
+
+    released = true;
+    busy.wait();
+
+    BOOST_CHECK_EQUAL(threads.size(), 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,62 @@
+#include <boost/test/unit_test.hpp>
+#include <scorum/utils/bloom_filter.hpp>
+
+#include "defines.hpp"
+
+using namespace scorum;
+
+BOOST_AUTO_TEST_SUITE(bloom_filter_tests)
+
+BOOST_AUTO_TEST_CASE(empty_filter_contains_nothing)
+{
+    utils::bloom_filter filter(100);
+
+    for (uint64_t i = 0; i < 100; ++i)
+        BOOST_CHECK(!filter.may_contain(i));
+
+    BOOST_CHECK_EQUAL(filter.size(), 0u);
+    BOOST_CHECK_EQUAL(filter.capacity(), 100u);
+}
+
+BOOST_AUTO_TEST_CASE(inserted_items_are_always_found)
+{
+    utils::bloom_filter filter(1000);
+
+    for (uint64_t i = 0; i < 1000; ++i)
+        filter.insert(i);
+
+    for (uint64_t i = 0; i < 1000; ++i)
+        BOOST_CHECK(filter.may_contain(i));
+
+    BOOST_CHECK_EQUAL(filter.size(), 1000u);
+}
+
+BOOST_AUTO_TEST_CASE(false_positive_rate_is_low_within_capacity)
+{
+    utils::bloom_filter filter(1000);
+
+    for (uint64_t i = 0; i < 1000; ++i)
+        filter.insert(i);
+
+    size_t false_positives = 0;
+    for (uint64_t i = 1000; i < 11000; ++i)
+        false_positives += filter.may_contain(i) ? 1 : 0;
+
+    // ~1% is expected for 10 bits per item
+    BOOST_CHECK_LT(false_positives, 300u);
+}
+
+BOOST_AUTO_TEST_CASE(clear_removes_everything)
+{
+    utils::bloom_filter filter(10);
+
+    filter.insert(std::string("alice").data(), 5);
+    BOOST_CHECK(filter.may_contain(std::string("alice").data(), 5));
+
+    filter.clear();
+
+    BOOST_CHECK(!filter.may_contain(std::string("alice").data(), 5));
+    BOOST_CHECK_EQUAL(filter.size(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()